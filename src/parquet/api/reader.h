@@ -20,9 +20,12 @@
 
 // Column reader API
 #include "parquet/column/reader.h"
+#include "parquet/column/record-assembler.h"
 #include "parquet/column/scan-all.h"
 #include "parquet/exception.h"
+#include "parquet/file/filter.h"
 #include "parquet/file/reader.h"
+#include "parquet/file/selection-reader.h"
 
 // Metadata reader API
 #include "parquet/file/metadata.h"
@@ -133,6 +133,39 @@ BENCHMARK_TEMPLATE(BM_ReadInt64Column, Repetition::OPTIONAL)
 BENCHMARK_TEMPLATE(BM_ReadInt64Column, Repetition::REPEATED)
     ->RangePair(1024, 65536, 1, 1024);
 
+static void BM_ReadInt64ColumnSpaced(::benchmark::State& state) {
+  format::ColumnChunk thrift_metadata;
+  std::vector<int64_t> values(state.range_x(), 128);
+  std::vector<int16_t> definition_levels(state.range_x(), 1);
+  std::shared_ptr<ColumnDescriptor> schema = Int64Schema(Repetition::OPTIONAL);
+  std::shared_ptr<WriterProperties> properties = default_writer_properties();
+  auto metadata = ColumnChunkMetaDataBuilder::Make(
+      properties, schema.get(), reinterpret_cast<uint8_t*>(&thrift_metadata));
+
+  InMemoryOutputStream dst;
+  std::unique_ptr<Int64Writer> writer =
+      BuildWriter(state.range_x(), &dst, metadata.get(), schema.get(), properties.get());
+  writer->WriteBatch(values.size(), definition_levels.data(), nullptr, values.data());
+  writer->Close();
+
+  std::shared_ptr<Buffer> src = dst.GetBuffer();
+  std::vector<int64_t> values_out(state.range_y());
+  std::vector<uint8_t> valid_bits_out(state.range_y() / 8 + 1);
+  while (state.KeepRunning()) {
+    std::unique_ptr<Int64Reader> reader = BuildReader(src, schema.get());
+    int64_t levels_read = 0;
+    for (size_t i = 0; i < values.size(); i += levels_read) {
+      int64_t values_read = 0;
+      int64_t null_count = 0;
+      levels_read = reader->ReadBatchSpaced(values_out.size(), nullptr, nullptr,
+          values_out.data(), valid_bits_out.data(), 0, &values_read, &null_count);
+    }
+  }
+  SetBytesProcessed(state, Repetition::OPTIONAL);
+}
+
+BENCHMARK(BM_ReadInt64ColumnSpaced)->RangePair(1024, 65536, 1, 1024);
+
 }  // namespace benchmark
 
 }  // namespace parquet
@@ -28,9 +28,12 @@
 #include "parquet/types.h"
 #include "parquet/column/page.h"
 #include "parquet/column/reader.h"
+#include "parquet/column/test-specialization.h"
 #include "parquet/column/test-util.h"
+#include "parquet/encodings/delta-bit-pack-encoding.h"
 #include "parquet/schema/descriptor.h"
 #include "parquet/schema/types.h"
+#include "parquet/util/bit-util.h"
 #include "parquet/util/test-common.h"
 
 using std::string;
@@ -45,10 +48,10 @@ namespace test {
 
 class TestPrimitiveReader : public ::testing::Test {
  public:
-  void InitReader(const ColumnDescriptor* d) {
-    std::unique_ptr<PageReader> pager_;
-    pager_.reset(new test::MockPageReader(pages_));
-    reader_ = ColumnReader::Make(d, std::move(pager_));
+  void InitReader(const ColumnDescriptor* d, bool reuse_page_buffer = false) {
+    std::unique_ptr<test::MockPageReader> pager(new test::MockPageReader(pages_));
+    if (reuse_page_buffer) { pager->reuse_page_buffer(); }
+    reader_ = ColumnReader::Make(d, std::move(pager));
   }
 
   void CheckResults() {
@@ -62,17 +65,27 @@ class TestPrimitiveReader : public ::testing::Test {
     Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
     int32_t batch_size = 8;
     int batch = 0;
+    int64_t page_transitions = 0;
+    int64_t total_page_transitions = 0;
     // This will cover both the cases
     // 1) batch_size < page_size (multiple ReadBatch from a single page)
-    // 2) batch_size > page_size (BatchRead limits to a single page)
+    // 2) batch_size > page_size (ReadBatch fills the batch from several pages)
     do {
       batch = reader->ReadBatch(batch_size, &dresult[0] + batch_actual,
-          &rresult[0] + batch_actual, &vresult[0] + total_values_read, &values_read);
+          &rresult[0] + batch_actual, &vresult[0] + total_values_read, &values_read,
+          &page_transitions);
+      ASSERT_EQ(std::min(batch_size, num_levels_ - batch_actual), batch);
       total_values_read += values_read;
       batch_actual += batch;
+      total_page_transitions += page_transitions;
       batch_size = std::max(batch_size * 2, 4096);
     } while (batch > 0);
 
+    int64_t num_data_pages = 0;
+    for (const shared_ptr<Page>& page : pages_) {
+      if (page->type() == PageType::DATA_PAGE) { ++num_data_pages; }
+    }
+    ASSERT_EQ(num_data_pages, total_page_transitions);
     ASSERT_EQ(num_levels_, batch_actual);
     ASSERT_EQ(num_values_, total_values_read);
     ASSERT_TRUE(vector_equal(values_, vresult));
@@ -84,6 +97,111 @@ class TestPrimitiveReader : public ::testing::Test {
     ASSERT_EQ(0, values_read);
   }
 
+  // Reads the column with ReadBatchView, checking whether the values were served
+  // as views into the data pages
+  void CheckViewResults(bool expect_views) {
+    vector<int32_t> vresult;
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    std::shared_ptr<Buffer> values;
+    int64_t values_read = 0;
+    while ((values_read = reader->ReadBatchView(37, &values)) > 0) {
+      ASSERT_EQ(values_read * static_cast<int64_t>(sizeof(int32_t)), values->size());
+      ASSERT_EQ(expect_views, values->is_shared());
+      const int32_t* data = reinterpret_cast<const int32_t*>(values->data());
+      vresult.insert(vresult.end(), data, data + values_read);
+    }
+    ASSERT_EQ(0, values->size());
+    ASSERT_TRUE(vector_equal(values_, vresult));
+  }
+
+  // Reads the column with ReadBatchSpaced into a bitmap starting at an unaligned
+  // bit, with or without returning the definition levels
+  void CheckSpacedResults(const ColumnDescriptor* d, bool read_def_levels) {
+    InitReader(d);
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    const int bits_offset = 5;
+    vector<int32_t> vresult(num_levels_, -1);
+    vector<int16_t> dresult(num_levels_, -1);
+    vector<uint8_t> valid_bits((num_levels_ + bits_offset) / 8 + 1, 0xFF);
+    int64_t total_levels = 0;
+    int64_t total_values = 0;
+    int64_t total_nulls = 0;
+    int32_t batch_size = 7;
+    int64_t levels_read = 0;
+    do {
+      int64_t values_read = 0;
+      int64_t null_count = 0;
+      levels_read = reader->ReadBatchSpaced(batch_size,
+          read_def_levels ? &dresult[total_levels] : nullptr, nullptr,
+          &vresult[total_levels], valid_bits.data(), bits_offset + total_levels,
+          &values_read, &null_count);
+      ASSERT_EQ(std::min<int64_t>(batch_size, num_levels_ - total_levels), levels_read);
+      ASSERT_EQ(levels_read, values_read + null_count);
+      total_levels += levels_read;
+      total_values += values_read;
+      total_nulls += null_count;
+      batch_size = std::min(batch_size * 3, 1024);
+    } while (levels_read > 0);
+
+    ASSERT_EQ(num_levels_, total_levels);
+    ASSERT_EQ(num_values_, total_values);
+    ASSERT_EQ(num_levels_ - num_values_, total_nulls);
+    int value = 0;
+    for (int i = 0; i < num_levels_; ++i) {
+      bool defined = max_def_level_ == 0 || def_levels_[i] == max_def_level_;
+      ASSERT_EQ(defined, BitUtil::GetArrayBit(valid_bits.data(), bits_offset + i)) << i;
+      if (defined) { ASSERT_EQ(values_[value++], vresult[i]) << i; }
+      if (read_def_levels && max_def_level_ > 0) {
+        ASSERT_EQ(def_levels_[i], dresult[i]) << i;
+      }
+    }
+  }
+
+  // Alternates skipping and reading rows. Expects 10 pages of 100 levels
+  void CheckSkip(const ColumnDescriptor* d) {
+    MockPageReader* pager = new MockPageReader(pages_);
+    reader_ = ColumnReader::Make(d, std::unique_ptr<PageReader>(pager));
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+
+    // The index of the first value at or after each level
+    vector<int> value_offsets(num_levels_ + 1, 0);
+    for (int i = 0; i < num_levels_; ++i) {
+      bool defined = max_def_level_ == 0 || def_levels_[i] == max_def_level_;
+      value_offsets[i + 1] = value_offsets[i] + (defined ? 1 : 0);
+    }
+
+    // Skips within a page, across a whole page and into the following ones
+    const vector<std::pair<int, int>> steps = {
+        {10, 5}, {250, 20}, {0, 20}, {100, 1}};
+    vector<int32_t> vresult(20, -1);
+    vector<int16_t> dresult(20, -1);
+    int level = 0;
+    for (const auto& step : steps) {
+      ASSERT_EQ(step.first, reader->Skip(step.first));
+      level += step.first;
+
+      int64_t values_read = 0;
+      int64_t levels_read =
+          reader->ReadBatch(step.second, &dresult[0], nullptr, &vresult[0], &values_read);
+      ASSERT_EQ(step.second, levels_read);
+      ASSERT_EQ(value_offsets[level + step.second] - value_offsets[level], values_read);
+      for (int i = 0; i < values_read; ++i) {
+        ASSERT_EQ(values_[value_offsets[level] + i], vresult[i]) << level;
+      }
+      if (max_def_level_ > 0) {
+        for (int i = 0; i < levels_read; ++i) {
+          ASSERT_EQ(def_levels_[level + i], dresult[i]) << level;
+        }
+      }
+      level += step.second;
+    }
+    // Page 1 is inside the second skip; pages 5 to 9 are skipped at the end
+    ASSERT_EQ(num_levels_ - level, reader->Skip(num_levels_));
+    ASSERT_EQ(6, pager->pages_skipped());
+    ASSERT_EQ(0, reader->Skip(1));
+    ASSERT_FALSE(reader->HasNext());
+  }
+
   void ExecutePlain(int num_pages, int levels_per_page, const ColumnDescriptor* d) {
     num_values_ = MakePages<Int32Type>(d, num_pages, levels_per_page, def_levels_,
         rep_levels_, values_, data_buffer_, pages_, Encoding::PLAIN);
@@ -129,6 +247,533 @@ TEST_F(TestPrimitiveReader, TestInt32FlatRequired) {
   ExecuteDict(num_pages, levels_per_page, &descr);
 }
 
+TEST_F(TestPrimitiveReader, TestReadBatchView) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 0;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  // Pages owning their memory, as produced by decompression, are copied
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::PLAIN);
+  InitReader(&descr);
+  CheckViewResults(false);
+
+  // Pages sliced from a column chunk buffer are returned as views
+  vector<shared_ptr<Page>> owned_pages = pages_;
+  pages_.clear();
+  for (const shared_ptr<Page>& page : owned_pages) {
+    const DataPage* data_page = static_cast<const DataPage*>(page.get());
+    auto slice = std::make_shared<Buffer>(page->buffer(), 0, page->size());
+    pages_.push_back(std::make_shared<DataPage>(slice, data_page->num_values(),
+        data_page->encoding(), data_page->definition_level_encoding(),
+        data_page->repetition_level_encoding()));
+  }
+  InitReader(&descr);
+  CheckViewResults(true);
+  values_.clear();
+  pages_.clear();
+
+  // Dictionary-encoded pages are decoded into a new buffer
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::RLE_DICTIONARY);
+  InitReader(&descr);
+  CheckViewResults(false);
+  pages_.clear();
+
+  // Views are only supported for required, non-repeated columns
+  NodePtr optional = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor optional_descr(optional, 4, 0);
+  InitReader(&optional_descr);
+  std::shared_ptr<Buffer> values;
+  ASSERT_THROW(
+      static_cast<Int32Reader*>(reader_.get())->ReadBatchView(10, &values),
+      ParquetException);
+}
+
+TEST_F(TestPrimitiveReader, TestSkip) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  num_levels_ = num_pages * levels_per_page;
+  Encoding::type encodings[2] = {Encoding::PLAIN, Encoding::RLE_DICTIONARY};
+  for (int16_t max_def_level : {0, 4}) {
+    max_def_level_ = max_def_level;
+    max_rep_level_ = 0;
+    NodePtr type = schema::Int32(
+        "a", max_def_level_ == 0 ? Repetition::REQUIRED : Repetition::OPTIONAL);
+    const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+    for (Encoding::type encoding : encodings) {
+      num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page,
+          def_levels_, rep_levels_, values_, data_buffer_, pages_, encoding);
+      CheckSkip(&descr);
+      values_.clear();
+      def_levels_.clear();
+      rep_levels_.clear();
+      pages_.clear();
+    }
+  }
+
+  // Row boundaries of repeated columns are not tracked yet
+  NodePtr type = schema::Int32("c", Repetition::REPEATED);
+  const ColumnDescriptor descr(type, 4, 2);
+  InitReader(&descr);
+  ASSERT_THROW(static_cast<Int32Reader*>(reader_.get())->Skip(1), ParquetException);
+}
+
+TEST_F(TestPrimitiveReader, TestReadBatchSpaced) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  num_levels_ = num_pages * levels_per_page;
+  Encoding::type encodings[2] = {Encoding::PLAIN, Encoding::RLE_DICTIONARY};
+  for (int16_t max_def_level : {0, 1, 4}) {
+    max_def_level_ = max_def_level;
+    max_rep_level_ = 0;
+    NodePtr type = schema::Int32(
+        "a", max_def_level_ == 0 ? Repetition::REQUIRED : Repetition::OPTIONAL);
+    const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+    for (Encoding::type encoding : encodings) {
+      num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page,
+          def_levels_, rep_levels_, values_, data_buffer_, pages_, encoding);
+      CheckSpacedResults(&descr, true);
+      CheckSpacedResults(&descr, false);
+      values_.clear();
+      def_levels_.clear();
+      rep_levels_.clear();
+      pages_.clear();
+    }
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestReadBatchBinary) {
+  int levels_per_page = 100;
+  int num_pages = 5;
+  num_levels_ = levels_per_page * num_pages;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::ByteArray("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  // Dictionary encoded pages repeat the dictionary in order, so their values are
+  // copied in runs
+  for (Encoding::type encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    vector<ByteArray> values;
+    pages_.clear();
+    num_values_ = MakePages<ByteArrayType>(&descr, num_pages, levels_per_page,
+        def_levels_, rep_levels_, values, data_buffer_, pages_, encoding);
+    InitReader(&descr);
+    ByteArrayReader* reader = static_cast<ByteArrayReader*>(reader_.get());
+
+    OwnedMutableBuffer offsets;
+    OwnedMutableBuffer data;
+    vector<int16_t> def_levels(num_levels_);
+    int64_t levels_read = 0;
+    int64_t values_read = 0;
+    int64_t total_values = 0;
+    int64_t batch = 0;
+    while ((batch = reader->ReadBatchBinary(37, &def_levels[levels_read], nullptr,
+                &offsets, &data, &values_read)) > 0) {
+      levels_read += batch;
+      total_values += values_read;
+    }
+    ASSERT_EQ(num_levels_, levels_read);
+    ASSERT_EQ(num_values_, total_values);
+    ASSERT_TRUE(vector_equal(def_levels_, def_levels));
+
+    ASSERT_EQ((num_values_ + 1) * sizeof(int32_t), offsets.size());
+    const int32_t* value_offsets = reinterpret_cast<const int32_t*>(offsets.data());
+    ASSERT_EQ(0, value_offsets[0]);
+    ASSERT_EQ(data.size(), value_offsets[num_values_]);
+    for (int i = 0; i < num_values_; ++i) {
+      ByteArray value(value_offsets[i + 1] - value_offsets[i],
+          data.data() + value_offsets[i]);
+      ASSERT_EQ(values[i], value) << i;
+    }
+  }
+
+  // Offsets must end at the size of the data
+  InitReader(&descr);
+  OwnedMutableBuffer offsets(sizeof(int32_t));
+  OwnedMutableBuffer data(3);
+  *reinterpret_cast<int32_t*>(offsets.mutable_data()) = 0;
+  int64_t values_read = 0;
+  ASSERT_THROW(static_cast<ByteArrayReader*>(reader_.get())
+                   ->ReadBatchBinary(10, nullptr, nullptr, &offsets, &data, &values_read),
+      ParquetException);
+
+  NodePtr int32_type = schema::Int32("c", Repetition::REQUIRED);
+  const ColumnDescriptor int32_descr(int32_type, 0, 0);
+  InitReader(&int32_descr);
+  ASSERT_THROW(static_cast<Int32Reader*>(reader_.get())
+                   ->ReadBatchBinary(10, nullptr, nullptr, &offsets, &data, &values_read),
+      ParquetException);
+}
+
+// Batches spanning data pages must not return values pointing into a page
+// buffer that a later page of the batch overwrote
+TEST_F(TestPrimitiveReader, TestByteArrayBatchesAcrossPages) {
+  int levels_per_page = 50;
+  int num_pages = 6;
+  num_levels_ = levels_per_page * num_pages;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::ByteArray("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  for (Encoding::type encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    vector<ByteArray> values;
+    pages_.clear();
+    num_values_ = MakePages<ByteArrayType>(&descr, num_pages, levels_per_page,
+        def_levels_, rep_levels_, values, data_buffer_, pages_, encoding);
+    InitReader(&descr, true);
+    ByteArrayReader* reader = static_cast<ByteArrayReader*>(reader_.get());
+
+    // Batches of several pages, of a page and a half, and of a whole page
+    for (int batch_size : {175, 75, 50}) {
+      vector<ByteArray> result(batch_size);
+      vector<int16_t> def_levels(batch_size);
+      int64_t values_read = 0;
+      int64_t total_values = 0;
+      int64_t levels_read = 0;
+      int64_t batch = 0;
+      while ((batch = reader->ReadBatch(batch_size, def_levels.data(), nullptr,
+                  result.data(), &values_read)) > 0) {
+        for (int64_t i = 0; i < values_read; ++i) {
+          ASSERT_EQ(values[total_values + i], result[i]) << total_values + i;
+        }
+        levels_read += batch;
+        total_values += values_read;
+      }
+      ASSERT_EQ(num_levels_, levels_read);
+      ASSERT_EQ(num_values_, total_values);
+      InitReader(&descr, true);
+      reader = static_cast<ByteArrayReader*>(reader_.get());
+    }
+
+    // Spaced batches of several pages, whose null slots are left alone
+    int batch_size = 175;
+    vector<ByteArray> spaced(batch_size);
+    vector<uint8_t> valid_bits(batch_size / 8 + 1);
+    int64_t values_read = 0;
+    int64_t null_count = 0;
+    int64_t total_values = 0;
+    int64_t levels_read = 0;
+    int64_t batch = 0;
+    while ((batch = reader->ReadBatchSpaced(batch_size, nullptr, nullptr, spaced.data(),
+                valid_bits.data(), 0, &values_read, &null_count)) > 0) {
+      for (int64_t i = 0; i < batch; ++i) {
+        if (def_levels_[levels_read + i] == max_def_level_) {
+          ASSERT_EQ(values[total_values++], spaced[i]) << levels_read + i;
+        }
+      }
+      levels_read += batch;
+    }
+    ASSERT_EQ(num_levels_, levels_read);
+    ASSERT_EQ(num_values_, total_values);
+
+    // Selected rows spread over all pages, read in runs in between skips
+    InitReader(&descr, true);
+    reader = static_cast<ByteArrayReader*>(reader_.get());
+    vector<int32_t> selection;
+    vector<ByteArray> expected;
+    for (int32_t row = 0, value = 0; row < num_levels_; ++row) {
+      bool defined = def_levels_[row] == max_def_level_;
+      if (row % 7 < 3) {
+        selection.push_back(row);
+        if (defined) { expected.push_back(values[value]); }
+      }
+      value += defined;
+    }
+    vector<ByteArray> selected(selection.size());
+    vector<int16_t> selected_def_levels(selection.size());
+    ASSERT_EQ(static_cast<int64_t>(selection.size()),
+        reader->ReadSelected(num_levels_, selection.data(), selection.size(),
+            selected_def_levels.data(), selected.data(), &values_read));
+    ASSERT_EQ(static_cast<int64_t>(expected.size()), values_read);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i], selected[i]) << i;
+    }
+  }
+
+  NodePtr flba_type = schema::PrimitiveNode::Make("f", Repetition::REQUIRED,
+      Type::FIXED_LEN_BYTE_ARRAY, LogicalType::NONE, FLBA_LENGTH);
+  const ColumnDescriptor flba_descr(flba_type, 0, 0);
+  vector<FLBA> flba_values;
+  pages_.clear();
+  num_values_ = MakePages<FLBAType>(&flba_descr, num_pages, levels_per_page,
+      def_levels_, rep_levels_, flba_values, data_buffer_, pages_);
+  InitReader(&flba_descr, true);
+  vector<FLBA> flba_result(num_values_);
+  int64_t values_read = 0;
+  ASSERT_EQ(num_values_, static_cast<FixedLenByteArrayReader*>(reader_.get())
+                             ->ReadBatch(num_values_, nullptr, nullptr,
+                                 flba_result.data(), &values_read));
+  for (int i = 0; i < num_values_; ++i) {
+    ASSERT_EQ(0, memcmp(flba_values[i].ptr, flba_result[i].ptr, FLBA_LENGTH)) << i;
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestReadBatchIndices) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 4;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::RLE_DICTIONARY);
+  num_levels_ = num_pages * levels_per_page;
+
+  vector<uint8_t> indices(num_values_);
+  vector<int16_t> dresult(num_levels_);
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  int64_t dictionary_length = -1;
+  ASSERT_TRUE(reader->dictionary(&dictionary_length) == nullptr);
+  ASSERT_EQ(0, dictionary_length);
+
+  int64_t total_levels = 0;
+  int64_t total_values = 0;
+  int64_t levels_read = 0;
+  do {
+    int64_t values_read = 0;
+    levels_read = reader->ReadBatchIndices(
+        64, &dresult[total_levels], nullptr, &indices[total_values], &values_read);
+    total_levels += levels_read;
+    total_values += values_read;
+  } while (levels_read > 0);
+  ASSERT_FALSE(reader->dictionary_fallback());
+  ASSERT_EQ(num_levels_, total_levels);
+  ASSERT_EQ(num_values_, total_values);
+  ASSERT_TRUE(vector_equal(def_levels_, dresult));
+
+  const int32_t* dictionary = reader->dictionary(&dictionary_length);
+  ASSERT_TRUE(dictionary != nullptr);
+  for (int i = 0; i < num_values_; ++i) {
+    ASSERT_LT(indices[i], dictionary_length);
+    ASSERT_EQ(values_[i], dictionary[indices[i]]) << i;
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestReadBatchIndicesFallback) {
+  int levels_per_page = 100;
+  max_def_level_ = 0;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  // Five dictionary encoded pages followed by three PLAIN ones, as written once
+  // the dictionary outgrows its size limit
+  int num_dict_values = MakePages<Int32Type>(&descr, 5, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::RLE_DICTIONARY);
+  vector<int32_t> plain_values;
+  vector<uint8_t> plain_buffer;
+  MakePages<Int32Type>(&descr, 3, levels_per_page, def_levels_, rep_levels_,
+      plain_values, plain_buffer, pages_, Encoding::PLAIN);
+
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  vector<int32_t> indices(num_dict_values + 1);
+  int64_t values_read = 0;
+  ASSERT_EQ(num_dict_values, reader->ReadBatchIndices(num_dict_values + 1, nullptr,
+                                 nullptr, indices.data(), &values_read));
+  ASSERT_EQ(num_dict_values, values_read);
+  ASSERT_TRUE(reader->dictionary_fallback());
+  ASSERT_EQ(
+      0, reader->ReadBatchIndices(10, nullptr, nullptr, indices.data(), &values_read));
+
+  int64_t dictionary_length = 0;
+  const int32_t* dictionary = reader->dictionary(&dictionary_length);
+  for (int i = 0; i < num_dict_values; ++i) {
+    ASSERT_EQ(values_[i], dictionary[indices[i]]) << i;
+  }
+
+  // The remaining values are read from the PLAIN pages
+  vector<int32_t> vresult(plain_values.size());
+  ASSERT_EQ(static_cast<int64_t>(plain_values.size()),
+      reader->ReadBatch(plain_values.size() + 1, nullptr, nullptr, vresult.data(),
+          &values_read));
+  ASSERT_TRUE(vector_equal(plain_values, vresult));
+}
+
+// Positions of the levels whose value is divisible by three
+static vector<int32_t> DivisibleByThree(const vector<int16_t>& def_levels,
+    const vector<int32_t>& values, int16_t max_def_level, int num_levels) {
+  vector<int32_t> positions;
+  int value = 0;
+  for (int i = 0; i < num_levels; ++i) {
+    if (max_def_level > 0 && def_levels[i] != max_def_level) { continue; }
+    if (values[value++] % 3 == 0) { positions.push_back(i); }
+  }
+  return positions;
+}
+
+TEST_F(TestPrimitiveReader, TestReadBatchSelection) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 4;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::RLE_DICTIONARY);
+  num_levels_ = num_pages * levels_per_page;
+
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  int num_calls = 0;
+  reader->SetSelectionPredicate([&num_calls](const int32_t& value) {
+    ++num_calls;
+    return value % 3 == 0;
+  });
+
+  // Definition levels are not requested, so batches straddle pages with
+  // internal scratch levels
+  vector<int32_t> selection(num_levels_);
+  int64_t total_levels = 0;
+  int64_t total_selected = 0;
+  int64_t levels_read = 0;
+  do {
+    int64_t num_selected = 0;
+    levels_read = reader->ReadBatchSelection(
+        64, nullptr, nullptr, &selection[total_selected], &num_selected);
+    for (int64_t i = total_selected; i < total_selected + num_selected; ++i) {
+      selection[i] += static_cast<int32_t>(total_levels);
+    }
+    total_levels += levels_read;
+    total_selected += num_selected;
+  } while (levels_read > 0);
+  ASSERT_EQ(num_levels_, total_levels);
+  selection.resize(total_selected);
+  ASSERT_TRUE(vector_equal(
+      DivisibleByThree(def_levels_, values_, max_def_level_, num_levels_), selection));
+
+  // The predicate is evaluated once per dictionary entry
+  int64_t dictionary_length = 0;
+  reader->dictionary(&dictionary_length);
+  ASSERT_EQ(dictionary_length, num_calls);
+}
+
+TEST_F(TestPrimitiveReader, TestReadBatchSelectionPlain) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 0;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::PLAIN);
+  num_levels_ = num_pages * levels_per_page;
+
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  vector<int32_t> selection(num_levels_);
+  int64_t num_selected = 0;
+  ASSERT_THROW(reader->ReadBatchSelection(10, nullptr, nullptr, selection.data(),
+                   &num_selected),
+      ParquetException);
+
+  reader->SetSelectionPredicate([](const int32_t& value) { return value % 3 == 0; });
+  ASSERT_EQ(num_levels_, reader->ReadBatchSelection(num_levels_ + 1, nullptr, nullptr,
+                             selection.data(), &num_selected));
+  selection.resize(num_selected);
+  ASSERT_TRUE(vector_equal(
+      DivisibleByThree(def_levels_, values_, max_def_level_, num_levels_), selection));
+}
+
+TEST_F(TestPrimitiveReader, TestReadSelected) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 4;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::PLAIN);
+  num_levels_ = num_pages * levels_per_page;
+
+  MockPageReader* pager = new MockPageReader(pages_);
+  reader_ = ColumnReader::Make(&descr, std::unique_ptr<PageReader>(pager));
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+
+  // The index of the first value at or after each level
+  vector<int> value_offsets(num_levels_ + 1, 0);
+  for (int i = 0; i < num_levels_; ++i) {
+    value_offsets[i + 1] = value_offsets[i] + (def_levels_[i] == max_def_level_);
+  }
+
+  // Two batches of 500 rows: runs of rows within a page and across a page
+  // boundary, then a single row in page 8 of the second batch
+  const vector<vector<int32_t>> selections = {{3, 4, 5, 50, 98, 99, 100, 101}, {310}};
+  int row = 0;
+  for (const vector<int32_t>& selection : selections) {
+    vector<int16_t> dresult(selection.size(), -1);
+    vector<int32_t> vresult(selection.size(), -1);
+    int64_t values_read = 0;
+    ASSERT_EQ(static_cast<int64_t>(selection.size()),
+        reader->ReadSelected(500, selection.data(), selection.size(), dresult.data(),
+            vresult.data(), &values_read));
+    int value = 0;
+    for (size_t i = 0; i < selection.size(); ++i) {
+      int level = row + selection[i];
+      ASSERT_EQ(def_levels_[level], dresult[i]) << level;
+      if (dresult[i] == max_def_level_) {
+        ASSERT_EQ(values_[value_offsets[level]], vresult[value++]) << level;
+      }
+    }
+    ASSERT_EQ(value, values_read);
+    row += 500;
+  }
+  ASSERT_FALSE(reader->HasNext());
+  // Pages 2 to 4, 5 to 7 and 9 hold no selected row
+  ASSERT_EQ(7, pager->pages_skipped());
+}
+
+TEST_F(TestPrimitiveReader, TestPagePredicate) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 0;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::PLAIN);
+
+  // Page i claims values in [10 * i, 10 * i + 9]. The first page has no
+  // statistics and the second only a max
+  typedef StatisticsTraits<Int32Type> Traits;
+  for (int i = 1; i < num_pages; ++i) {
+    DataPage* page = static_cast<DataPage*>(pages_[i].get());
+    std::string min = Traits::Encode(10 * i, -1);
+    std::string max = Traits::Encode(10 * i + 9, -1);
+    page->SetStatistics(i == 1 ? nullptr : &min, &max);
+  }
+
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  reader->SetPagePredicate(RangePredicate<Int32Type>::Between(35, 52));
+
+  vector<int32_t> vresult(num_values_, -1);
+  int64_t values_read = 0;
+  int64_t total_values_read = 0;
+  while (reader->ReadBatch(64, nullptr, nullptr, &vresult[total_values_read],
+             &values_read) > 0) {
+    total_values_read += values_read;
+  }
+  // Pages 0, 3, 4 and 5 are read
+  ASSERT_EQ(4 * levels_per_page, total_values_read);
+  vector<int32_t> expected(values_.begin(), values_.begin() + levels_per_page);
+  expected.insert(expected.end(), values_.begin() + 3 * levels_per_page,
+      values_.begin() + 6 * levels_per_page);
+  vresult.resize(total_values_read);
+  ASSERT_TRUE(vector_equal(expected, vresult));
+
+  PagePruningStats stats = reader->page_pruning_stats();
+  ASSERT_EQ(6, stats.pages);
+  ASSERT_EQ(6 * levels_per_page, stats.values);
+  ASSERT_EQ(6 * levels_per_page * static_cast<int64_t>(sizeof(int32_t)), stats.bytes);
+}
+
 TEST_F(TestPrimitiveReader, TestInt32FlatOptional) {
   int levels_per_page = 100;
   int num_pages = 50;
@@ -151,6 +796,69 @@ TEST_F(TestPrimitiveReader, TestInt32FlatRepeated) {
   ExecuteDict(num_pages, levels_per_page, &descr);
 }
 
+TEST_F(TestPrimitiveReader, TestReadRecords) {
+  int levels_per_page = 100;
+  int num_pages = 20;
+  max_def_level_ = 4;
+  max_rep_level_ = 2;
+  NodePtr type = schema::Int32("c", Repetition::REPEATED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+      rep_levels_, values_, data_buffer_, pages_, Encoding::PLAIN);
+  num_levels_ = num_pages * levels_per_page;
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+
+  vector<int16_t> def_levels(num_levels_);
+  vector<int16_t> rep_levels(num_levels_);
+  vector<int32_t> values(num_values_);
+  int64_t levels_read = 0;
+  int64_t values_read = 0;
+  int64_t total_levels = 0;
+  int64_t total_values = 0;
+  bool record_split = false;
+  for (int i = 0; total_levels < num_levels_; ++i) {
+    // Small level limits cut off many records
+    int64_t num_records = i % 7;
+    int64_t max_levels = 1 + i % 11;
+    int64_t records = reader->ReadRecords(num_records, max_levels,
+        &def_levels[total_levels], &rep_levels[total_levels], &values[total_values],
+        &levels_read, &values_read, &record_split);
+    int64_t start = total_levels;
+    int64_t end = total_levels + levels_read;
+    ASSERT_EQ(
+        std::count(rep_levels_.begin() + start, rep_levels_.begin() + end, 0), records);
+    ASSERT_LE(records, num_records);
+    ASSERT_EQ(end < num_levels_ && rep_levels_[end] != 0, record_split) << i;
+
+    int64_t next = end + 1;
+    while (next < num_levels_ && rep_levels_[next] != 0) {
+      ++next;
+    }
+    if (end < num_levels_ && rep_levels_[end] != 0) {
+      // A record is only split by the limit if it has nothing in front of it or
+      // spans data pages
+      ASSERT_EQ(max_levels, levels_read);
+      int64_t last_start = end - 1;
+      while (last_start > start && rep_levels_[last_start] != 0) {
+        --last_start;
+      }
+      ASSERT_TRUE(last_start == start ||
+                  last_start / levels_per_page != (next - 1) / levels_per_page);
+    } else if (end < num_levels_ && records < num_records && levels_read < max_levels) {
+      // Stopped in front of a record that does not fit
+      ASSERT_GT(next - end, max_levels - levels_read);
+    }
+    total_levels = end;
+    total_values += values_read;
+  }
+  ASSERT_EQ(num_values_, total_values);
+  ASSERT_TRUE(vector_equal(def_levels_, def_levels));
+  ASSERT_TRUE(vector_equal(rep_levels_, rep_levels));
+  ASSERT_TRUE(vector_equal(values_, values));
+  ASSERT_FALSE(reader->HasNext());
+}
+
 TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   max_def_level_ = 0;
   max_rep_level_ = 0;
@@ -214,5 +922,48 @@ TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   pages_.clear();
 }
 
+TEST_F(TestPrimitiveReader, TestDeltaBinaryPackedPages) {
+  NodePtr type = schema::Int64("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, 0, 0);
+
+  // Two pages of increasing timestamps, each with its own header
+  vector<int64_t> values;
+  DeltaBitPackEncoder<Int64Type> encoder(&descr);
+  for (int page = 0; page < 2; ++page) {
+    int num_page_values = 300 + page * 77;
+    for (int i = 0; i < num_page_values; ++i) {
+      int64_t row = static_cast<int64_t>(values.size());
+      values.push_back(1475000000000LL + row * 1000 + i % 7);
+    }
+    encoder.Put(values.data() + values.size() - num_page_values, num_page_values);
+    pages_.push_back(std::make_shared<DataPage>(encoder.FlushValues(), num_page_values,
+        Encoding::DELTA_BINARY_PACKED, Encoding::RLE, Encoding::RLE));
+  }
+  InitReader(&descr);
+  Int64Reader* reader = static_cast<Int64Reader*>(reader_.get());
+
+  vector<int64_t> result(values.size());
+  int64_t values_read = 0;
+  int64_t total_read = 0;
+  while (reader->HasNext()) {
+    reader->ReadBatch(
+        100, nullptr, nullptr, result.data() + total_read, &values_read);
+    total_read += values_read;
+  }
+  ASSERT_EQ(static_cast<int64_t>(values.size()), total_read);
+  ASSERT_EQ(values, result);
+
+  // Floating point columns cannot be delta encoded
+  NodePtr double_type = schema::Double("b", Repetition::REQUIRED);
+  const ColumnDescriptor double_descr(double_type, 0, 0);
+  pages_.clear();
+  std::shared_ptr<Buffer> int_page = encoder.FlushValues();
+  pages_.push_back(MakeDataPage<DoubleType>(&double_descr, {}, 1,
+      Encoding::DELTA_BINARY_PACKED, int_page->data(),
+      static_cast<int>(int_page->size()), {}, 0, {}, 0));
+  InitReader(&double_descr);
+  ASSERT_THROW(reader_->HasNext(), ParquetException);
+}
+
 }  // namespace test
 }  // namespace parquet
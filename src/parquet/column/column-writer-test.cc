@@ -334,5 +334,41 @@ TYPED_TEST(TestPrimitiveWriter, RequiredLargeChunk) {
   ASSERT_EQ(this->values_, this->values_out_);
 }
 
+// DELTA_BINARY_PACKED is only defined for INT32 and INT64
+typedef TestPrimitiveWriter<Int32Type> TestInt32Writer;
+typedef TestPrimitiveWriter<Int64Type> TestInt64Writer;
+typedef TestPrimitiveWriter<DoubleType> TestDoubleWriter;
+
+TEST_F(TestInt32Writer, RequiredDeltaBinaryPacked) {
+  this->TestRequiredWithEncoding(Encoding::DELTA_BINARY_PACKED);
+}
+
+TEST_F(TestInt64Writer, RequiredDeltaBinaryPacked) {
+  this->TestRequiredWithEncoding(Encoding::DELTA_BINARY_PACKED);
+}
+
+TEST_F(TestInt64Writer, OptionalDeltaBinaryPacked) {
+  this->SetUpSchemaOptional();
+  this->GenerateData(SMALL_SIZE);
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  definition_levels[1] = 0;
+
+  auto writer = this->BuildWriter(SMALL_SIZE, Encoding::DELTA_BINARY_PACKED);
+  writer->WriteBatch(
+      this->values_.size(), definition_levels.data(), nullptr, this->values_ptr_);
+  writer->Close();
+
+  this->ReadColumn();
+  ASSERT_EQ(99, this->values_read_);
+  this->values_out_.resize(99);
+  this->values_.resize(99);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+TEST_F(TestDoubleWriter, DeltaBinaryPackedUnsupported) {
+  ASSERT_THROW(this->BuildWriter(SMALL_SIZE, Encoding::DELTA_BINARY_PACKED),
+      ParquetException);
+}
+
 }  // namespace test
 }  // namespace parquet
@@ -183,6 +183,127 @@ TEST(TestLevels, TestLevelsDecodeMultipleSetData) {
   }
 }
 
+// Test that the levels equal to the max level are counted while decoding
+TEST(TestLevels, TestLevelsDecodeAndCount) {
+  std::vector<int16_t> input_levels;
+  std::vector<uint8_t> bytes;
+  std::vector<int16_t> output_levels;
+  Encoding::type encodings[2] = {Encoding::RLE, Encoding::BIT_PACKED};
+
+  for (int encode = 0; encode < 2; encode++) {
+    Encoding::type encoding = encodings[encode];
+    for (int bit_width = 1; bit_width <= 4; bit_width++) {
+      int max_level = (1 << bit_width) - 1;
+      // Mix long repeated runs with literal runs
+      GenerateLevels(3, 7, max_level, input_levels);
+      for (int i = 0; i < 1000; i++) {
+        input_levels.push_back((i * 7) % (max_level + 1));
+      }
+      int num_levels = input_levels.size();
+      EncodeLevels(encoding, max_level, num_levels, input_levels.data(), bytes);
+
+      LevelDecoder decoder;
+      decoder.SetData(encoding, max_level, num_levels, bytes.data());
+      output_levels.resize(num_levels);
+      int batch_size = 97;
+      for (int offset = 0; offset < num_levels; offset += batch_size) {
+        int64_t num_max_levels = -1;
+        int levels_count =
+            decoder.DecodeAndCount(batch_size, output_levels.data(), &num_max_levels);
+        int expected_count = std::min(batch_size, num_levels - offset);
+        ASSERT_EQ(expected_count, levels_count);
+        int64_t expected_max_levels = 0;
+        for (int i = 0; i < levels_count; i++) {
+          ASSERT_EQ(input_levels[i + offset], output_levels[i]);
+          if (input_levels[i + offset] == max_level) { expected_max_levels++; }
+        }
+        ASSERT_EQ(expected_max_levels, num_max_levels);
+      }
+      input_levels.clear();
+    }
+  }
+}
+
+TEST(TestLevels, TestLevelsDecodeValidBits) {
+  std::vector<int16_t> input_levels;
+  std::vector<uint8_t> bytes;
+  Encoding::type encodings[2] = {Encoding::RLE, Encoding::BIT_PACKED};
+
+  for (int encode = 0; encode < 2; encode++) {
+    Encoding::type encoding = encodings[encode];
+    for (int bit_width = 1; bit_width <= 4; bit_width++) {
+      int max_level = (1 << bit_width) - 1;
+      // Mix long repeated runs with literal runs
+      GenerateLevels(3, 7, max_level, input_levels);
+      for (int i = 0; i < 1000; i++) {
+        input_levels.push_back((i * 7) % (max_level + 1));
+      }
+      int num_levels = input_levels.size();
+      EncodeLevels(encoding, max_level, num_levels, input_levels.data(), bytes);
+
+      LevelDecoder decoder;
+      decoder.SetData(encoding, max_level, num_levels, bytes.data());
+      // Start at an unaligned bit, over a bitmap whose bits must all be overwritten
+      const int bits_offset = 3;
+      std::vector<uint8_t> valid_bits((num_levels + bits_offset) / 8 + 1, 0xA5);
+      int batch_size = 97;
+      for (int offset = 0; offset < num_levels; offset += batch_size) {
+        int64_t num_max_levels = -1;
+        int levels_count = decoder.DecodeValidBits(
+            batch_size, valid_bits.data(), bits_offset + offset, &num_max_levels);
+        ASSERT_EQ(std::min(batch_size, num_levels - offset), levels_count);
+        int64_t expected_max_levels = 0;
+        for (int i = offset; i < offset + levels_count; i++) {
+          expected_max_levels += input_levels[i] == max_level;
+        }
+        ASSERT_EQ(expected_max_levels, num_max_levels);
+      }
+      for (int i = 0; i < num_levels; i++) {
+        bool is_set = valid_bits[(i + bits_offset) / 8] & (1 << ((i + bits_offset) % 8));
+        ASSERT_EQ(input_levels[i] == max_level, is_set) << i;
+      }
+      // Bits before the offset are untouched
+      ASSERT_EQ(0x5, valid_bits[0] & 0x7);
+      input_levels.clear();
+    }
+  }
+}
+
+TEST(TestLevels, TestFindRecordBoundary) {
+  // Records of 1 to 5 levels, so that boundaries fall at every position of the
+  // 8-level blocks
+  std::vector<int16_t> rep_levels;
+  for (int i = 0; i < 50; i++) {
+    rep_levels.push_back(0);
+    for (int j = 0; j < i % 5; j++) {
+      rep_levels.push_back(1 + j % 2);
+    }
+  }
+  int64_t num_levels = rep_levels.size();
+
+  for (int64_t offset : {0, 1, 5}) {
+    for (int64_t max_records = 0; max_records <= 51; max_records++) {
+      int64_t expected_records = 0;
+      int64_t expected_end = offset;
+      for (; expected_end < num_levels; expected_end++) {
+        if (rep_levels[expected_end] == 0) {
+          if (expected_records == max_records) { break; }
+          expected_records++;
+        }
+      }
+      int64_t num_records = -1;
+      int64_t end = FindRecordBoundary(
+          rep_levels.data() + offset, num_levels - offset, max_records, &num_records);
+      ASSERT_EQ(expected_end - offset, end) << offset << " " << max_records;
+      ASSERT_EQ(expected_records, num_records) << offset << " " << max_records;
+    }
+  }
+
+  int64_t num_records = -1;
+  ASSERT_EQ(0, FindRecordBoundary(rep_levels.data(), 0, 10, &num_records));
+  ASSERT_EQ(0, num_records);
+}
+
 TEST(TestLevelEncoder, MinimumBufferSize) {
   // PARQUET-676, PARQUET-698
   const int kNumToEncode = 1024;
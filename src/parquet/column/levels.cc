@@ -19,6 +19,11 @@
 
 #include <cstdint>
 
+#ifdef PARQUET_USE_SSE
+#include <emmintrin.h>
+#endif
+
+#include "parquet/util/bit-util.h"
 #include "parquet/util/rle-encoding.h"
 
 namespace parquet {
@@ -90,7 +95,7 @@ int LevelEncoder::Encode(int batch_size, const int16_t* levels) {
   return num_encoded;
 }
 
-LevelDecoder::LevelDecoder() : num_values_remaining_(0) {}
+LevelDecoder::LevelDecoder() : max_level_(0), num_values_remaining_(0) {}
 
 LevelDecoder::~LevelDecoder() {}
 
@@ -99,6 +104,7 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
   uint32_t num_bytes = 0;
   encoding_ = encoding;
   num_values_remaining_ = num_buffered_values;
+  max_level_ = max_level;
   bit_width_ = BitUtil::Log2(max_level + 1);
   switch (encoding) {
     case Encoding::RLE: {
@@ -139,4 +145,118 @@ int LevelDecoder::Decode(int batch_size, int16_t* levels) {
   return num_decoded;
 }
 
+int LevelDecoder::Peek(int batch_size, int16_t* levels) const {
+  // The decoders only reference the encoded data, so a copy reads ahead without
+  // moving this one
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    RleDecoder decoder(*rle_decoder_);
+    return decoder.GetBatch(levels, num_values);
+  } else {
+    BitReader decoder(*bit_packed_decoder_);
+    return decoder.GetBatch(bit_width_, levels, num_values);
+  }
+}
+
+int LevelDecoder::DecodeAndCount(
+    int batch_size, int16_t* levels, int64_t* num_max_levels) {
+  int num_decoded = 0;
+  *num_max_levels = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    num_decoded =
+        rle_decoder_->GetBatchAndCount(levels, num_values, max_level_, num_max_levels);
+  } else {
+    num_decoded = bit_packed_decoder_->GetBatch(bit_width_, levels, num_values);
+    *num_max_levels = CountEqual(levels, num_decoded, max_level_);
+  }
+  num_values_remaining_ -= num_decoded;
+  return num_decoded;
+}
+
+int LevelDecoder::DecodeValidBits(int batch_size, uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t* num_max_levels) {
+  int num_decoded = 0;
+  *num_max_levels = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    num_decoded = rle_decoder_->GetValidBits(
+        num_values, max_level_, valid_bits, valid_bits_offset, num_max_levels);
+  } else {
+    const int buffer_size = 1024;
+    int16_t levels[buffer_size];
+    while (num_decoded < num_values) {
+      int batch = std::min(buffer_size, num_values - num_decoded);
+      int levels_decoded = bit_packed_decoder_->GetBatch(bit_width_, levels, batch);
+      if (levels_decoded == 0) { break; }
+      LevelsToValidBits(levels, levels_decoded, max_level_, valid_bits,
+          valid_bits_offset + num_decoded);
+      *num_max_levels += CountEqual(levels, levels_decoded, max_level_);
+      num_decoded += levels_decoded;
+    }
+  }
+  num_values_remaining_ -= num_decoded;
+  return num_decoded;
+}
+
+int LevelDecoder::SkipAndCount(int num_levels, int64_t* num_max_levels) {
+  int num_skipped = 0;
+  *num_max_levels = 0;
+
+  int num_values = std::min(num_values_remaining_, num_levels);
+  if (encoding_ == Encoding::RLE) {
+    num_skipped = rle_decoder_->SkipAndCount(num_values, max_level_, num_max_levels);
+  } else {
+    const int buffer_size = 1024;
+    int16_t levels[buffer_size];
+    while (num_skipped < num_values) {
+      int batch_size = std::min(buffer_size, num_values - num_skipped);
+      int num_decoded = bit_packed_decoder_->GetBatch(bit_width_, levels, batch_size);
+      if (num_decoded == 0) { break; }
+      *num_max_levels += CountEqual(levels, num_decoded, max_level_);
+      num_skipped += num_decoded;
+    }
+  }
+  num_values_remaining_ -= num_skipped;
+  return num_skipped;
+}
+
+void LevelsToValidBits(const int16_t* levels, int64_t num_levels, int16_t max_level,
+    uint8_t* valid_bits, int64_t valid_bits_offset) {
+  for (int64_t i = 0; i < num_levels; ++i) {
+    BitUtil::SetOrClearArrayBit(
+        valid_bits, valid_bits_offset + i, levels[i] == max_level);
+  }
+}
+
+int64_t FindRecordBoundary(const int16_t* rep_levels, int64_t num_levels,
+    int64_t max_records, int64_t* num_records) {
+  int64_t records = 0;
+  int64_t i = 0;
+#ifdef PARQUET_USE_SSE
+  // Count the record starts of whole blocks of 8 levels until the boundary lies
+  // within the next block. _mm_movemask_epi8 yields two bits per 16-bit lane,
+  // of which one is kept.
+  const __m128i zero = _mm_setzero_si128();
+  for (; num_levels - i >= 8; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rep_levels + i));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(v, zero)) & 0x5555;
+    if (mask == 0) { continue; }
+    int starts = BitUtil::PopcountNoHw(mask);
+    if (records + starts > max_records) { break; }
+    records += starts;
+  }
+#endif
+  for (; i < num_levels; ++i) {
+    if (rep_levels[i] == 0) {
+      if (records == max_records) { break; }
+      ++records;
+    }
+  }
+  *num_records = records;
+  return i;
+}
+
 }  // namespace parquet
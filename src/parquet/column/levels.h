@@ -74,13 +74,45 @@ class LevelDecoder {
   // Decodes a batch of levels into an array and returns the number of levels decoded
   int Decode(int batch_size, int16_t* levels);
 
+  // Like Decode, and sets *num_max_levels to the number of decoded levels equal to
+  // the maximum level (for definition levels, the number of non-null values) in
+  // the same pass
+  int DecodeAndCount(int batch_size, int16_t* levels, int64_t* num_max_levels);
+
+  // Decodes up to batch_size levels into a validity bitmap rather than an array:
+  // bit valid_bits_offset + i of valid_bits is set if the i-th level is equal to
+  // the maximum level and cleared otherwise. *num_max_levels is set to the number
+  // of set bits. Returns the number of levels decoded
+  int DecodeValidBits(int batch_size, uint8_t* valid_bits, int64_t valid_bits_offset,
+      int64_t* num_max_levels);
+
+  // Like Decode, but leaves the decoder positioned in front of the decoded levels
+  int Peek(int batch_size, int16_t* levels) const;
+
+  // Skips up to num_levels levels and returns the number skipped, setting
+  // *num_max_levels to how many of them were equal to the maximum level
+  int SkipAndCount(int num_levels, int64_t* num_max_levels);
+
  private:
   int bit_width_;
+  int16_t max_level_;
   int num_values_remaining_;
   Encoding::type encoding_;
   std::unique_ptr<RleDecoder> rle_decoder_;
   std::unique_ptr<BitReader> bit_packed_decoder_;
 };
 
+// Sets bit valid_bits_offset + i of valid_bits if levels[i] == max_level and
+// clears it otherwise
+void LevelsToValidBits(const int16_t* levels, int64_t num_levels, int16_t max_level,
+    uint8_t* valid_bits, int64_t valid_bits_offset);
+
+// Scans repetition levels for the start of record max_records + 1, where each
+// level of 0 begins a record. Returns the number of levels in front of it, or
+// num_levels if there is none, and sets *num_records to the number of records
+// begun within them. Compares 8 levels at a time where SSE2 is enabled.
+int64_t FindRecordBoundary(const int16_t* rep_levels, int64_t num_levels,
+    int64_t max_records, int64_t* num_records);
+
 }  // namespace parquet
 #endif  // PARQUET_COLUMN_LEVELS_H
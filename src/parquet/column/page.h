@@ -23,6 +23,7 @@
 #define PARQUET_COLUMN_PAGE_H
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -67,7 +68,9 @@ class DataPage : public Page {
         num_values_(num_values),
         encoding_(encoding),
         definition_level_encoding_(definition_level_encoding),
-        repetition_level_encoding_(repetition_level_encoding) {}
+        repetition_level_encoding_(repetition_level_encoding),
+        has_max_(false),
+        has_min_(false) {}
 
   int32_t num_values() const { return num_values_; }
 
@@ -83,15 +86,27 @@ class DataPage : public Page {
   // DataPageHeader::statistics::min field, if it was set
   const uint8_t* min() const { return reinterpret_cast<const uint8_t*>(min_.c_str()); }
 
+  // The encoded statistics, nullptr if not set
+  const std::string* encoded_max() const { return has_max_ ? &max_ : nullptr; }
+  const std::string* encoded_min() const { return has_min_ ? &min_ : nullptr; }
+
+  // Either may be nullptr if not set
+  void SetStatistics(const std::string* min, const std::string* max) {
+    has_min_ = min != nullptr;
+    min_ = has_min_ ? *min : "";
+    has_max_ = max != nullptr;
+    max_ = has_max_ ? *max : "";
+  }
+
  private:
   int32_t num_values_;
   Encoding::type encoding_;
   Encoding::type definition_level_encoding_;
   Encoding::type repetition_level_encoding_;
 
-  // So max/min can be populated privately
-  friend class SerializedPageReader;
+  bool has_max_;
   std::string max_;
+  bool has_min_;
   std::string min_;
 };
 
@@ -156,15 +171,44 @@ class DictionaryPage : public Page {
   bool is_sorted_;
 };
 
+// Returns false if a data page cannot contain matching values, given its
+// encoded min and max statistics. Either may be nullptr if not set
+typedef std::function<bool(const std::string* min, const std::string* max)>
+    DataPageFilter;
+
+// Work avoided by skipping data pages rejected by a DataPageFilter
+struct PagePruningStats {
+  int64_t pages;
+  // Number of values (levels) in the skipped pages
+  int64_t values;
+  // Size of the skipped pages as stored, before decompression
+  int64_t bytes;
+};
+
 // Abstract page iterator interface. This way, we can feed column pages to the
 // ColumnReader through whatever mechanism we choose
 class PageReader {
  public:
   virtual ~PageReader() {}
 
+  // Data pages rejected by the filter are skipped by NextPage, without being
+  // read or decompressed where possible. Must be set before the first call to
+  // NextPage. Implementations which cannot filter pages ignore the filter.
+  virtual void set_data_page_filter(const DataPageFilter& filter) {}
+
+  virtual PagePruningStats pruning_stats() const { return PagePruningStats{0, 0, 0}; }
+
   // @returns: shared_ptr<Page>(nullptr) on EOS, std::shared_ptr<Page>
   // containing new Page otherwise
   virtual std::shared_ptr<Page> NextPage() = 0;
+
+  // Skips the next page without reading or decompressing its data if it is a
+  // data page with at most max_values values (levels). Implementations which
+  // cannot do this cheaply never skip.
+  //
+  // @returns: the number of values in the skipped page, or 0 if the next page
+  // was not skipped
+  virtual int64_t SkipPage(int64_t max_values) { return 0; }
 };
 
 class PageWriter {
@@ -31,12 +31,27 @@
 
 namespace parquet {
 
+class FileMetaDataCache;
+
 struct ParquetVersion {
   enum type { PARQUET_1_0, PARQUET_2_0 };
 };
 
 static int64_t DEFAULT_BUFFER_SIZE = 0;
 static bool DEFAULT_USE_BUFFERED_STREAM = false;
+static bool DEFAULT_USE_LAZY_METADATA = false;
+
+// Prefetched column chunks separated by at most this many bytes are fetched
+// with a single read
+static constexpr int64_t DEFAULT_PREFETCH_HOLE_SIZE_LIMIT = 8 * 1024;
+// Upper bound on the size of a single coalesced prefetch read
+static constexpr int64_t DEFAULT_PREFETCH_RANGE_SIZE_LIMIT = 32 * 1024 * 1024;
+// Number of compressed pages decompressed ahead of decoding on a background
+// thread. Zero decompresses each page synchronously
+static constexpr int DEFAULT_PAGE_PIPELINE_DEPTH = 0;
+// Bytes read from the end of the file when opening it, in the hope of
+// capturing both the footer and the file metadata with a single read
+static constexpr int64_t DEFAULT_FOOTER_READ_SIZE = 64 * 1024;
 
 class PARQUET_EXPORT ReaderProperties {
  public:
@@ -44,6 +59,12 @@ class PARQUET_EXPORT ReaderProperties {
       : allocator_(allocator) {
     buffered_stream_enabled_ = DEFAULT_USE_BUFFERED_STREAM;
     buffer_size_ = DEFAULT_BUFFER_SIZE;
+    prefetch_hole_size_limit_ = DEFAULT_PREFETCH_HOLE_SIZE_LIMIT;
+    prefetch_range_size_limit_ = DEFAULT_PREFETCH_RANGE_SIZE_LIMIT;
+    page_pipeline_depth_ = DEFAULT_PAGE_PIPELINE_DEPTH;
+    footer_read_size_ = DEFAULT_FOOTER_READ_SIZE;
+    metadata_cache_ = nullptr;
+    lazy_metadata_enabled_ = DEFAULT_USE_LAZY_METADATA;
   }
 
   MemoryAllocator* allocator() { return allocator_; }
@@ -70,10 +91,48 @@ class PARQUET_EXPORT ReaderProperties {
 
   int64_t buffer_size() const { return buffer_size_; }
 
+  void set_prefetch_hole_size_limit(int64_t limit) { prefetch_hole_size_limit_ = limit; }
+
+  int64_t prefetch_hole_size_limit() const { return prefetch_hole_size_limit_; }
+
+  void set_prefetch_range_size_limit(int64_t limit) {
+    prefetch_range_size_limit_ = limit;
+  }
+
+  int64_t prefetch_range_size_limit() const { return prefetch_range_size_limit_; }
+
+  void set_page_pipeline_depth(int depth) { page_pipeline_depth_ = depth; }
+
+  int page_pipeline_depth() const { return page_pipeline_depth_; }
+
+  void set_footer_read_size(int64_t size) { footer_read_size_ = size; }
+
+  int64_t footer_read_size() const { return footer_read_size_; }
+
+  // Share deserialized file metadata through the cache, e.g.
+  // default_metadata_cache(). Disabled (nullptr) by default
+  void set_metadata_cache(FileMetaDataCache* cache) { metadata_cache_ = cache; }
+
+  FileMetaDataCache* metadata_cache() const { return metadata_cache_; }
+
+  // Decode the column chunk metadata of each row group only when it is first
+  // accessed, instead of the whole footer up front
+  bool is_lazy_metadata_enabled() const { return lazy_metadata_enabled_; }
+
+  void enable_lazy_metadata() { lazy_metadata_enabled_ = true; }
+
+  void disable_lazy_metadata() { lazy_metadata_enabled_ = false; }
+
  private:
   MemoryAllocator* allocator_;
   int64_t buffer_size_;
   bool buffered_stream_enabled_;
+  int64_t prefetch_hole_size_limit_;
+  int64_t prefetch_range_size_limit_;
+  int page_pipeline_depth_;
+  int64_t footer_read_size_;
+  FileMetaDataCache* metadata_cache_;
+  bool lazy_metadata_enabled_;
 };
 
 ReaderProperties PARQUET_EXPORT default_reader_properties();
@@ -20,12 +20,15 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "parquet/column/page.h"
 #include "parquet/column/properties.h"
 
+#include "parquet/encodings/delta-bit-pack-encoding.h"
 #include "parquet/encodings/dictionary-encoding.h"
 #include "parquet/encodings/plain-encoding.h"
+#include "parquet/util/bit-util.h"
 
 namespace parquet {
 
@@ -160,7 +163,12 @@ bool TypedColumnReader<DType>::ReadNewPage() {
           case Encoding::RLE_DICTIONARY:
             throw ParquetException("Dictionary page must be before data page.");
 
-          case Encoding::DELTA_BINARY_PACKED:
+          case Encoding::DELTA_BINARY_PACKED: {
+            std::shared_ptr<DecoderType> decoder = MakeDeltaBitPackDecoder<DType>(descr_);
+            decoders_[static_cast<int>(encoding)] = decoder;
+            current_decoder_ = decoder.get();
+            break;
+          }
           case Encoding::DELTA_LENGTH_BYTE_ARRAY:
           case Encoding::DELTA_BYTE_ARRAY:
             ParquetException::NYI("Unsupported encoding");
@@ -183,16 +191,578 @@ bool TypedColumnReader<DType>::ReadNewPage() {
 // ----------------------------------------------------------------------
 // Batch read APIs
 
+// The number of bytes the values point to. Only BYTE_ARRAY and
+// FIXED_LEN_BYTE_ARRAY values point to any
+template <typename T>
+static int64_t ValueBytes(const T* values, int64_t num_values, int type_length) {
+  return 0;
+}
+
+// Values are spaced if valid_bits is not nullptr, in which case only those
+// whose bit is set are considered
+static inline bool IsValid(const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  return valid_bits == nullptr || BitUtil::GetArrayBit(valid_bits, valid_bits_offset);
+}
+
+// The number of bytes the values point to
+template <typename T>
+static int64_t ValueBytes(const T* values, int64_t num_values, int type_length,
+    const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  return 0;
+}
+
+static int64_t ValueBytes(const ByteArray* values, int64_t num_values, int type_length,
+    const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  int64_t num_bytes = 0;
+  for (int64_t i = 0; i < num_values; ++i) {
+    if (IsValid(valid_bits, valid_bits_offset + i)) { num_bytes += values[i].len; }
+  }
+  return num_bytes;
+}
+
+static int64_t ValueBytes(const FixedLenByteArray* values, int64_t num_values,
+    int type_length, const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  int64_t num_bytes = 0;
+  for (int64_t i = 0; i < num_values; ++i) {
+    if (IsValid(valid_bits, valid_bits_offset + i)) { num_bytes += type_length; }
+  }
+  return num_bytes;
+}
+
+// Copy the bytes the values point to into out, which has room for ValueBytes,
+// and point the values at the copies
+template <typename T>
+static void CopyValueBytes(T* values, int64_t num_values, int type_length,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, uint8_t* out) {}
+
+static void CopyValueBytes(ByteArray* values, int64_t num_values, int type_length,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, uint8_t* out) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    if (!IsValid(valid_bits, valid_bits_offset + i)) { continue; }
+    memcpy(out, values[i].ptr, values[i].len);
+    values[i].ptr = out;
+    out += values[i].len;
+  }
+}
+
+static void CopyValueBytes(FixedLenByteArray* values, int64_t num_values,
+    int type_length, const uint8_t* valid_bits, int64_t valid_bits_offset,
+    uint8_t* out) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    if (!IsValid(valid_bits, valid_bits_offset + i)) { continue; }
+    memcpy(out, values[i].ptr, type_length);
+    values[i].ptr = out;
+    out += type_length;
+  }
+}
+
+template <typename DType>
+void TypedColumnReader<DType>::RetainValues(T* values, int64_t num_values,
+    const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  if (current_decoder_ == nullptr ||
+      current_decoder_->encoding() == Encoding::RLE_DICTIONARY) {
+    return;
+  }
+  int type_length = descr_->type_length();
+  int64_t num_bytes =
+      ValueBytes(values, num_values, type_length, valid_bits, valid_bits_offset);
+  if (num_bytes == 0) { return; }
+  auto copy = std::make_shared<OwnedMutableBuffer>(num_bytes, allocator_);
+  CopyValueBytes(values, num_values, type_length, valid_bits, valid_bits_offset,
+      copy->mutable_data());
+  retained_values_.push_back(copy);
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::Skip(int64_t num_rows) {
+  if (descr_->max_repetition_level() > 0) {
+    ParquetException::NYI("Skipping rows of repeated columns");
+  }
+
+  int64_t rows_to_skip = num_rows;
+  while (rows_to_skip > 0) {
+    if (num_buffered_values_ == 0 || num_decoded_values_ == num_buffered_values_) {
+      // Rows and levels coincide, so whole pages can be skipped by their value count
+      int64_t page_values;
+      while (rows_to_skip > 0 && (page_values = pager_->SkipPage(rows_to_skip)) > 0) {
+        rows_to_skip -= page_values;
+      }
+      if (rows_to_skip == 0 || !HasNext()) { break; }
+    }
+
+    int64_t levels_remaining = num_buffered_values_ - num_decoded_values_;
+    int batch_size = static_cast<int>(std::min(rows_to_skip, levels_remaining));
+    int64_t values_to_skip = batch_size;
+    if (descr_->max_definition_level() > 0) {
+      int num_skipped =
+          definition_level_decoder_.SkipAndCount(batch_size, &values_to_skip);
+      if (num_skipped != batch_size) { ParquetException::EofException(); }
+    }
+    if (current_decoder_->Skip(static_cast<int>(values_to_skip)) != values_to_skip) {
+      ParquetException::EofException();
+    }
+    num_decoded_values_ += batch_size;
+    rows_to_skip -= batch_size;
+  }
+  return num_rows - rows_to_skip;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadRecords(int64_t num_records, int64_t max_levels,
+    int16_t* def_levels, int16_t* rep_levels, T* values, int64_t* levels_read,
+    int64_t* values_read, bool* record_split) {
+  *levels_read = 0;
+  *values_read = 0;
+  if (record_split != nullptr) { *record_split = false; }
+  if (descr_->max_repetition_level() == 0) {
+    // Every level begins a record
+    *levels_read = ReadBatch(static_cast<int32_t>(std::min(num_records, max_levels)),
+        def_levels, nullptr, values, values_read);
+    return *levels_read;
+  }
+
+  retained_values_.clear();
+  int64_t records_read = 0;
+  int64_t page_values_begin = 0;
+  bool split = false;
+  while (*levels_read < max_levels) {
+    bool page_exhausted =
+        num_buffered_values_ == 0 || num_decoded_values_ == num_buffered_values_;
+    if (page_exhausted && *values_read > page_values_begin) {
+      RetainValues(values + page_values_begin, *values_read - page_values_begin);
+      page_values_begin = *values_read;
+    }
+    // HasNext invokes ReadNewPage
+    if (!HasNext()) { break; }
+
+    // Look ahead at the repetition levels of the current page for the first
+    // record not to be read. One level past the limit tells whether the last
+    // record would be cut off by it.
+    int64_t levels_remaining = num_buffered_values_ - num_decoded_values_;
+    int batch_size =
+        static_cast<int>(std::min(levels_remaining, max_levels - *levels_read));
+    scratch_rep_levels_.resize(batch_size + 1);
+    int num_peeked = repetition_level_decoder_.Peek(
+        static_cast<int>(std::min<int64_t>(levels_remaining, batch_size + 1)),
+        scratch_rep_levels_.data());
+    bool cut_off = num_peeked > batch_size && scratch_rep_levels_[batch_size] != 0;
+    num_peeked = std::min(num_peeked, batch_size);
+
+    int64_t page_records = 0;
+    int num_levels = static_cast<int>(FindRecordBoundary(scratch_rep_levels_.data(),
+        num_peeked, num_records - records_read, &page_records));
+    records_read += page_records;
+    bool stop = num_levels < batch_size;
+    if (num_levels == batch_size && cut_off) {
+      // Leave the last record to the next call, unless it began in an earlier
+      // page or has nothing in front of it in this call
+      int last_start = num_levels - 1;
+      while (last_start >= 0 && scratch_rep_levels_[last_start] != 0) {
+        --last_start;
+      }
+      if (last_start > 0 || (last_start == 0 && *levels_read > 0)) {
+        num_levels = last_start;
+        --records_read;
+        stop = true;
+      } else {
+        split = true;
+      }
+    }
+    std::copy(scratch_rep_levels_.begin(), scratch_rep_levels_.begin() + num_levels,
+        rep_levels + *levels_read);
+
+    int64_t num_values = num_levels;
+    int64_t num_max_rep_levels = 0;
+    if (repetition_level_decoder_.SkipAndCount(num_levels, &num_max_rep_levels) !=
+        num_levels) {
+      ParquetException::EofException();
+    }
+    if (descr_->max_definition_level() > 0) {
+      if (ReadDefinitionLevels(num_levels, def_levels + *levels_read, &num_values) !=
+          num_levels) {
+        throw ParquetException("Number of decoded rep / def levels did not match");
+      }
+    }
+    int64_t page_values_read = ReadValues(num_values, values + *values_read);
+    num_decoded_values_ += num_levels;
+    *levels_read += num_levels;
+    *values_read += page_values_read;
+
+    // Stopped in front of a record, or the page is malformed
+    if (stop) { break; }
+  }
+
+  if (record_split == nullptr) { return records_read; }
+  if (!split && *levels_read == max_levels && max_levels > 0 &&
+      num_decoded_values_ == num_buffered_values_) {
+    // The limit fell on the end of a page, whose last record may go on in the
+    // next one
+    if (*values_read > page_values_begin) {
+      RetainValues(values + page_values_begin, *values_read - page_values_begin);
+    }
+    int16_t next_rep_level = 0;
+    split = HasNext() && repetition_level_decoder_.Peek(1, &next_rep_level) == 1 &&
+            next_rep_level != 0;
+  }
+  *record_split = split;
+  return records_read;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadSelected(int64_t num_rows,
+    const int32_t* selection, int64_t num_selected, int16_t* def_levels, T* values,
+    int64_t* values_read) {
+  if (descr_->max_repetition_level() > 0) {
+    ParquetException::NYI("Selective reads of repeated columns");
+  }
+
+  retained_values_.clear();
+  int64_t row = 0;
+  int64_t rows_read = 0;
+  *values_read = 0;
+  while (rows_read < num_selected) {
+    int64_t gap = selection[rows_read] - row;
+    if (gap > 0) {
+      int64_t skipped = Skip(gap);
+      row += skipped;
+      if (skipped < gap) { break; }
+    }
+
+    // Read the run of consecutive selected rows in one batch
+    int64_t run_length = 1;
+    while (rows_read + run_length < num_selected &&
+           selection[rows_read + run_length] == row + run_length) {
+      ++run_length;
+    }
+    int64_t run_values_read = 0;
+    int64_t levels_read = ReadBatchRetaining(static_cast<int32_t>(run_length),
+        def_levels ? def_levels + rows_read : nullptr, nullptr,
+        values + *values_read, &run_values_read, nullptr);
+    // The pages of the run may be left by the next Skip or run
+    RetainValues(values + *values_read, run_values_read);
+    row += levels_read;
+    rows_read += levels_read;
+    *values_read += run_values_read;
+    if (levels_read < run_length) { return rows_read; }
+  }
+  if (row < num_rows) { Skip(num_rows - row); }
+  return rows_read;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadPageBatchSpaced(int64_t batch_size,
+    int16_t* def_levels, int16_t* rep_levels, T* values, uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t* values_read) {
+  int64_t levels_remaining = num_buffered_values_ - num_decoded_values_;
+  batch_size = std::min(batch_size, levels_remaining);
+
+  if (descr_->max_definition_level() == 0) {
+    // Required, non-repeated field: every slot holds a value
+    *values_read = ReadValues(batch_size, values);
+    BitUtil::SetArrayBits(valid_bits, valid_bits_offset, *values_read, true);
+    num_decoded_values_ += *values_read;
+    return *values_read;
+  }
+
+  int16_t max_def_level = descr_->max_definition_level();
+  int64_t num_levels = 0;
+  int64_t num_defined = 0;
+  if (def_levels) {
+    num_levels = ReadDefinitionLevels(batch_size, def_levels, &num_defined);
+    LevelsToValidBits(def_levels, num_levels, max_def_level, valid_bits,
+        valid_bits_offset);
+  } else {
+    num_levels = definition_level_decoder_.DecodeValidBits(
+        static_cast<int>(batch_size), valid_bits, valid_bits_offset, &num_defined);
+  }
+
+  // Not present for non-repeated fields
+  if (descr_->max_repetition_level() > 0 && rep_levels) {
+    if (ReadRepetitionLevels(num_levels, rep_levels) != num_levels) {
+      throw ParquetException("Number of decoded rep / def levels did not match");
+    }
+  }
+
+  current_decoder_->DecodeSpaced(values, static_cast<int>(num_levels),
+      static_cast<int>(num_levels - num_defined), valid_bits, valid_bits_offset);
+  *values_read = num_defined;
+  num_decoded_values_ += num_levels;
+  return num_levels;
+}
+
+// Physical types whose PLAIN encoding is the in-memory representation of c_type
+static bool IsPlainFixedWidth(Type::type type) {
+  switch (type) {
+    case Type::INT32:
+    case Type::INT64:
+    case Type::INT96:
+    case Type::FLOAT:
+    case Type::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadBatchView(
+    int32_t batch_size, std::shared_ptr<Buffer>* values) {
+  if (descr_->max_definition_level() > 0 || descr_->max_repetition_level() > 0) {
+    throw ParquetException("ReadBatchView requires a required, non-repeated column");
+  }
+  if (!HasNext()) {
+    *values = std::make_shared<Buffer>(nullptr, 0);
+    return 0;
+  }
+  batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
+
+  const std::shared_ptr<Buffer>& page_buffer = current_page_->buffer();
+  if (current_decoder_->encoding() == Encoding::PLAIN &&
+      IsPlainFixedWidth(descr_->physical_type())) {
+    const uint8_t* data;
+    int64_t num_values = current_decoder_->DecodeInPlace(batch_size, &data);
+    int64_t num_bytes = num_values * sizeof(T);
+    num_decoded_values_ += num_values;
+
+    if (page_buffer->is_shared() &&
+        reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+      *values = std::make_shared<Buffer>(page_buffer, data - page_buffer->data(),
+          num_bytes);
+    } else {
+      auto out = std::make_shared<OwnedMutableBuffer>(num_bytes, allocator_);
+      memcpy(out->mutable_data(), data, num_bytes);
+      *values = out;
+    }
+    return num_values;
+  }
+
+  auto out = std::make_shared<OwnedMutableBuffer>(batch_size * sizeof(T), allocator_);
+  int64_t num_values = 0;
+  ReadBatch(batch_size, nullptr, nullptr, reinterpret_cast<T*>(out->mutable_data()),
+      &num_values);
+  out->Resize(num_values * sizeof(T));
+  *values = out;
+  return num_values;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadBatchBinary(int32_t batch_size,
+    int16_t* def_levels, int16_t* rep_levels, OwnedMutableBuffer* offsets,
+    OwnedMutableBuffer* data, int64_t* values_read) {
+  if (descr_->physical_type() != Type::BYTE_ARRAY) {
+    throw ParquetException("ReadBatchBinary requires a BYTE_ARRAY column");
+  }
+  if (offsets->size() == 0) {
+    offsets->Resize(sizeof(int32_t));
+    *reinterpret_cast<int32_t*>(offsets->mutable_data()) = 0;
+  }
+  int64_t num_offsets = offsets->size() / sizeof(int32_t);
+  if (offsets->size() % sizeof(int32_t) != 0 ||
+      reinterpret_cast<const int32_t*>(offsets->data())[num_offsets - 1] !=
+          data->size()) {
+    throw ParquetException("Offsets do not end at the size of the data");
+  }
+
+  int64_t total_levels = 0;
+  *values_read = 0;
+  while (total_levels < batch_size) {
+    // HasNext invokes ReadNewPage
+    if (!HasNext()) { break; }
+
+    int64_t values_to_read = 0;
+    int64_t num_def_levels = ReadPageLevels(batch_size - total_levels,
+        def_levels ? def_levels + total_levels : nullptr,
+        rep_levels ? rep_levels + total_levels : nullptr, &values_to_read);
+    ReserveForAppend(offsets, (num_offsets + values_to_read) * sizeof(int32_t));
+    int64_t page_values_read = current_decoder_->DecodeBinary(
+        static_cast<int>(values_to_read),
+        reinterpret_cast<int32_t*>(offsets->mutable_data()) + num_offsets, data);
+    num_offsets += page_values_read;
+    offsets->Resize(num_offsets * sizeof(int32_t));
+
+    int64_t levels_read = std::max(num_def_levels, page_values_read);
+    num_decoded_values_ += levels_read;
+    total_levels += levels_read;
+    *values_read += page_values_read;
+    if (levels_read == 0) { break; }
+  }
+  return total_levels;
+}
+
 int64_t ColumnReader::ReadDefinitionLevels(int64_t batch_size, int16_t* levels) {
   if (descr_->max_definition_level() == 0) { return 0; }
   return definition_level_decoder_.Decode(batch_size, levels);
 }
 
+int64_t ColumnReader::ReadDefinitionLevels(
+    int64_t batch_size, int16_t* levels, int64_t* num_defined_values) {
+  *num_defined_values = 0;
+  if (descr_->max_definition_level() == 0) { return 0; }
+  return definition_level_decoder_.DecodeAndCount(
+      batch_size, levels, num_defined_values);
+}
+
 int64_t ColumnReader::ReadRepetitionLevels(int64_t batch_size, int16_t* levels) {
   if (descr_->max_repetition_level() == 0) { return 0; }
   return repetition_level_decoder_.Decode(batch_size, levels);
 }
 
+int64_t ColumnReader::ReadPageLevels(int64_t batch_size, int16_t* def_levels,
+    int16_t* rep_levels, int64_t* values_to_read) {
+  int64_t levels_remaining = num_buffered_values_ - num_decoded_values_;
+  batch_size = std::min(batch_size, levels_remaining);
+
+  int64_t num_def_levels = 0;
+  int64_t num_rep_levels = 0;
+
+  // If the field is required and non-repeated, there are no definition levels
+  if (descr_->max_definition_level() > 0 && def_levels) {
+    num_def_levels = ReadDefinitionLevels(batch_size, def_levels, values_to_read);
+  } else {
+    // Required field, read all values
+    *values_to_read = batch_size;
+  }
+
+  // Not present for non-repeated fields
+  if (descr_->max_repetition_level() > 0 && rep_levels) {
+    num_rep_levels = ReadRepetitionLevels(batch_size, rep_levels);
+    if (def_levels && num_def_levels != num_rep_levels) {
+      throw ParquetException("Number of decoded rep / def levels did not match");
+    }
+  }
+  return num_def_levels;
+}
+
+// ----------------------------------------------------------------------
+// Dictionary-preserving reads
+
+template <typename DType>
+template <typename IndexType>
+int64_t TypedColumnReader<DType>::ReadBatchIndices(int32_t batch_size,
+    int16_t* def_levels, int16_t* rep_levels, IndexType* indices, int64_t* values_read) {
+  int64_t total_levels = 0;
+  *values_read = 0;
+
+  while (total_levels < batch_size) {
+    // HasNext invokes ReadNewPage
+    if (!HasNext() || dictionary_fallback()) { break; }
+    auto decoder = static_cast<DictionaryDecoder<DType>*>(current_decoder_);
+
+    int64_t values_to_read = 0;
+    int64_t num_def_levels = ReadPageLevels(batch_size - total_levels,
+        def_levels ? def_levels + total_levels : nullptr,
+        rep_levels ? rep_levels + total_levels : nullptr, &values_to_read);
+    int64_t page_values_read = decoder->DecodeIndices(
+        indices + *values_read, static_cast<int>(values_to_read));
+    int64_t levels_read = std::max(num_def_levels, page_values_read);
+    num_decoded_values_ += levels_read;
+
+    total_levels += levels_read;
+    *values_read += page_values_read;
+    if (levels_read == 0) { break; }
+  }
+  return total_levels;
+}
+
+template <typename DType>
+const typename DType::c_type* TypedColumnReader<DType>::dictionary(
+    int64_t* dictionary_length) const {
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  if (it == decoders_.end()) {
+    *dictionary_length = 0;
+    return nullptr;
+  }
+  const Vector<T>& dictionary =
+      static_cast<const DictionaryDecoder<DType>*>(it->second.get())->dictionary();
+  *dictionary_length = dictionary.size();
+  return dictionary.data();
+}
+
+// ----------------------------------------------------------------------
+// Predicate evaluation
+
+template <typename DType>
+const uint8_t* TypedColumnReader<DType>::SelectionMask() {
+  if (!selection_mask_ready_) {
+    int64_t dictionary_length;
+    const T* dict = dictionary(&dictionary_length);
+    selection_mask_.resize(dictionary_length);
+    for (int64_t i = 0; i < dictionary_length; ++i) {
+      selection_mask_[i] = selection_predicate_(dict[i]);
+    }
+    selection_mask_ready_ = true;
+  }
+  return selection_mask_.data();
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadBatchSelection(int32_t batch_size,
+    int16_t* def_levels, int16_t* rep_levels, int32_t* selection, int64_t* num_selected) {
+  if (!selection_predicate_) { throw ParquetException("No selection predicate set"); }
+
+  int16_t max_def_level = descr_->max_definition_level();
+  if (max_def_level > 0 && !def_levels) {
+    // The levels are needed to map values to their positions
+    scratch_def_levels_.resize(batch_size);
+    def_levels = scratch_def_levels_.data();
+  }
+
+  int64_t total_levels = 0;
+  *num_selected = 0;
+  while (total_levels < batch_size) {
+    // HasNext invokes ReadNewPage
+    if (!HasNext()) { break; }
+
+    int16_t* page_def_levels = max_def_level > 0 ? def_levels + total_levels : nullptr;
+    int64_t values_to_read = 0;
+    int64_t num_def_levels = ReadPageLevels(batch_size - total_levels, page_def_levels,
+        rep_levels ? rep_levels + total_levels : nullptr, &values_to_read);
+
+    // Select the page's values by their index among the values read
+    int64_t first_selected = *num_selected;
+    int64_t values_read = 0;
+    if (current_decoder_->encoding() == Encoding::RLE_DICTIONARY) {
+      const uint8_t* mask = SelectionMask();
+      values_read = static_cast<DictionaryDecoder<DType>*>(current_decoder_)
+                        ->DecodeSelection(mask, static_cast<int>(values_to_read), 0,
+                            selection, num_selected);
+    } else {
+      scratch_values_.Resize(values_to_read * sizeof(T));
+      T* values = reinterpret_cast<T*>(scratch_values_.mutable_data());
+      values_read = ReadValues(values_to_read, values);
+      int64_t selected = *num_selected;
+      for (int64_t i = 0; i < values_read; ++i) {
+        selection[selected] = static_cast<int32_t>(i);
+        selected += selection_predicate_(values[i]);
+      }
+      *num_selected = selected;
+    }
+
+    // Translate the value indices into level positions within the batch
+    if (page_def_levels) {
+      int32_t value = 0;
+      int64_t next = first_selected;
+      for (int64_t i = 0; i < num_def_levels && next < *num_selected; ++i) {
+        if (page_def_levels[i] != max_def_level) { continue; }
+        if (selection[next] == value) {
+          selection[next++] = static_cast<int32_t>(total_levels + i);
+        }
+        ++value;
+      }
+    } else {
+      for (int64_t i = first_selected; i < *num_selected; ++i) {
+        selection[i] += static_cast<int32_t>(total_levels);
+      }
+    }
+
+    int64_t levels_read = std::max(num_def_levels, values_read);
+    num_decoded_values_ += levels_read;
+    total_levels += levels_read;
+    if (levels_read == 0) { break; }
+  }
+  return total_levels;
+}
+
 // ----------------------------------------------------------------------
 // Dynamic column reader constructor
 
@@ -235,4 +805,25 @@ template class TypedColumnReader<DoubleType>;
 template class TypedColumnReader<ByteArrayType>;
 template class TypedColumnReader<FLBAType>;
 
+#define INSTANTIATE_READ_BATCH_INDICES(DType, IndexType)                  \
+  template int64_t TypedColumnReader<DType>::ReadBatchIndices<IndexType>( \
+      int32_t, int16_t*, int16_t*, IndexType*, int64_t*)
+
+#define INSTANTIATE_ALL_READ_BATCH_INDICES(DType)  \
+  INSTANTIATE_READ_BATCH_INDICES(DType, uint8_t);  \
+  INSTANTIATE_READ_BATCH_INDICES(DType, uint16_t); \
+  INSTANTIATE_READ_BATCH_INDICES(DType, int32_t)
+
+INSTANTIATE_ALL_READ_BATCH_INDICES(BooleanType);
+INSTANTIATE_ALL_READ_BATCH_INDICES(Int32Type);
+INSTANTIATE_ALL_READ_BATCH_INDICES(Int64Type);
+INSTANTIATE_ALL_READ_BATCH_INDICES(Int96Type);
+INSTANTIATE_ALL_READ_BATCH_INDICES(FloatType);
+INSTANTIATE_ALL_READ_BATCH_INDICES(DoubleType);
+INSTANTIATE_ALL_READ_BATCH_INDICES(ByteArrayType);
+INSTANTIATE_ALL_READ_BATCH_INDICES(FLBAType);
+
+#undef INSTANTIATE_ALL_READ_BATCH_INDICES
+#undef INSTANTIATE_READ_BATCH_INDICES
+
 }  // namespace parquet
@@ -21,15 +21,19 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "parquet/column/levels.h"
 #include "parquet/column/page.h"
+#include "parquet/column/statistics.h"
 #include "parquet/encodings/decoder.h"
 #include "parquet/exception.h"
 #include "parquet/schema/descriptor.h"
 #include "parquet/types.h"
+#include "parquet/util/buffer.h"
 #include "parquet/util/mem-allocator.h"
 #include "parquet/util/visibility.h"
 
@@ -58,6 +62,9 @@ class PARQUET_EXPORT ColumnReader {
 
   const ColumnDescriptor* descr() const { return descr_; }
 
+  // The data pages skipped so far because of their statistics
+  PagePruningStats page_pruning_stats() const { return pager_->pruning_stats(); }
+
  protected:
   virtual bool ReadNewPage() = 0;
 
@@ -66,10 +73,23 @@ class PARQUET_EXPORT ColumnReader {
   // Returns the number of decoded definition levels
   int64_t ReadDefinitionLevels(int64_t batch_size, int16_t* levels);
 
+  // Like ReadDefinitionLevels, also counting the levels equal to the max
+  // definition level, i.e. the number of values to decode, while decoding
+  int64_t ReadDefinitionLevels(
+      int64_t batch_size, int16_t* levels, int64_t* num_defined_values);
+
   // Read multiple repetition levels into preallocated memory
   // Returns the number of decoded repetition levels
   int64_t ReadRepetitionLevels(int64_t batch_size, int16_t* levels);
 
+  // Read the levels of up to batch_size values from the current data page,
+  // setting *values_to_read to the number of values to decode for them. Levels
+  // are only decoded into the arrays which are not nullptr.
+  //
+  // Returns the number of definition levels read
+  int64_t ReadPageLevels(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+      int64_t* values_to_read);
+
   const ColumnDescriptor* descr_;
 
   std::unique_ptr<PageReader> pager_;
@@ -104,9 +124,14 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   TypedColumnReader(const ColumnDescriptor* schema, std::unique_ptr<PageReader> pager,
       MemoryAllocator* allocator = default_allocator())
-      : ColumnReader(schema, std::move(pager), allocator), current_decoder_(NULL) {}
+      : ColumnReader(schema, std::move(pager), allocator),
+        current_decoder_(NULL),
+        selection_mask_ready_(false),
+        scratch_values_(0, allocator) {}
   virtual ~TypedColumnReader() {}
 
+  typedef std::function<bool(const T& value)> ValuePredicate;
+
   // Read a batch of repetition levels, definition levels, and values from the
   // column.
   //
@@ -118,6 +143,16 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   // This is only safe if you know through some other source that there are no
   // undefined values.
   //
+  // Data pages are read until the batch is full, so fewer than batch_size
+  // levels are only returned at the end of the column chunk. If page_transitions
+  // is not nullptr, it is set to the number of new data pages that had to be
+  // started to fill the batch.
+  //
+  // BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values point into memory held by the
+  // reader: the current data page, or copies of the values of the earlier pages
+  // of the batch, since the PageReader may reuse a page's memory for the next.
+  // They are valid until the next call reading from or skipping in the column.
+  //
   // To fully exhaust a row group, you must read batches until the number of
   // values read reaches the number of stored values according to the metadata.
   //
@@ -125,7 +160,164 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   //
   // @returns: actual number of levels read (see values_read for number of values read)
   int64_t ReadBatch(int32_t batch_size, int16_t* def_levels, int16_t* rep_levels,
-      T* values, int64_t* values_read);
+      T* values, int64_t* values_read, int64_t* page_transitions = nullptr);
+
+  // Like ReadBatch, but values are "spaced": the value of the i-th level read is
+  // stored at values[i] and bit valid_bits_offset + i of valid_bits is set,
+  // while the slots of levels without a value (nulls, and empty lists of
+  // repeated columns) are left with unspecified contents and their bits are
+  // cleared. values must have room for batch_size values and valid_bits for
+  // valid_bits_offset + batch_size bits; the bits are numbered LSB first.
+  //
+  // When def_levels is nullptr the validity bitmap is produced directly from the
+  // runs of the encoded definition levels, without materializing them.
+  //
+  // *values_read is set to the number of non-null values and *null_count to the
+  // number of null slots. BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values are valid
+  // for as long as those of ReadBatch.
+  //
+  // @returns: the number of levels (slots) read
+  int64_t ReadBatchSpaced(int32_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+      T* values, uint8_t* valid_bits, int64_t valid_bits_offset, int64_t* values_read,
+      int64_t* null_count);
+
+  // BYTE_ARRAY only. Like ReadBatch, but rather than as ByteArrays pointing into
+  // the data pages, the values are returned as one contiguous run of bytes
+  // which outlives the pages. Their bytes are appended to data, and the offset
+  // in data past the end of each to offsets, a buffer of int32_t's beginning
+  // with a 0 (written first if offsets is empty). Value i of the buffers thus
+  // spans [offsets[i], offsets[i + 1]) of data, and further calls keep
+  // appending to both. The buffers grow as needed and their size() is the
+  // number of bytes in use. Runs of dictionary entries and PLAIN values are
+  // copied with memcpy.
+  //
+  // A ParquetException is thrown if data would outgrow int32_t offsets.
+  //
+  // @returns: the number of levels read
+  int64_t ReadBatchBinary(int32_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+      OwnedMutableBuffer* offsets, OwnedMutableBuffer* data, int64_t* values_read);
+
+  // Like ReadBatch, but each value is returned as its index into the column
+  // chunk's dictionary (see dictionary()) rather than materialized, so that
+  // callers can filter, group or join on small integers and only look up the
+  // values they keep. IndexType is uint8_t, uint16_t or int32_t and must be wide
+  // enough for the bit width of the data pages' indices, which writers derive
+  // from the dictionary size; a ParquetException is thrown otherwise.
+  //
+  // Only dictionary encoded data pages are read. If the writer fell back to
+  // another encoding part-way through the column chunk, reading stops in front
+  // of the first such page and dictionary_fallback() becomes true. The rest of
+  // the column chunk can then be read with ReadBatch.
+  //
+  // @returns: the number of levels read
+  template <typename IndexType>
+  int64_t ReadBatchIndices(int32_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+      IndexType* indices, int64_t* values_read);
+
+  // Sets the predicate evaluated by ReadBatchSelection
+  void SetSelectionPredicate(const ValuePredicate& predicate) {
+    selection_predicate_ = predicate;
+    selection_mask_ready_ = false;
+  }
+
+  // Like ReadBatch, but instead of values returns the positions of the levels
+  // read whose value satisfies the selection predicate, in increasing order. A
+  // position i refers to the i-th level read by this call; null values are
+  // never selected. selection must have room for batch_size positions and
+  // *num_selected is set to the number of positions written.
+  //
+  // On dictionary encoded data pages the predicate is evaluated only once per
+  // dictionary entry, and the pages' indices are matched against the results
+  // in bulk, run by run, without decoding any values. Other pages are decoded
+  // and the predicate evaluated per value.
+  //
+  // @returns: the number of levels read
+  int64_t ReadBatchSelection(int32_t batch_size, int16_t* def_levels,
+      int16_t* rep_levels, int32_t* selection, int64_t* num_selected);
+
+  // The decoded dictionary of the column chunk, nullptr if it has none. It is
+  // read along with the first data page, e.g. by HasNext(), and stays valid for
+  // the lifetime of the reader
+  const T* dictionary(int64_t* dictionary_length) const;
+
+  // True if the current data page is not dictionary encoded
+  bool dictionary_fallback() const {
+    return num_buffered_values_ > 0 && current_decoder_ != NULL &&
+           current_decoder_->encoding() != Encoding::RLE_DICTIONARY;
+  }
+
+  // Read up to batch_size values of a required, non-repeated column, avoiding a
+  // copy where possible. If the current data page is PLAIN encoded, its buffer
+  // outlives the page reader (an uncompressed page of an in-memory column chunk)
+  // and the values are aligned for T, *values is set to a view into the page.
+  // The view shares ownership of the page buffer, but not of memory the page
+  // buffer merely references: pages read from a MemoryMapSource point into the
+  // mapping, so their views are only valid until the source is closed.
+  // Otherwise the values are decoded into a newly allocated buffer. Unlike
+  // ReadBatch, values are read from at most one data page. BYTE_ARRAY /
+  // FIXED_LEN_BYTE_ARRAY values point into the page.
+  //
+  // @returns: the number of values read; *values holds that many T's
+  int64_t ReadBatchView(int32_t batch_size, std::shared_ptr<Buffer>* values);
+
+  // Skip up to num_rows rows of a non-repeated column without materializing
+  // them. Data pages lying entirely within the skipped range are skipped using
+  // their header, without being decompressed, where the PageReader supports it.
+  // Within a page, levels and values are skipped by the decoders.
+  //
+  // @returns: the number of rows skipped, less than num_rows only at the end of
+  // the column chunk
+  int64_t Skip(int64_t num_rows);
+
+  // Read the levels and values of up to num_records whole records (rows),
+  // writing at most max_levels levels. A record begins at each repetition level
+  // of 0, so reading stops in front of the level that would begin record
+  // num_records + 1, at the end of the column chunk, or in front of a record
+  // that does not fit into the remaining levels, so batches end on record
+  // boundaries. A record is only split if it has more than max_levels levels by
+  // itself, or if it spans data pages and the limit falls at or after the end
+  // of its first page. Its remaining levels are then returned by the next call,
+  // which does not count it again. With num_records = 0, only the rest of the current
+  // record is read. If record_split is not nullptr, it is set to whether the
+  // call ended within a record; finding out may advance to the next data page.
+  //
+  // Levels are written as by ReadBatch, so rep_levels (def_levels) is left
+  // untouched if the column is not repeated (has no definition levels), and
+  // BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values are valid as long as theirs.
+  //
+  // @returns: the number of records begun; *levels_read and *values_read are
+  // set to the number of levels and values read
+  int64_t ReadRecords(int64_t num_records, int64_t max_levels, int16_t* def_levels,
+      int16_t* rep_levels, T* values, int64_t* levels_read, int64_t* values_read,
+      bool* record_split = nullptr);
+
+  // Read the next num_rows rows of a non-repeated column, materializing only
+  // the num_selected rows at the increasing positions in selection, relative to
+  // the first of the rows. def_levels receives one level per selected row (set
+  // it to nullptr under the same conditions as for ReadBatch) and values the
+  // values of the selected rows that are not null. The rows in between are
+  // skipped as by Skip, so data pages without a selected row are not decoded.
+  // BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values are copied out of the data pages,
+  // unless dictionary encoded, and are valid as long as those of ReadBatch.
+  //
+  // @returns: the number of selected rows read, less than num_selected only at
+  // the end of the column chunk
+  int64_t ReadSelected(int64_t num_rows, const int32_t* selection,
+      int64_t num_selected, int16_t* def_levels, T* values, int64_t* values_read);
+
+  // Skip data pages whose min/max statistics show that none of their values
+  // match predicate. The values of skipped pages are not returned at all, so
+  // this must be called before reading and the reader no longer returns every
+  // row of the column. Other columns of the row group are not aligned with it
+  // afterwards. Pages without statistics are always read, as are BYTE_ARRAY and
+  // FIXED_LEN_BYTE_ARRAY pages of writers whose statistics may be in signed
+  // byte order (see ColumnChunkMetaData::min_max_ordered) unless min == max.
+  void SetPagePredicate(const RangePredicate<DType>& predicate) {
+    pager_->set_data_page_filter(
+        [predicate](const std::string* min, const std::string* max) {
+          return predicate.MayMatchEncoded(min, max);
+        });
+  }
 
  private:
   typedef Decoder<DType> DecoderType;
@@ -133,6 +325,30 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   // Advance to the next data page
   virtual bool ReadNewPage();
 
+  // ReadBatch without releasing the values retained by earlier calls
+  int64_t ReadBatchRetaining(int32_t batch_size, int16_t* def_levels,
+      int16_t* rep_levels, T* values, int64_t* values_read, int64_t* page_transitions);
+
+  // Copy the bytes that num_values BYTE_ARRAY or FIXED_LEN_BYTE_ARRAY values
+  // point to into retained_values_, and point the values at the copies, before
+  // the current data page is left. Values of other types and those of
+  // dictionary encoded pages, which point into the decoder's dictionary, are
+  // left alone. If valid_bits is not nullptr the values are spaced, and only
+  // those whose bit is set are copied.
+  void RetainValues(T* values, int64_t num_values, const uint8_t* valid_bits = nullptr,
+      int64_t valid_bits_offset = 0);
+
+  // Read up to batch_size levels and values from the current data page
+  //
+  // @returns: the number of levels read
+  int64_t ReadPageBatch(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+      T* values, int64_t* values_read);
+
+  // Spaced version of ReadPageBatch
+  int64_t ReadPageBatchSpaced(int64_t batch_size, int16_t* def_levels,
+      int16_t* rep_levels, T* values, uint8_t* valid_bits, int64_t valid_bits_offset,
+      int64_t* values_read);
+
   // Read up to batch_size values from the current data page into the
   // pre-allocated memory T*
   //
@@ -146,7 +362,26 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   void ConfigureDictionary(const DictionaryPage* page);
 
+  // The selection predicate evaluated on each dictionary entry, computed on
+  // first use
+  const uint8_t* SelectionMask();
+
   DecoderType* current_decoder_;
+
+  ValuePredicate selection_predicate_;
+  std::vector<uint8_t> selection_mask_;
+  bool selection_mask_ready_;
+
+  // Scratch space for ReadBatchSelection
+  std::vector<int16_t> scratch_def_levels_;
+  OwnedMutableBuffer scratch_values_;
+
+  // Repetition levels looked ahead at by ReadRecords, one more than it may read
+  std::vector<int16_t> scratch_rep_levels_;
+
+  // Values copied out of the data pages left by the current read call, released
+  // when the next one begins
+  std::vector<std::shared_ptr<OwnedMutableBuffer>> retained_values_;
 };
 
 template <typename DType>
@@ -157,42 +392,50 @@ inline int64_t TypedColumnReader<DType>::ReadValues(int64_t batch_size, T* out)
 
 template <typename DType>
 inline int64_t TypedColumnReader<DType>::ReadBatch(int batch_size, int16_t* def_levels,
-    int16_t* rep_levels, T* values, int64_t* values_read) {
-  // HasNext invokes ReadNewPage
-  if (!HasNext()) {
-    *values_read = 0;
-    return 0;
-  }
-
-  // TODO(wesm): keep reading data pages until batch_size is reached, or the
-  // row group is finished
-  batch_size = std::min(batch_size, num_buffered_values_);
-
-  int64_t num_def_levels = 0;
-  int64_t num_rep_levels = 0;
-
-  int64_t values_to_read = 0;
+    int16_t* rep_levels, T* values, int64_t* values_read, int64_t* page_transitions) {
+  retained_values_.clear();
+  return ReadBatchRetaining(
+      batch_size, def_levels, rep_levels, values, values_read, page_transitions);
+}
 
-  // If the field is required and non-repeated, there are no definition levels
-  if (descr_->max_definition_level() > 0 && def_levels) {
-    num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
-    // TODO(wesm): this tallying of values-to-decode can be performed with better
-    // cache-efficiency if fused with the level decoding.
-    for (int64_t i = 0; i < num_def_levels; ++i) {
-      if (def_levels[i] == descr_->max_definition_level()) { ++values_to_read; }
+template <typename DType>
+inline int64_t TypedColumnReader<DType>::ReadBatchRetaining(int batch_size,
+    int16_t* def_levels, int16_t* rep_levels, T* values, int64_t* values_read,
+    int64_t* page_transitions) {
+  int64_t total_levels = 0;
+  int64_t page_values_begin = 0;
+  *values_read = 0;
+  if (page_transitions) { *page_transitions = 0; }
+
+  while (total_levels < batch_size) {
+    bool page_exhausted =
+        num_buffered_values_ == 0 || num_decoded_values_ == num_buffered_values_;
+    if (page_exhausted && values && *values_read > page_values_begin) {
+      RetainValues(values + page_values_begin, *values_read - page_values_begin);
+      page_values_begin = *values_read;
     }
-  } else {
-    // Required field, read all values
-    values_to_read = batch_size;
+    // HasNext invokes ReadNewPage
+    if (!HasNext()) { break; }
+    if (page_exhausted && page_transitions) { ++*page_transitions; }
+
+    int64_t page_values_read = 0;
+    int64_t levels_read = ReadPageBatch(batch_size - total_levels,
+        def_levels ? def_levels + total_levels : nullptr,
+        rep_levels ? rep_levels + total_levels : nullptr,
+        values ? values + *values_read : nullptr, &page_values_read);
+    total_levels += levels_read;
+    *values_read += page_values_read;
+    if (levels_read == 0) { break; }
   }
+  return total_levels;
+}
 
-  // Not present for non-repeated fields
-  if (descr_->max_repetition_level() > 0 && rep_levels) {
-    num_rep_levels = ReadRepetitionLevels(batch_size, rep_levels);
-    if (def_levels && num_def_levels != num_rep_levels) {
-      throw ParquetException("Number of decoded rep / def levels did not match");
-    }
-  }
+template <typename DType>
+inline int64_t TypedColumnReader<DType>::ReadPageBatch(int64_t batch_size,
+    int16_t* def_levels, int16_t* rep_levels, T* values, int64_t* values_read) {
+  int64_t values_to_read = 0;
+  int64_t num_def_levels =
+      ReadPageLevels(batch_size, def_levels, rep_levels, &values_to_read);
 
   *values_read = ReadValues(values_to_read, values);
   int64_t total_values = std::max(num_def_levels, *values_read);
@@ -201,6 +444,39 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int batch_size, int16_t* def_
   return total_values;
 }
 
+template <typename DType>
+inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(int32_t batch_size,
+    int16_t* def_levels, int16_t* rep_levels, T* values, uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t* values_read, int64_t* null_count) {
+  retained_values_.clear();
+  int64_t total_levels = 0;
+  int64_t page_levels_begin = 0;
+  *values_read = 0;
+
+  while (total_levels < batch_size) {
+    bool page_exhausted =
+        num_buffered_values_ == 0 || num_decoded_values_ == num_buffered_values_;
+    if (page_exhausted && total_levels > page_levels_begin) {
+      RetainValues(values + page_levels_begin, total_levels - page_levels_begin,
+          valid_bits, valid_bits_offset + page_levels_begin);
+      page_levels_begin = total_levels;
+    }
+    // HasNext invokes ReadNewPage
+    if (!HasNext()) { break; }
+
+    int64_t page_values_read = 0;
+    int64_t levels_read = ReadPageBatchSpaced(batch_size - total_levels,
+        def_levels ? def_levels + total_levels : nullptr,
+        rep_levels ? rep_levels + total_levels : nullptr, values + total_levels,
+        valid_bits, valid_bits_offset + total_levels, &page_values_read);
+    total_levels += levels_read;
+    *values_read += page_values_read;
+    if (levels_read == 0) { break; }
+  }
+  *null_count = total_levels - *values_read;
+  return total_levels;
+}
+
 typedef TypedColumnReader<BooleanType> BoolReader;
 typedef TypedColumnReader<Int32Type> Int32Reader;
 typedef TypedColumnReader<Int64Type> Int64Reader;
@@ -0,0 +1,362 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parquet/column/page.h"
+#include "parquet/column/reader.h"
+#include "parquet/column/record-assembler.h"
+#include "parquet/column/test-specialization.h"
+#include "parquet/column/test-util.h"
+#include "parquet/exception.h"
+#include "parquet/schema/descriptor.h"
+#include "parquet/schema/types.h"
+#include "parquet/types.h"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace parquet {
+
+using schema::GroupNode;
+using schema::NodePtr;
+using schema::NodeVector;
+using schema::PrimitiveNode;
+
+namespace test {
+
+// The records
+//
+//   {id: 1, a: {b: [{x: 1, y: 2}, {x: 3, y: null}]}}
+//   {id: 2, a: null}
+//   {id: 3, a: {b: []}}
+//   {id: 4, a: {b: [{x: 4, y: 5}]}}
+//
+// of the schema
+//
+//   required int32 id;
+//   optional group a {
+//     repeated group b {
+//       required int32 x;
+//       optional int32 y;
+//     }
+//   }
+class TestRecordAssembler : public ::testing::Test {
+ public:
+  void SetUp() {
+    NodeVector b_fields;
+    b_fields.push_back(PrimitiveNode::Make("x", Repetition::REQUIRED, Type::INT32));
+    b_fields.push_back(PrimitiveNode::Make("y", Repetition::OPTIONAL, Type::INT32));
+    NodeVector a_fields;
+    a_fields.push_back(GroupNode::Make("b", Repetition::REPEATED, b_fields));
+    NodeVector fields;
+    fields.push_back(PrimitiveNode::Make("id", Repetition::REQUIRED, Type::INT32));
+    fields.push_back(GroupNode::Make("a", Repetition::OPTIONAL, a_fields));
+    schema_.Init(GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+    columns_.resize(3);
+    columns_[0].values = {1, 2, 3, 4};
+    columns_[1].def_levels = {2, 2, 0, 1, 2};
+    columns_[1].rep_levels = {0, 1, 0, 0, 0};
+    columns_[1].values = {1, 3, 4};
+    columns_[2].def_levels = {3, 2, 0, 1, 3};
+    columns_[2].rep_levels = {0, 1, 0, 0, 0};
+    columns_[2].values = {2, 5};
+  }
+
+  // Pages of levels_per_page levels, the last one possibly shorter
+  vector<shared_ptr<ColumnReader>> MakeReaders(int levels_per_page) {
+    vector<shared_ptr<ColumnReader>> readers;
+    for (int i = 0; i < 3; ++i) {
+      const ColumnDescriptor* descr = schema_.Column(i);
+      const Column& column = columns_[i];
+      int num_levels = static_cast<int>(column.values.size());
+      if (!column.def_levels.empty()) { num_levels = column.def_levels.size(); }
+
+      vector<shared_ptr<Page>> pages;
+      int value = 0;
+      for (int start = 0; start < num_levels; start += levels_per_page) {
+        int end = std::min(num_levels, start + levels_per_page);
+        vector<int16_t> def_levels, rep_levels;
+        if (!column.def_levels.empty()) {
+          def_levels = slice(column.def_levels, start, end);
+          rep_levels = slice(column.rep_levels, start, end);
+        }
+        int num_values = end - start;
+        if (descr->max_definition_level() > 0) {
+          num_values = 0;
+          for (int16_t level : def_levels) {
+            num_values += level == descr->max_definition_level();
+          }
+        }
+        pages.push_back(MakeDataPage<Int32Type>(descr,
+            slice(column.values, value, value + num_values), num_values,
+            Encoding::PLAIN, nullptr, 0, def_levels, descr->max_definition_level(),
+            rep_levels, descr->max_repetition_level()));
+        value += num_values;
+      }
+      std::unique_ptr<PageReader> pager(new MockPageReader(pages));
+      readers.push_back(ColumnReader::Make(descr, std::move(pager)));
+    }
+    return readers;
+  }
+
+  static vector<bool> ValidBits(const AssembledNode& node) {
+    vector<bool> bits;
+    for (int64_t i = 0; i < node.length; ++i) {
+      bits.push_back((node.valid_bits[i / 8] >> (i % 8)) & 1);
+    }
+    return bits;
+  }
+
+  static vector<int32_t> Values(const AssembledNode& node) {
+    const int32_t* values = reinterpret_cast<const int32_t*>(node.values->data());
+    return vector<int32_t>(values, values + node.num_values);
+  }
+
+ protected:
+  struct Column {
+    vector<int16_t> def_levels;
+    vector<int16_t> rep_levels;
+    vector<int32_t> values;
+  };
+
+  SchemaDescriptor schema_;
+  vector<Column> columns_;
+};
+
+TEST_F(TestRecordAssembler, LeafColumns) {
+  const GroupNode* root = schema_.group_node();
+  ASSERT_EQ(vector<int>({0, 1, 2}), RecordAssembler::LeafColumns(&schema_, root));
+  ASSERT_EQ(vector<int>({1, 2}),
+      RecordAssembler::LeafColumns(&schema_, root->field(1).get()));
+  ASSERT_EQ(vector<int>({0}),
+      RecordAssembler::LeafColumns(&schema_, root->field(0).get()));
+}
+
+TEST_F(TestRecordAssembler, AssembleSubtree) {
+  // Records span pages with one level per page
+  for (int levels_per_page : {1, 2, 100}) {
+    vector<shared_ptr<ColumnReader>> readers = MakeReaders(levels_per_page);
+    const schema::Node* a = schema_.group_node()->field(1).get();
+    RecordAssembler assembler(&schema_, a, {readers[1], readers[2]});
+    ASSERT_EQ(4, assembler.num_nodes());
+    ASSERT_EQ(a, assembler.node(0).node);
+    ASSERT_EQ(-1, assembler.node(1).column);
+    ASSERT_EQ(1, assembler.node(2).column);
+    ASSERT_EQ(2, assembler.node(3).column);
+
+    // Records 0 and 1
+    ASSERT_EQ(2, assembler.ReadBatch(2));
+    const AssembledNode& a_node = assembler.node(0);
+    const AssembledNode& b_node = assembler.node(1);
+    const AssembledNode& x_node = assembler.node(2);
+    const AssembledNode& y_node = assembler.node(3);
+    ASSERT_EQ(vector<bool>({true, false}), ValidBits(a_node));
+    ASSERT_EQ(vector<int32_t>({0, 2, 2}), b_node.offsets);
+    ASSERT_EQ(2, x_node.length);
+    ASSERT_TRUE(x_node.valid_bits.empty());
+    ASSERT_EQ(vector<int32_t>({1, 3}), Values(x_node));
+    ASSERT_EQ(vector<bool>({true, false}), ValidBits(y_node));
+    ASSERT_EQ(vector<int32_t>({2}), Values(y_node));
+
+    // Records 2 and 3
+    ASSERT_EQ(2, assembler.ReadBatch(10)) << levels_per_page;
+    ASSERT_EQ(vector<bool>({true, true}), ValidBits(a_node));
+    ASSERT_EQ(vector<int32_t>({0, 0, 1}), b_node.offsets);
+    ASSERT_EQ(vector<int32_t>({4}), Values(x_node));
+    ASSERT_EQ(vector<bool>({true}), ValidBits(y_node));
+    ASSERT_EQ(vector<int32_t>({5}), Values(y_node));
+
+    ASSERT_EQ(0, assembler.ReadBatch(10));
+    ASSERT_EQ(0, a_node.length);
+    ASSERT_EQ(vector<int32_t>({0}), b_node.offsets);
+  }
+}
+
+TEST_F(TestRecordAssembler, AssembleRoot) {
+  vector<shared_ptr<ColumnReader>> readers = MakeReaders(3);
+  RecordAssembler assembler(&schema_, schema_.group_node(), readers);
+  ASSERT_EQ(6, assembler.num_nodes());
+  ASSERT_EQ(4, assembler.ReadBatch(4));
+  ASSERT_EQ(4, assembler.node(0).length);
+  ASSERT_EQ(vector<int32_t>({1, 2, 3, 4}), Values(assembler.node(1)));
+  ASSERT_EQ(vector<bool>({true, false, true, true}), ValidBits(assembler.node(2)));
+  ASSERT_EQ(vector<int32_t>({0, 2, 2, 2, 3}), assembler.node(3).offsets);
+  ASSERT_EQ(vector<bool>({true, false, true}), ValidBits(assembler.node(5)));
+}
+
+TEST_F(TestRecordAssembler, ReadRecords) {
+  vector<shared_ptr<ColumnReader>> readers = MakeReaders(2);
+  Int32Reader* reader = static_cast<Int32Reader*>(readers[2].get());
+  vector<int16_t> def_levels(5);
+  vector<int16_t> rep_levels(5);
+  vector<int32_t> values(5);
+  int64_t levels_read = 0;
+  int64_t values_read = 0;
+
+  // The first record spans two levels
+  ASSERT_EQ(1, reader->ReadRecords(1, 5, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read));
+  ASSERT_EQ(2, levels_read);
+  ASSERT_EQ(1, values_read);
+  ASSERT_EQ(2, values[0]);
+
+  // Two records of one level each fill the limit exactly
+  ASSERT_EQ(2, reader->ReadRecords(10, 2, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read));
+  ASSERT_EQ(2, levels_read);
+  ASSERT_EQ(0, values_read);
+  ASSERT_EQ(1, reader->ReadRecords(10, 5, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read));
+  ASSERT_EQ(1, levels_read);
+  ASSERT_EQ(1, values_read);
+  ASSERT_EQ(5, values[0]);
+}
+
+TEST_F(TestRecordAssembler, ReadRecordsSplit) {
+  vector<shared_ptr<ColumnReader>> readers = MakeReaders(100);
+  Int32Reader* reader = static_cast<Int32Reader*>(readers[2].get());
+  vector<int16_t> def_levels(5);
+  vector<int16_t> rep_levels(5);
+  vector<int32_t> values(5);
+  int64_t levels_read = 0;
+  int64_t values_read = 0;
+  bool record_split = false;
+
+  // A record with more levels than the limit is split and finished by the next
+  // call, which does not count it again
+  ASSERT_EQ(1, reader->ReadRecords(10, 1, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read, &record_split));
+  ASSERT_EQ(1, levels_read);
+  ASSERT_TRUE(record_split);
+  ASSERT_EQ(0, reader->ReadRecords(0, 5, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read, &record_split));
+  ASSERT_EQ(1, levels_read);
+  ASSERT_EQ(0, values_read);
+  ASSERT_FALSE(record_split);
+  ASSERT_EQ(0, reader->ReadRecords(0, 5, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read, &record_split));
+  ASSERT_EQ(0, levels_read);
+  ASSERT_FALSE(record_split);
+}
+
+TEST_F(TestRecordAssembler, ReadRecordsSplitAcrossPages) {
+  // One level per page, so the limit falls on the end of the first page of
+  // the first record, which goes on in the next one
+  vector<shared_ptr<ColumnReader>> readers = MakeReaders(1);
+  Int32Reader* reader = static_cast<Int32Reader*>(readers[2].get());
+  vector<int16_t> def_levels(5);
+  vector<int16_t> rep_levels(5);
+  vector<int32_t> values(5);
+  int64_t levels_read = 0;
+  int64_t values_read = 0;
+  bool record_split = false;
+
+  ASSERT_EQ(1, reader->ReadRecords(10, 1, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read, &record_split));
+  ASSERT_EQ(1, levels_read);
+  ASSERT_EQ(2, values[0]);
+  ASSERT_TRUE(record_split);
+  ASSERT_EQ(0, reader->ReadRecords(0, 5, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read, &record_split));
+  ASSERT_EQ(1, levels_read);
+  ASSERT_EQ(0, values_read);
+  ASSERT_FALSE(record_split);
+
+  // The next record is whole, although the limit falls on the end of its page
+  ASSERT_EQ(1, reader->ReadRecords(10, 1, def_levels.data(), rep_levels.data(),
+                   values.data(), &levels_read, &values_read, &record_split));
+  ASSERT_EQ(1, levels_read);
+  ASSERT_FALSE(record_split);
+}
+
+TEST_F(TestRecordAssembler, ByteArrayValues) {
+  // A batch read with several calls to ReadRecords, from data pages whose
+  // memory is reused
+  SchemaDescriptor schema;
+  schema.Init(GroupNode::Make("schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("s", Repetition::REQUIRED, Type::BYTE_ARRAY)}));
+  const ColumnDescriptor* descr = schema.Column(0);
+  vector<int16_t> def_levels, rep_levels;
+  vector<ByteArray> values;
+  vector<uint8_t> buffer;
+  vector<shared_ptr<Page>> pages;
+  int num_values = MakePages<ByteArrayType>(
+      descr, 25, 100, def_levels, rep_levels, values, buffer, pages);
+  MockPageReader* pager = new MockPageReader(pages);
+  pager->reuse_page_buffer();
+  shared_ptr<ColumnReader> reader =
+      ColumnReader::Make(descr, std::unique_ptr<PageReader>(pager));
+
+  RecordAssembler assembler(&schema, schema.Column(0)->schema_node().get(), {reader});
+  ASSERT_EQ(num_values, assembler.ReadBatch(num_values));
+  const AssembledNode& node = assembler.node(0);
+  ASSERT_EQ(num_values, node.num_values);
+  const ByteArray* result = reinterpret_cast<const ByteArray*>(node.values->data());
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ(values[i], result[i]) << i;
+  }
+}
+
+TEST_F(TestRecordAssembler, ReadRecordsByteArrayPages) {
+  // Records of a repeated column read across data pages whose memory is reused
+  SchemaDescriptor schema;
+  schema.Init(GroupNode::Make("schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("s", Repetition::REPEATED, Type::BYTE_ARRAY)}));
+  const ColumnDescriptor* descr = schema.Column(0);
+  vector<int16_t> def_levels, rep_levels;
+  vector<ByteArray> values;
+  vector<uint8_t> buffer;
+  vector<shared_ptr<Page>> pages;
+  int num_levels = 6 * 50;
+  int num_values = MakePages<ByteArrayType>(
+      descr, 6, 50, def_levels, rep_levels, values, buffer, pages);
+  MockPageReader* pager = new MockPageReader(pages);
+  pager->reuse_page_buffer();
+  shared_ptr<ColumnReader> column_reader =
+      ColumnReader::Make(descr, std::unique_ptr<PageReader>(pager));
+  ByteArrayReader* reader = static_cast<ByteArrayReader*>(column_reader.get());
+
+  vector<int16_t> def_result(num_levels);
+  vector<int16_t> rep_result(num_levels);
+  vector<ByteArray> result(num_values);
+  int64_t levels_read = 0;
+  int64_t values_read = 0;
+  reader->ReadRecords(num_levels, num_levels, def_result.data(), rep_result.data(),
+      result.data(), &levels_read, &values_read);
+  ASSERT_EQ(num_levels, levels_read);
+  ASSERT_EQ(num_values, values_read);
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ(values[i], result[i]) << i;
+  }
+}
+
+TEST_F(TestRecordAssembler, Invalid) {
+  vector<shared_ptr<ColumnReader>> readers = MakeReaders(2);
+  const schema::Node* a = schema_.group_node()->field(1).get();
+  ASSERT_THROW(RecordAssembler(&schema_, a, {readers[1]}), ParquetException);
+  ASSERT_THROW(RecordAssembler(&schema_, a, {readers[0], readers[2]}), ParquetException);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,298 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/column/record-assembler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "parquet/exception.h"
+
+namespace parquet {
+
+// The maximum definition and repetition levels of node: the number of its
+// non-required and repeated ancestors, itself included and the schema root not
+static void GetNodeLevels(const schema::Node* node, int16_t* def_level,
+    int16_t* rep_level) {
+  *def_level = 0;
+  *rep_level = 0;
+  for (; node != nullptr && node->parent() != nullptr; node = node->parent()) {
+    if (!node->is_required()) { ++*def_level; }
+    if (node->is_repeated()) { ++*rep_level; }
+  }
+}
+
+// Copy the bytes that BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values point to into a
+// new buffer appended to value_data, and point the values at the copies. Values
+// of other types are left alone
+template <typename T>
+static void CopyValueBytes(T* values, int64_t num_values, int type_length,
+    MemoryAllocator* allocator,
+    std::vector<std::shared_ptr<OwnedMutableBuffer>>* value_data) {}
+
+static void CopyValueBytes(ByteArray* values, int64_t num_values, int type_length,
+    MemoryAllocator* allocator,
+    std::vector<std::shared_ptr<OwnedMutableBuffer>>* value_data) {
+  int64_t num_bytes = 0;
+  for (int64_t i = 0; i < num_values; ++i) {
+    num_bytes += values[i].len;
+  }
+  if (num_bytes == 0) { return; }
+  auto copy = std::make_shared<OwnedMutableBuffer>(num_bytes, allocator);
+  uint8_t* out = copy->mutable_data();
+  for (int64_t i = 0; i < num_values; ++i) {
+    memcpy(out, values[i].ptr, values[i].len);
+    values[i].ptr = out;
+    out += values[i].len;
+  }
+  value_data->push_back(copy);
+}
+
+static void CopyValueBytes(FixedLenByteArray* values, int64_t num_values,
+    int type_length, MemoryAllocator* allocator,
+    std::vector<std::shared_ptr<OwnedMutableBuffer>>* value_data) {
+  if (num_values == 0) { return; }
+  auto copy = std::make_shared<OwnedMutableBuffer>(num_values * type_length, allocator);
+  uint8_t* out = copy->mutable_data();
+  for (int64_t i = 0; i < num_values; ++i) {
+    memcpy(out, values[i].ptr, type_length);
+    values[i].ptr = out;
+    out += type_length;
+  }
+  value_data->push_back(copy);
+}
+
+template <typename DType>
+static int64_t ReadLeafRecords(ColumnReader* reader, int64_t num_records,
+    std::vector<int16_t>* def_levels, std::vector<int16_t>* rep_levels,
+    AssembledNode* node, int64_t* num_levels, MemoryAllocator* allocator) {
+  typedef typename DType::c_type T;
+  auto typed_reader = static_cast<TypedColumnReader<DType>*>(reader);
+  OwnedMutableBuffer* values = node->values.get();
+  int64_t* num_values = &node->num_values;
+  int type_length = reader->descr()->type_length();
+
+  int64_t records_read = 0;
+  int64_t max_levels = 0;
+  int64_t levels_read = 0;
+  *num_levels = 0;
+  *num_values = 0;
+  node->value_data.clear();
+  bool grow = def_levels->empty();
+  do {
+    if (grow) {
+      // Levels the column does not have are never written and stay zero
+      size_t capacity = std::max<size_t>(1024, 2 * def_levels->size());
+      def_levels->resize(capacity, 0);
+      rep_levels->resize(capacity, 0);
+      values->Resize(capacity * sizeof(T));
+    }
+    max_levels = def_levels->size() - *num_levels;
+    int64_t values_read = 0;
+    bool record_split = false;
+    T* batch_values = reinterpret_cast<T*>(values->mutable_data()) + *num_values;
+    records_read += typed_reader->ReadRecords(num_records - records_read, max_levels,
+        def_levels->data() + *num_levels, rep_levels->data() + *num_levels,
+        batch_values, &levels_read, &values_read, &record_split);
+    // The reader only keeps them valid until it is read from again
+    CopyValueBytes(batch_values, values_read, type_length, allocator, &node->value_data);
+    *num_levels += levels_read;
+    *num_values += values_read;
+    // A full buffer may end within a record, and reading stops in front of a
+    // record that does not fit
+    grow = record_split || (records_read < num_records && typed_reader->HasNext());
+  } while (grow);
+  return records_read;
+}
+
+RecordAssembler::RecordAssembler(const SchemaDescriptor* schema,
+    const schema::Node* node, const std::vector<std::shared_ptr<ColumnReader>>& readers,
+    MemoryAllocator* allocator)
+    : allocator_(allocator) {
+  std::vector<int> columns = LeafColumns(schema, node);
+  if (columns.empty()) { throw ParquetException("Node is not part of the schema"); }
+  if (readers.size() != columns.size()) {
+    throw ParquetException("Expected one column reader per leaf of the node");
+  }
+  for (size_t i = 0; i < readers.size(); ++i) {
+    Leaf leaf;
+    leaf.reader = readers[i];
+    leaf.node = -1;
+    leaf.num_levels = 0;
+    leaves_.push_back(leaf);
+  }
+  int num_leaves = 0;
+  AddNode(node, columns, &num_leaves);
+}
+
+std::vector<int> RecordAssembler::LeafColumns(
+    const SchemaDescriptor* schema, const schema::Node* node) {
+  std::vector<int> columns;
+  for (int i = 0; i < schema->num_columns(); ++i) {
+    const schema::Node* ancestor = schema->Column(i)->schema_node().get();
+    for (; ancestor != nullptr; ancestor = ancestor->parent()) {
+      if (ancestor == node) {
+        columns.push_back(i);
+        break;
+      }
+    }
+  }
+  return columns;
+}
+
+void RecordAssembler::AddNode(
+    const schema::Node* node, const std::vector<int>& columns, int* num_leaves) {
+  // The slots of a node begin with the elements of its nearest repeated ancestor
+  const schema::Node* repeated = node->parent();
+  while (repeated != nullptr && !repeated->is_repeated()) {
+    repeated = repeated->parent();
+  }
+
+  NodeLevels levels;
+  levels.leaf = *num_leaves;
+  GetNodeLevels(node, &levels.def_level, &levels.rep_level);
+  GetNodeLevels(repeated, &levels.slot_def_level, &levels.slot_rep_level);
+
+  AssembledNode assembled;
+  assembled.node = node;
+  assembled.column = -1;
+  assembled.length = 0;
+  assembled.num_values = 0;
+
+  int index = num_nodes();
+  if (node->is_primitive()) {
+    assembled.column = columns[*num_leaves];
+    assembled.values = std::make_shared<OwnedMutableBuffer>(0, allocator_);
+    const ColumnDescriptor* descr = leaves_[*num_leaves].reader->descr();
+    if (descr->physical_type() !=
+            static_cast<const schema::PrimitiveNode*>(node)->physical_type() ||
+        descr->max_definition_level() != levels.def_level ||
+        descr->max_repetition_level() != levels.rep_level) {
+      throw ParquetException("Column levels do not match the schema");
+    }
+    leaves_[(*num_leaves)++].node = index;
+  }
+  nodes_.push_back(assembled);
+  levels_.push_back(levels);
+
+  if (node->is_group()) {
+    auto group = static_cast<const schema::GroupNode*>(node);
+    if (group->field_count() == 0) { throw ParquetException("Group has no fields"); }
+    for (int i = 0; i < group->field_count(); ++i) {
+      AddNode(group->field(i).get(), columns, num_leaves);
+    }
+  }
+}
+
+int64_t RecordAssembler::ReadLeaf(int i, int64_t num_records) {
+  Leaf& leaf = leaves_[i];
+  AssembledNode& node = nodes_[leaf.node];
+  ColumnReader* reader = leaf.reader.get();
+  std::vector<int16_t>* def_levels = &leaf.def_levels;
+  std::vector<int16_t>* rep_levels = &leaf.rep_levels;
+  int64_t* num_levels = &leaf.num_levels;
+
+  switch (reader->type()) {
+    case Type::BOOLEAN:
+      return ReadLeafRecords<BooleanType>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    case Type::INT32:
+      return ReadLeafRecords<Int32Type>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    case Type::INT64:
+      return ReadLeafRecords<Int64Type>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    case Type::INT96:
+      return ReadLeafRecords<Int96Type>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    case Type::FLOAT:
+      return ReadLeafRecords<FloatType>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    case Type::DOUBLE:
+      return ReadLeafRecords<DoubleType>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    case Type::BYTE_ARRAY:
+      return ReadLeafRecords<ByteArrayType>(reader, num_records, def_levels,
+          rep_levels, &node, num_levels, allocator_);
+    case Type::FIXED_LEN_BYTE_ARRAY:
+      return ReadLeafRecords<FLBAType>(reader, num_records, def_levels, rep_levels,
+          &node, num_levels, allocator_);
+    default:
+      ParquetException::NYI("type reader not implemented");
+  }
+  // Unreachable code, but supress compiler warning
+  return 0;
+}
+
+void RecordAssembler::AssembleNode(int i) {
+  AssembledNode& node = nodes_[i];
+  const NodeLevels& levels = levels_[i];
+  const Leaf& leaf = leaves_[levels.leaf];
+  const int16_t* def_levels = leaf.def_levels.data();
+  const int16_t* rep_levels = leaf.rep_levels.data();
+
+  node.length = 0;
+  node.valid_bits.clear();
+  node.offsets.clear();
+  if (node.node->is_repeated()) {
+    int32_t num_elements = 0;
+    for (int64_t j = 0; j < leaf.num_levels; ++j) {
+      if (rep_levels[j] <= levels.slot_rep_level &&
+          def_levels[j] >= levels.slot_def_level) {
+        node.offsets.push_back(num_elements);
+      }
+      if (rep_levels[j] <= levels.rep_level && def_levels[j] >= levels.def_level) {
+        ++num_elements;
+      }
+    }
+    node.length = node.offsets.size();
+    node.offsets.push_back(num_elements);
+    return;
+  }
+
+  bool optional = node.node->is_optional();
+  for (int64_t j = 0; j < leaf.num_levels; ++j) {
+    if (rep_levels[j] > levels.slot_rep_level || def_levels[j] < levels.slot_def_level) {
+      continue;
+    }
+    if (optional) {
+      if (node.length % 8 == 0) { node.valid_bits.push_back(0); }
+      if (def_levels[j] >= levels.def_level) {
+        node.valid_bits.back() |= static_cast<uint8_t>(1 << (node.length % 8));
+      }
+    }
+    ++node.length;
+  }
+}
+
+int64_t RecordAssembler::ReadBatch(int64_t num_records) {
+  int64_t records_read = ReadLeaf(0, num_records);
+  for (int i = 1; i < static_cast<int>(leaves_.size()); ++i) {
+    if (ReadLeaf(i, records_read) != records_read) {
+      throw ParquetException("Leaf columns have different numbers of records");
+    }
+  }
+  for (int i = 0; i < num_nodes(); ++i) {
+    AssembleNode(i);
+  }
+  return records_read;
+}
+
+}  // namespace parquet
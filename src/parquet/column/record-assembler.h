@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_COLUMN_RECORD_ASSEMBLER_H
+#define PARQUET_COLUMN_RECORD_ASSEMBLER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parquet/column/reader.h"
+#include "parquet/schema/descriptor.h"
+#include "parquet/schema/types.h"
+#include "parquet/util/buffer.h"
+#include "parquet/util/mem-allocator.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// A node of an assembled batch of records, in the columnar layout of nested
+// arrays: every node has one slot per slot of its parent, or per element if
+// its parent is repeated. The slots of the subtree root are its records, or
+// the elements of its nearest repeated ancestor if it has one.
+struct PARQUET_EXPORT AssembledNode {
+  const schema::Node* node;
+
+  // Index of the column of a leaf node, -1 for a group
+  int column;
+
+  // Number of slots in the batch
+  int64_t length;
+
+  // Optional nodes only: bit i (LSB first) is set if slot i is not null. Slots
+  // whose parent is null are null as well
+  std::vector<uint8_t> valid_bits;
+
+  // Repeated nodes only: slot i holds the elements offsets[i] up to
+  // offsets[i + 1], which are the slots of the node's children, or its values
+  // if it is a leaf. An empty list has no elements
+  std::vector<int32_t> offsets;
+
+  // Leaf nodes only: the num_values values of the leaf's defined slots (or
+  // elements), one c_type of the column's physical type each. BYTE_ARRAY and
+  // FIXED_LEN_BYTE_ARRAY values point into value_data, which holds copies of
+  // their bytes until the next batch is read
+  std::shared_ptr<OwnedMutableBuffer> values;
+  int64_t num_values;
+  std::vector<std::shared_ptr<OwnedMutableBuffer>> value_data;
+};
+
+// Reassembles the nested records of a GroupNode subtree from the repetition and
+// definition levels of its leaf columns (the Dremel record assembly), a batch
+// of records at a time. The leaf columns are read record-aligned with
+// TypedColumnReader::ReadRecords, and each node of the subtree is assembled
+// from the levels of the first leaf below it in one pass over the batch.
+class PARQUET_EXPORT RecordAssembler {
+ public:
+  // node is a node of schema, and readers read its leaf columns in the order of
+  // LeafColumns(schema, node)
+  RecordAssembler(const SchemaDescriptor* schema, const schema::Node* node,
+      const std::vector<std::shared_ptr<ColumnReader>>& readers,
+      MemoryAllocator* allocator = default_allocator());
+
+  // The indices of the leaf columns below node, in schema order
+  static std::vector<int> LeafColumns(
+      const SchemaDescriptor* schema, const schema::Node* node);
+
+  // Read and assemble the next batch of up to num_records records
+  //
+  // @returns: the number of records assembled, 0 at the end of the row group
+  int64_t ReadBatch(int64_t num_records);
+
+  // The nodes of the subtree in pre-order, starting with its root
+  int num_nodes() const { return static_cast<int>(nodes_.size()); }
+  const AssembledNode& node(int i) const { return nodes_[i]; }
+
+ private:
+  struct Leaf {
+    std::shared_ptr<ColumnReader> reader;
+    // Index of the leaf's node
+    int node;
+    // The levels of the current batch
+    std::vector<int16_t> def_levels;
+    std::vector<int16_t> rep_levels;
+    int64_t num_levels;
+  };
+
+  // Where the slots of a node begin, and the leaf they are assembled from
+  struct NodeLevels {
+    int leaf;
+    int16_t def_level;
+    int16_t rep_level;
+    int16_t slot_def_level;
+    int16_t slot_rep_level;
+  };
+
+  void AddNode(
+      const schema::Node* node, const std::vector<int>& columns, int* num_leaves);
+
+  // Read num_records records of leaf i into its levels and values
+  //
+  // @returns: the number of records read
+  int64_t ReadLeaf(int i, int64_t num_records);
+
+  void AssembleNode(int i);
+
+  std::vector<AssembledNode> nodes_;
+  std::vector<NodeLevels> levels_;
+  std::vector<Leaf> leaves_;
+  MemoryAllocator* allocator_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_COLUMN_RECORD_ASSEMBLER_H
@@ -84,6 +84,80 @@ class TestFlatScanner : public ::testing::Test {
     ASSERT_FALSE(scanner->Next(&val, &def_level, &rep_level, &is_null));
   }
 
+  // Collects the batches of a column of type Type. Values are compared with
+  // the expected ones as they arrive, since BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY
+  // values are only valid until the next batch is read
+  struct BatchCollector {
+    explicit BatchCollector(const vector<T>* expected)
+        : expected(expected), num_batches(0) {}
+
+    void AddValue(const T& value) {
+      size_t i = value_matches.size();
+      value_matches.push_back(i < expected->size() && (*expected)[i] == value);
+    }
+
+    void Visit(const ScanBatch<Type>& batch) {
+      for (int64_t i = 0; i < batch.num_levels; ++i) {
+        def_levels.push_back(batch.def_levels ? batch.def_levels[i] : 0);
+        rep_levels.push_back(batch.rep_levels ? batch.rep_levels[i] : 0);
+        valid.push_back(!batch.valid_bits || ((batch.valid_bits[i / 8] >> (i % 8)) & 1));
+      }
+      for (int64_t i = 0; i < batch.num_values; ++i) {
+        AddValue(batch.values[i]);
+      }
+      ++num_batches;
+    }
+
+    template <typename DType>
+    void Visit(const ScanBatch<DType>& batch) {
+      throw ParquetException("Unexpected type");
+    }
+
+    vector<int16_t> def_levels;
+    vector<int16_t> rep_levels;
+    vector<bool> valid;
+    const vector<T>* expected;
+    vector<bool> value_matches;
+    int num_batches;
+  };
+
+  // Reads the first levels with Next and the rest with VisitBatches
+  void CheckBatches(int batch_size, const ColumnDescriptor* d) {
+    TypedScanner<Type>* scanner = static_cast<TypedScanner<Type>*>(scanner_.get());
+    scanner->SetBatchSize(batch_size);
+    BatchCollector collector(&values_);
+    T val;
+    bool is_null = false;
+    int16_t def_level = 0;
+    int16_t rep_level = 0;
+    int num_next = 3;
+    for (int i = 0; i < num_next; ++i) {
+      ASSERT_TRUE(scanner->Next(&val, &def_level, &rep_level, &is_null));
+      collector.def_levels.push_back(def_level);
+      collector.rep_levels.push_back(rep_level);
+      collector.valid.push_back(!is_null);
+      if (!is_null) { collector.AddValue(val); }
+    }
+    VisitBatches(scanner_.get(), &collector);
+
+    ASSERT_EQ(1 + (num_levels_ - 1) / batch_size, collector.num_batches);
+    ASSERT_EQ(num_levels_, collector.valid.size());
+    ASSERT_EQ(num_values_, collector.value_matches.size());
+    for (int i = 0; i < num_values_; ++i) {
+      ASSERT_TRUE(collector.value_matches[i]) << i;
+    }
+    for (int i = 0; i < num_levels_; ++i) {
+      int16_t def_level = d->max_definition_level() > 0 ? def_levels_[i] : 0;
+      ASSERT_EQ(def_level, collector.def_levels[i]) << i;
+      ASSERT_EQ(def_level == d->max_definition_level(), collector.valid[i]) << i;
+      if (d->max_repetition_level() > 0) {
+        ASSERT_EQ(rep_levels_[i], collector.rep_levels[i]) << i;
+      }
+    }
+    ScanBatch<Type> batch;
+    ASSERT_FALSE(scanner->NextBatch(&batch));
+  }
+
   void Clear() {
     pages_.clear();
     values_.clear();
@@ -98,6 +172,8 @@ class TestFlatScanner : public ::testing::Test {
     num_levels_ = num_pages * levels_per_page;
     InitScanner(d);
     CheckResults(batch_size, d);
+    InitScanner(d);
+    CheckBatches(batch_size, d);
     Clear();
   }
 
@@ -194,6 +270,35 @@ TEST_F(TestFlatFLBAScanner, TestSmallBatch) {
   CheckResults(1, &d);
 }
 
+TEST_F(TestFlatFLBAScanner, TestAdaptiveBatchSize) {
+  std::shared_ptr<ColumnDescriptor> d1;
+  std::shared_ptr<ColumnDescriptor> d2;
+  std::shared_ptr<ColumnDescriptor> d3;
+  InitDescriptors(d1, d2, d3, FLBA_LENGTH);
+  ASSERT_EQ(DEFAULT_SCANNER_BATCH_SIZE, Scanner::AdaptiveBatchSize(d1.get()));
+  ASSERT_EQ(DEFAULT_SCANNER_BATCH_SIZE, Scanner::AdaptiveBatchSize(d3.get()));
+
+  num_values_ = MakePages<FLBAType>(
+      d1.get(), 1, 100, def_levels_, rep_levels_, values_, data_buffer_, pages_);
+  InitScanner(d1.get());
+  ASSERT_EQ(DEFAULT_SCANNER_BATCH_SIZE, scanner_->batch_size());
+
+  // Fixed width values are sized from the cache
+  const ColumnDescriptor int_required(schema::Int64("a", Repetition::REQUIRED), 0, 0);
+  const ColumnDescriptor int_repeated(schema::Int64("a", Repetition::REPEATED), 1, 1);
+  int64_t required = Scanner::AdaptiveBatchSize(&int_required);
+  int64_t repeated = Scanner::AdaptiveBatchSize(&int_repeated);
+  ASSERT_LE(DEFAULT_SCANNER_BATCH_SIZE, repeated);
+  ASSERT_LE(repeated, required);
+
+  // Scanners only size their batches from the cache when asked to
+  std::shared_ptr<ColumnReader> reader = ColumnReader::Make(&int_required,
+      std::unique_ptr<PageReader>(new test::MockPageReader(pages_)));
+  ASSERT_EQ(DEFAULT_SCANNER_BATCH_SIZE, Scanner::Make(reader)->batch_size());
+  ASSERT_EQ(required,
+      Scanner::Make(reader, ADAPTIVE_SCANNER_BATCH_SIZE)->batch_size());
+}
+
 TEST_F(TestFlatFLBAScanner, TestDescriptorAPI) {
   NodePtr type = schema::PrimitiveNode::Make("c1", Repetition::OPTIONAL,
       Type::FIXED_LEN_BYTE_ARRAY, LogicalType::DECIMAL, FLBA_LENGTH, 10, 2);
@@ -17,10 +17,13 @@
 
 #include "parquet/column/scanner.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 #include "parquet/column/reader.h"
+#include "parquet/util/cpu-info.h"
 
 namespace parquet {
 
@@ -51,4 +54,22 @@ std::shared_ptr<Scanner> Scanner::Make(std::shared_ptr<ColumnReader> col_reader,
   return std::shared_ptr<Scanner>(nullptr);
 }
 
+int64_t Scanner::AdaptiveBatchSize(const ColumnDescriptor* descr) {
+  if (descr->physical_type() == Type::BYTE_ARRAY ||
+      descr->physical_type() == Type::FIXED_LEN_BYTE_ARRAY) {
+    // The slots only hold pointers to the values' bytes
+    return DEFAULT_SCANNER_BATCH_SIZE;
+  }
+  // Scanners may be made on several threads at once
+  static std::once_flag cpu_info_initialized;
+  std::call_once(cpu_info_initialized, []() {
+    if (!CpuInfo::initialized()) { CpuInfo::Init(); }
+  });
+  int64_t slot_size = GetTypeByteSize(descr->physical_type());
+  if (descr->max_definition_level() > 0) { slot_size += sizeof(int16_t); }
+  if (descr->max_repetition_level() > 0) { slot_size += sizeof(int16_t); }
+  int64_t cache_size = CpuInfo::CacheSize(CpuInfo::L1_CACHE);
+  return std::max(DEFAULT_SCANNER_BATCH_SIZE, cache_size / 2 / slot_size);
+}
+
 }  // namespace parquet
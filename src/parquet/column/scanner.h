@@ -34,14 +34,40 @@
 
 namespace parquet {
 
+// The default batch size of scanners, also the smallest one picked by
+// Scanner::AdaptiveBatchSize
 static constexpr int64_t DEFAULT_SCANNER_BATCH_SIZE = 128;
 
+// As batch size, has the scanner pick one with Scanner::AdaptiveBatchSize
+static constexpr int64_t ADAPTIVE_SCANNER_BATCH_SIZE = 0;
+
+// A batch of levels and values returned by TypedScanner::NextBatch. The arrays
+// remain valid until the scanner reads further.
+//
+// Bit i of valid_bits (LSB first) is set if level i has a value, i.e. its
+// definition level is the column's maximum; the values of those levels are
+// stored in order in values[0, num_values). def_levels (rep_levels) and
+// valid_bits are nullptr if the column has no definition (repetition) levels,
+// in which case every level has a value.
+template <typename DType>
+struct ScanBatch {
+  typedef typename DType::c_type T;
+
+  int64_t num_levels;
+  const int16_t* def_levels;
+  const int16_t* rep_levels;
+  const uint8_t* valid_bits;
+  int64_t num_values;
+  const T* values;
+};
+
 class PARQUET_EXPORT Scanner {
  public:
   explicit Scanner(std::shared_ptr<ColumnReader> reader,
       int64_t batch_size = DEFAULT_SCANNER_BATCH_SIZE,
       MemoryAllocator* allocator = default_allocator())
-      : batch_size_(batch_size),
+      : batch_size_(
+            batch_size > 0 ? batch_size : AdaptiveBatchSize(reader->descr())),
         level_offset_(0),
         levels_buffered_(0),
         value_buffer_(0, allocator),
@@ -58,6 +84,12 @@ class PARQUET_EXPORT Scanner {
       int64_t batch_size = DEFAULT_SCANNER_BATCH_SIZE,
       MemoryAllocator* allocator = default_allocator());
 
+  // Returns a batch size for the column whose levels and values take up about
+  // half of the L1 data cache, and at least DEFAULT_SCANNER_BATCH_SIZE. The
+  // bytes of BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values are not part of their
+  // slots, so these columns keep DEFAULT_SCANNER_BATCH_SIZE
+  static int64_t AdaptiveBatchSize(const ColumnDescriptor* descr);
+
   virtual void PrintNext(std::ostream& out, int width) = 0;
 
   bool HasNext() { return level_offset_ < levels_buffered_ || reader_->HasNext(); }
@@ -73,6 +105,7 @@ class PARQUET_EXPORT Scanner {
 
   std::vector<int16_t> def_levels_;
   std::vector<int16_t> rep_levels_;
+  std::vector<uint8_t> valid_bits_;
   int level_offset_;
   int levels_buffered_;
 
@@ -102,14 +135,7 @@ class PARQUET_EXPORT TypedScanner : public Scanner {
   virtual ~TypedScanner() {}
 
   bool NextLevels(int16_t* def_level, int16_t* rep_level) {
-    if (level_offset_ == levels_buffered_) {
-      levels_buffered_ = typed_reader_->ReadBatch(
-          batch_size_, &def_levels_[0], &rep_levels_[0], values_, &values_buffered_);
-
-      value_offset_ = 0;
-      level_offset_ = 0;
-      if (!levels_buffered_) { return false; }
-    }
+    if (level_offset_ == levels_buffered_ && !ReadBuffer()) { return false; }
     *def_level = descr()->max_definition_level() > 0 ? def_levels_[level_offset_] : 0;
     *rep_level = descr()->max_repetition_level() > 0 ? rep_levels_[level_offset_] : 0;
     level_offset_++;
@@ -160,6 +186,40 @@ class PARQUET_EXPORT TypedScanner : public Scanner {
     return true;
   }
 
+  // Returns the levels and values not yet returned by Next, NextValue or
+  // PrintNext from the current batch, or else reads a new one. Returns false
+  // at the end of the column.
+  bool NextBatch(ScanBatch<DType>* batch) {
+    if (level_offset_ == levels_buffered_ && !ReadBuffer()) { return false; }
+    int16_t max_def_level = descr()->max_definition_level();
+    batch->num_levels = levels_buffered_ - level_offset_;
+    batch->def_levels = max_def_level > 0 ? def_levels_.data() + level_offset_ : nullptr;
+    batch->rep_levels = descr()->max_repetition_level() > 0
+                            ? rep_levels_.data() + level_offset_
+                            : nullptr;
+    batch->valid_bits = nullptr;
+    if (max_def_level > 0) {
+      valid_bits_.resize((batch->num_levels + 7) / 8);
+      LevelsToValidBits(
+          batch->def_levels, batch->num_levels, max_def_level, valid_bits_.data(), 0);
+      batch->valid_bits = valid_bits_.data();
+    }
+    batch->num_values = values_buffered_ - value_offset_;
+    batch->values = values_ + value_offset_;
+    level_offset_ = levels_buffered_;
+    value_offset_ = static_cast<int>(values_buffered_);
+    return true;
+  }
+
+  // Calls visitor->Visit(batch) for each remaining batch of the column
+  template <typename Visitor>
+  void VisitBatches(Visitor* visitor) {
+    ScanBatch<DType> batch;
+    while (NextBatch(&batch)) {
+      visitor->Visit(batch);
+    }
+  }
+
   virtual void PrintNext(std::ostream& out, int width) {
     T val;
     bool is_null = false;
@@ -182,6 +242,15 @@ class PARQUET_EXPORT TypedScanner : public Scanner {
 
   inline void FormatValue(void* val, char* buffer, int bufsize, int width);
 
+  bool ReadBuffer() {
+    levels_buffered_ = static_cast<int>(typed_reader_->ReadBatch(
+        static_cast<int32_t>(batch_size_), def_levels_.data(), rep_levels_.data(),
+        values_, &values_buffered_));
+    value_offset_ = 0;
+    level_offset_ = 0;
+    return levels_buffered_ > 0;
+  }
+
   T* values_;
 };
 
@@ -226,6 +295,36 @@ typedef TypedScanner<DoubleType> DoubleScanner;
 typedef TypedScanner<ByteArrayType> ByteArrayScanner;
 typedef TypedScanner<FLBAType> FixedLenByteArrayScanner;
 
+// Calls visitor->Visit(batch) for each remaining batch of the scanner, with
+// batch a ScanBatch of the column's physical type. Visitor must have a Visit
+// method for each physical type, typically a member template. The type is
+// dispatched once rather than per value, so Visit is compiled for the concrete
+// value type and can loop over the batch without virtual calls or branching on
+// the column's levels.
+template <typename Visitor>
+void VisitBatches(Scanner* scanner, Visitor* visitor) {
+  switch (scanner->descr()->physical_type()) {
+    case Type::BOOLEAN:
+      return static_cast<BoolScanner*>(scanner)->VisitBatches(visitor);
+    case Type::INT32:
+      return static_cast<Int32Scanner*>(scanner)->VisitBatches(visitor);
+    case Type::INT64:
+      return static_cast<Int64Scanner*>(scanner)->VisitBatches(visitor);
+    case Type::INT96:
+      return static_cast<Int96Scanner*>(scanner)->VisitBatches(visitor);
+    case Type::FLOAT:
+      return static_cast<FloatScanner*>(scanner)->VisitBatches(visitor);
+    case Type::DOUBLE:
+      return static_cast<DoubleScanner*>(scanner)->VisitBatches(visitor);
+    case Type::BYTE_ARRAY:
+      return static_cast<ByteArrayScanner*>(scanner)->VisitBatches(visitor);
+    case Type::FIXED_LEN_BYTE_ARRAY:
+      return static_cast<FixedLenByteArrayScanner*>(scanner)->VisitBatches(visitor);
+    default:
+      ParquetException::NYI("type scanner not implemented");
+  }
+}
+
 }  // namespace parquet
 
 #endif  // PARQUET_COLUMN_SCANNER_H
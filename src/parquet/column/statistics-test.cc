@@ -0,0 +1,159 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+
+#include "parquet/column/statistics.h"
+#include "parquet/types.h"
+
+using std::string;
+
+namespace parquet {
+
+namespace test {
+
+TEST(TestStatisticsTraits, Int64RoundTrip) {
+  typedef StatisticsTraits<Int64Type> Traits;
+  string encoded = Traits::Encode(-12345678901LL, -1);
+  ASSERT_EQ(sizeof(int64_t), encoded.size());
+
+  int64_t decoded;
+  ASSERT_TRUE(Traits::Decode(encoded, -1, &decoded));
+  ASSERT_EQ(-12345678901LL, decoded);
+  ASSERT_FALSE(Traits::Decode("abc", -1, &decoded));
+
+  ASSERT_LT(Traits::Compare(-1, 1, -1), 0);
+  ASSERT_GT(Traits::Compare(1, -1, -1), 0);
+  ASSERT_EQ(0, Traits::Compare(7, 7, -1));
+}
+
+TEST(TestStatisticsTraits, ByteArrayOrder) {
+  typedef StatisticsTraits<ByteArrayType> Traits;
+  string a = "abc", ab = "ab", b = "b", high = "\xff";
+  ByteArray va(a.size(), reinterpret_cast<const uint8_t*>(a.data()));
+  ByteArray vab(ab.size(), reinterpret_cast<const uint8_t*>(ab.data()));
+  ByteArray vb(b.size(), reinterpret_cast<const uint8_t*>(b.data()));
+  ByteArray vhigh(high.size(), reinterpret_cast<const uint8_t*>(high.data()));
+
+  // Shorter prefixes sort first, bytes compare unsigned
+  ASSERT_LT(Traits::Compare(vab, va, -1), 0);
+  ASSERT_LT(Traits::Compare(va, vb, -1), 0);
+  ASSERT_LT(Traits::Compare(vb, vhigh, -1), 0);
+  ASSERT_EQ(0, Traits::Compare(va, va, -1));
+
+  ASSERT_EQ(a, Traits::Encode(va, -1));
+  ByteArray decoded;
+  ASSERT_TRUE(Traits::Decode(a, -1, &decoded));
+  ASSERT_EQ(va, decoded);
+}
+
+TEST(TestRangePredicate, Int32) {
+  typedef RangePredicate<Int32Type> Predicate;
+  Predicate between = Predicate::Between(10, 20);
+  ASSERT_FALSE(between.Matches(9));
+  ASSERT_TRUE(between.Matches(10));
+  ASSERT_TRUE(between.Matches(20));
+  ASSERT_FALSE(between.Matches(21));
+
+  ASSERT_FALSE(between.MayMatch(0, 9));
+  ASSERT_TRUE(between.MayMatch(0, 10));
+  ASSERT_TRUE(between.MayMatch(12, 15));
+  ASSERT_TRUE(between.MayMatch(0, 100));
+  ASSERT_TRUE(between.MayMatch(20, 30));
+  ASSERT_FALSE(between.MayMatch(21, 30));
+
+  Predicate at_least = Predicate::AtLeast(5);
+  ASSERT_FALSE(at_least.MayMatch(0, 4));
+  ASSERT_TRUE(at_least.MayMatch(0, 5));
+  ASSERT_TRUE(at_least.Matches(1000000));
+
+  Predicate at_most = Predicate::AtMost(5);
+  ASSERT_TRUE(at_most.MayMatch(-10, 0));
+  ASSERT_FALSE(at_most.MayMatch(6, 10));
+
+  Predicate equal = Predicate::Equal(3);
+  ASSERT_TRUE(equal.Matches(3));
+  ASSERT_FALSE(equal.Matches(4));
+}
+
+TEST(TestRangePredicate, MayMatchEncoded) {
+  typedef StatisticsTraits<Int32Type> Traits;
+  RangePredicate<Int32Type> predicate = RangePredicate<Int32Type>::Between(10, 20);
+
+  string low = Traits::Encode(0, -1), nine = Traits::Encode(9, -1);
+  string fifteen = Traits::Encode(15, -1), high = Traits::Encode(30, -1);
+  ASSERT_FALSE(predicate.MayMatchEncoded(&low, &nine));
+  ASSERT_TRUE(predicate.MayMatchEncoded(&low, &fifteen));
+  ASSERT_TRUE(predicate.MayMatchEncoded(&fifteen, &high));
+  ASSERT_FALSE(predicate.MayMatchEncoded(&high, &high));
+
+  // Missing or malformed statistics cannot rule out a match
+  string malformed = "x";
+  ASSERT_TRUE(predicate.MayMatchEncoded(nullptr, nullptr));
+  ASSERT_TRUE(predicate.MayMatchEncoded(&malformed, &malformed));
+  ASSERT_FALSE(predicate.MayMatchEncoded(nullptr, &nine));
+  ASSERT_FALSE(predicate.MayMatchEncoded(&high, nullptr));
+}
+
+TEST(TestRangePredicate, ByteArray) {
+  string lower = "b", upper = "d";
+  RangePredicate<ByteArrayType> predicate = RangePredicate<ByteArrayType>::Between(
+      ByteArray(lower.size(), reinterpret_cast<const uint8_t*>(lower.data())),
+      ByteArray(upper.size(), reinterpret_cast<const uint8_t*>(upper.data())));
+  // The predicate holds copies of its bounds
+  lower = "z";
+  upper = "z";
+
+  string a = "a", az = "az", ba = "ba", da = "da", e = "e";
+  ASSERT_FALSE(predicate.MayMatchEncoded(&a, &az));
+  ASSERT_TRUE(predicate.MayMatchEncoded(&a, &ba));
+  ASSERT_FALSE(predicate.MayMatchEncoded(&da, &e));
+  ASSERT_TRUE(predicate.Matches(
+      ByteArray(ba.size(), reinterpret_cast<const uint8_t*>(ba.data()))));
+}
+
+TEST(TestRangePredicate, FixedLenByteArray) {
+  string lower = "\x01\x00", upper = "\x80\x00";
+  lower.resize(2);
+  upper.resize(2);
+  RangePredicate<FLBAType> predicate = RangePredicate<FLBAType>::Between(
+      FixedLenByteArray(reinterpret_cast<const uint8_t*>(lower.data())),
+      FixedLenByteArray(reinterpret_cast<const uint8_t*>(upper.data())), 2);
+
+  string zero(2, '\0'), high(2, '\xff'), mid = "\x10\x10";
+  ASSERT_FALSE(predicate.MayMatchEncoded(&zero, &zero));
+  ASSERT_TRUE(predicate.MayMatchEncoded(&zero, &mid));
+  ASSERT_FALSE(predicate.MayMatchEncoded(&high, &high));
+  ASSERT_TRUE(predicate.MayMatchEncoded(&mid, &mid));
+  // Statistics of the wrong length are ignored
+  string wrong = "\x10";
+  ASSERT_TRUE(predicate.MayMatchEncoded(&wrong, &wrong));
+}
+
+TEST(TestRangePredicate, Int96IsUnordered) {
+  Int96 lower = {{0, 0, 1}}, upper = {{0, 0, 2}}, value = {{0, 0, 5}};
+  RangePredicate<Int96Type> predicate = RangePredicate<Int96Type>::Between(lower, upper);
+  ASSERT_TRUE(predicate.MayMatch(value, value));
+  string encoded = StatisticsTraits<Int96Type>::Encode(value, -1);
+  ASSERT_TRUE(predicate.MayMatchEncoded(&encoded, &encoded));
+}
+
+}  // namespace test
+
+}  // namespace parquet
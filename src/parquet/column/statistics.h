@@ -0,0 +1,246 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_COLUMN_STATISTICS_H
+#define PARQUET_COLUMN_STATISTICS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "parquet/types.h"
+
+namespace parquet {
+
+// Parquet statistics store min and max values PLAIN encoded, except that
+// BYTE_ARRAY values have no length prefix. StatisticsTraits converts between
+// such encoded values and the c_type of a physical type, and orders values the
+// way statistics are computed: numerically for numbers and as unsigned bytes
+// for binary data. INT96 values have no defined order. Older writers ordered
+// binary statistics as signed bytes instead, see HasUnsignedBinaryStatistics.
+//
+// type_length is only used for FIXED_LEN_BYTE_ARRAY. Decoded BYTE_ARRAY and
+// FIXED_LEN_BYTE_ARRAY values point into the encoded string.
+template <typename DType>
+struct StatisticsTraits {
+  typedef typename DType::c_type T;
+
+  static constexpr bool is_ordered = true;
+
+  static std::string Encode(const T& value, int type_length) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  // Returns false if the encoded value has the wrong size or is NaN
+  static bool Decode(const std::string& encoded, int type_length, T* out) {
+    if (encoded.size() != sizeof(T)) { return false; }
+    memcpy(out, encoded.data(), sizeof(T));
+    return *out == *out;
+  }
+
+  // Returns a negative number, zero or a positive number as a sorts before,
+  // equal to or after b
+  static int Compare(const T& a, const T& b, int type_length) {
+    return a < b ? -1 : (b < a ? 1 : 0);
+  }
+};
+
+template <>
+struct StatisticsTraits<Int96Type> {
+  typedef Int96 T;
+
+  static constexpr bool is_ordered = false;
+
+  static std::string Encode(const T& value, int type_length) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  static bool Decode(const std::string& encoded, int type_length, T* out) {
+    if (encoded.size() != sizeof(T)) { return false; }
+    memcpy(out, encoded.data(), sizeof(T));
+    return true;
+  }
+
+  static int Compare(const T& a, const T& b, int type_length) { return 0; }
+};
+
+template <>
+struct StatisticsTraits<ByteArrayType> {
+  typedef ByteArray T;
+
+  static constexpr bool is_ordered = true;
+
+  static std::string Encode(const T& value, int type_length) {
+    return std::string(reinterpret_cast<const char*>(value.ptr), value.len);
+  }
+
+  static bool Decode(const std::string& encoded, int type_length, T* out) {
+    *out = ByteArray(static_cast<uint32_t>(encoded.size()),
+        reinterpret_cast<const uint8_t*>(encoded.data()));
+    return true;
+  }
+
+  static int Compare(const T& a, const T& b, int type_length) {
+    int result = memcmp(a.ptr, b.ptr, std::min(a.len, b.len));
+    if (result != 0) { return result; }
+    return a.len < b.len ? -1 : (b.len < a.len ? 1 : 0);
+  }
+};
+
+template <>
+struct StatisticsTraits<FLBAType> {
+  typedef FixedLenByteArray T;
+
+  static constexpr bool is_ordered = true;
+
+  static std::string Encode(const T& value, int type_length) {
+    return std::string(reinterpret_cast<const char*>(value.ptr), type_length);
+  }
+
+  static bool Decode(const std::string& encoded, int type_length, T* out) {
+    if (static_cast<int>(encoded.size()) != type_length) { return false; }
+    *out = FixedLenByteArray(reinterpret_cast<const uint8_t*>(encoded.data()));
+    return true;
+  }
+
+  static int Compare(const T& a, const T& b, int type_length) {
+    return memcmp(a.ptr, b.ptr, type_length);
+  }
+};
+
+// A predicate selecting the values of a column within an inclusive range, each
+// end of which may be open. Its bounds are kept encoded like statistics, so a
+// predicate on BYTE_ARRAY or FIXED_LEN_BYTE_ARRAY values does not reference the
+// memory it was created from.
+template <typename DType>
+class RangePredicate {
+ public:
+  typedef typename DType::c_type T;
+  typedef StatisticsTraits<DType> Traits;
+
+  // Matches values v with lower <= v <= upper
+  static RangePredicate Between(const T& lower, const T& upper, int type_length = -1) {
+    return RangePredicate(true, Traits::Encode(lower, type_length), true,
+        Traits::Encode(upper, type_length), type_length);
+  }
+
+  static RangePredicate Equal(const T& value, int type_length = -1) {
+    return Between(value, value, type_length);
+  }
+
+  static RangePredicate AtLeast(const T& lower, int type_length = -1) {
+    return RangePredicate(
+        true, Traits::Encode(lower, type_length), false, "", type_length);
+  }
+
+  static RangePredicate AtMost(const T& upper, int type_length = -1) {
+    return RangePredicate(
+        false, "", true, Traits::Encode(upper, type_length), type_length);
+  }
+
+  bool Matches(const T& value) const { return !BelowLower(value) && !AboveUpper(value); }
+
+  // Returns false if no value between min and max can match
+  bool MayMatch(const T& min, const T& max) const {
+    if (!Traits::is_ordered) { return true; }
+    return !BelowLower(max) && !AboveUpper(min);
+  }
+
+  // Like MayMatch for encoded statistics, either of which may be nullptr if it
+  // is not known. Statistics which cannot be decoded are ignored.
+  bool MayMatchEncoded(const std::string* min, const std::string* max) const {
+    if (!Traits::is_ordered) { return true; }
+    T value;
+    if (max != nullptr && Traits::Decode(*max, type_length_, &value) &&
+        BelowLower(value)) {
+      return false;
+    }
+    if (min != nullptr && Traits::Decode(*min, type_length_, &value) &&
+        AboveUpper(value)) {
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  RangePredicate(bool has_lower, const std::string& lower, bool has_upper,
+      const std::string& upper, int type_length)
+      : has_lower_(has_lower),
+        lower_(lower),
+        has_upper_(has_upper),
+        upper_(upper),
+        type_length_(type_length) {}
+
+  bool BelowLower(const T& value) const {
+    T bound;
+    return has_lower_ && Traits::Decode(lower_, type_length_, &bound) &&
+           Traits::Compare(value, bound, type_length_) < 0;
+  }
+
+  bool AboveUpper(const T& value) const {
+    T bound;
+    return has_upper_ && Traits::Decode(upper_, type_length_, &bound) &&
+           Traits::Compare(bound, value, type_length_) < 0;
+  }
+
+  bool has_lower_;
+  std::string lower_;
+  bool has_upper_;
+  std::string upper_;
+  int type_length_;
+};
+
+// The statistics of a column chunk decoded for its physical type. min() and
+// max() are only valid if has_min_max(); statistics which are not set or cannot
+// be decoded are treated as unknown. BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values
+// point into the encoded statistics.
+template <typename DType>
+class TypedStatistics {
+ public:
+  typedef typename DType::c_type T;
+  typedef StatisticsTraits<DType> Traits;
+
+  // min and max may be nullptr if not set, null_count is negative if unknown
+  TypedStatistics(const std::string* min, const std::string* max, int64_t null_count,
+      int type_length)
+      : has_min_max_(false), null_count_(null_count), type_length_(type_length) {
+    has_min_max_ = min != nullptr && max != nullptr && Traits::is_ordered &&
+                   Traits::Decode(*min, type_length, &min_) &&
+                   Traits::Decode(*max, type_length, &max_);
+  }
+
+  bool has_min_max() const { return has_min_max_; }
+  const T& min() const { return min_; }
+  const T& max() const { return max_; }
+
+  bool has_null_count() const { return null_count_ >= 0; }
+  int64_t null_count() const { return null_count_; }
+
+  int type_length() const { return type_length_; }
+
+ private:
+  bool has_min_max_;
+  T min_;
+  T max_;
+  int64_t null_count_;
+  int type_length_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_COLUMN_STATISTICS_H
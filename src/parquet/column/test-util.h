@@ -77,20 +77,84 @@ static void InitDictValues(
 class MockPageReader : public PageReader {
  public:
   explicit MockPageReader(const vector<shared_ptr<Page>>& pages)
-      : pages_(pages), page_index_(0) {}
+      : pages_(pages),
+        page_index_(0),
+        pages_skipped_(0),
+        pruned_({0, 0, 0}),
+        reuse_page_buffer_(false) {}
+
+  // Return data pages whose bytes are copied into one buffer, which the next
+  // data page overwrites, as a PageReader decompressing pages does
+  void reuse_page_buffer() {
+    int64_t max_size = 0;
+    for (const shared_ptr<Page>& page : pages_) {
+      max_size = std::max<int64_t>(max_size, page->size());
+    }
+    page_buffer_.resize(max_size);
+    reuse_page_buffer_ = true;
+  }
 
   // Implement the PageReader interface
   virtual shared_ptr<Page> NextPage() {
-    if (page_index_ == static_cast<int>(pages_.size())) {
-      // EOS to consumer
-      return shared_ptr<Page>(nullptr);
+    while (page_index_ < static_cast<int>(pages_.size())) {
+      const shared_ptr<Page>& page = pages_[page_index_++];
+      if (data_page_filter_ && page->type() == PageType::DATA_PAGE) {
+        const DataPage* data_page = static_cast<const DataPage*>(page.get());
+        const std::string* min = data_page->encoded_min();
+        const std::string* max = data_page->encoded_max();
+        if ((min != nullptr || max != nullptr) && !data_page_filter_(min, max)) {
+          ++pruned_.pages;
+          pruned_.values += data_page->num_values();
+          pruned_.bytes += data_page->size();
+          continue;
+        }
+      }
+      if (reuse_page_buffer_ && page->type() == PageType::DATA_PAGE) {
+        return CopyToPageBuffer(static_cast<const DataPage*>(page.get()));
+      }
+      return page;
+    }
+    // EOS to consumer
+    return shared_ptr<Page>(nullptr);
+  }
+
+  virtual void set_data_page_filter(const DataPageFilter& filter) {
+    data_page_filter_ = filter;
+  }
+
+  virtual PagePruningStats pruning_stats() const { return pruned_; }
+
+  virtual int64_t SkipPage(int64_t max_values) {
+    if (page_index_ == static_cast<int>(pages_.size()) ||
+        pages_[page_index_]->type() != PageType::DATA_PAGE) {
+      return 0;
     }
-    return pages_[page_index_++];
+    const DataPage* page = static_cast<const DataPage*>(pages_[page_index_].get());
+    if (page->num_values() == 0 || page->num_values() > max_values) { return 0; }
+    ++page_index_;
+    ++pages_skipped_;
+    return page->num_values();
   }
 
+  int pages_skipped() const { return pages_skipped_; }
+
  private:
+  shared_ptr<Page> CopyToPageBuffer(const DataPage* page) {
+    std::fill(page_buffer_.begin(), page_buffer_.end(), 0xff);
+    std::copy(page->data(), page->data() + page->size(), page_buffer_.begin());
+    return std::make_shared<DataPage>(
+        std::make_shared<Buffer>(page_buffer_.data(), page->size()), page->num_values(),
+        page->encoding(), page->definition_level_encoding(),
+        page->repetition_level_encoding());
+  }
+
   vector<shared_ptr<Page>> pages_;
   int page_index_;
+  int pages_skipped_;
+  DataPageFilter data_page_filter_;
+  PagePruningStats pruned_;
+  bool reuse_page_buffer_;
+  vector<uint8_t> page_buffer_;
 };
 
 // TODO(wesm): this is only used for testing for now. Refactor to form part of
@@ -168,8 +232,8 @@ class DataPageBuilder {
       ParquetException::NYI("only rle encoding currently implemented");
     }
 
-    // TODO: compute a more precise maximum size for the encoded levels
-    vector<uint8_t> encode_buffer(levels.size() * 2);
+    vector<uint8_t> encode_buffer(
+        LevelEncoder::MaxBufferSize(encoding, max_level, levels.size()));
 
     // We encode into separate memory from the output stream because the
     // RLE-encoded bytes have to be preceded in the stream by their absolute
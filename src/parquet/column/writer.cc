@@ -18,6 +18,7 @@
 #include "parquet/column/writer.h"
 
 #include "parquet/column/properties.h"
+#include "parquet/encodings/delta-bit-pack-encoding.h"
 #include "parquet/encodings/dictionary-encoding.h"
 #include "parquet/encodings/plain-encoding.h"
 
@@ -175,6 +176,9 @@ TypedColumnWriter<Type>::TypedColumnWriter(const ColumnDescriptor* schema,
       current_encoder_ = std::unique_ptr<EncoderType>(
           new DictEncoder<Type>(schema, &pool_, properties->allocator()));
       break;
+    case Encoding::DELTA_BINARY_PACKED:
+      current_encoder_ = MakeDeltaBitPackEncoder<Type>(schema, properties->allocator());
+      break;
     default:
       ParquetException::NYI("Selected encoding is not supported");
   }
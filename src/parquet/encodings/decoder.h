@@ -18,16 +18,34 @@
 #ifndef PARQUET_ENCODINGS_DECODER_H
 #define PARQUET_ENCODINGS_DECODER_H
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 #include "parquet/exception.h"
 #include "parquet/types.h"
+#include "parquet/util/buffer.h"
 #include "parquet/util/mem-allocator.h"
 
 namespace parquet {
 
 class ColumnDescriptor;
 
+// Makes room for 'size' bytes in 'buffer', at least doubling its capacity so that
+// appending to it repeatedly takes amortized linear time
+inline void ReserveForAppend(OwnedMutableBuffer* buffer, int64_t size) {
+  if (size > buffer->capacity()) {
+    buffer->Reserve(std::max(size, 2 * buffer->capacity()));
+  }
+}
+
+// Throws if 'size' bytes of binary values cannot be addressed by int32_t offsets
+inline void CheckBinarySize(int64_t size) {
+  if (size > std::numeric_limits<int32_t>::max()) {
+    throw ParquetException("Binary data does not fit into int32_t offsets");
+  }
+}
+
 // The Decoder template is parameterized on parquet::DataType subclasses
 template <typename DType>
 class Decoder {
@@ -48,6 +66,63 @@ class Decoder {
     throw ParquetException("Decoder does not implement this type.");
   }
 
+  // Skips over up to 'max_values' values and returns the number skipped. Decoders
+  // which can do so override this to skip without decoding; by default values are
+  // decoded into a scratch buffer and dropped.
+  virtual int Skip(int max_values) {
+    const int buffer_size = 1024;
+    T buffer[buffer_size];
+    int values_skipped = 0;
+    while (values_skipped < max_values) {
+      int batch_size = std::min(buffer_size, max_values - values_skipped);
+      int num_decoded = Decode(buffer, batch_size);
+      if (num_decoded == 0) { break; }
+      values_skipped += num_decoded;
+    }
+    return values_skipped;
+  }
+
+  // Decodes 'num_values' - 'null_count' values and spreads them over 'buffer' so
+  // that the i-th of the 'num_values' slots holds a value if bit
+  // valid_bits_offset + i of 'valid_bits' is set. Null slots are left with
+  // unspecified contents. Returns 'num_values', throwing if the page runs out of
+  // values first.
+  virtual int DecodeSpaced(T* buffer, int num_values, int null_count,
+      const uint8_t* valid_bits, int64_t valid_bits_offset) {
+    int values_to_read = num_values - null_count;
+    int values_read = Decode(buffer, values_to_read);
+    if (values_read != values_to_read) {
+      throw ParquetException("Number of values decoded did not match the bitmap");
+    }
+    // Move the values into place from the back, until the remaining ones are
+    // already in position
+    int value = values_read - 1;
+    for (int i = num_values - 1; i > value; --i) {
+      int64_t bit = valid_bits_offset + i;
+      if (valid_bits[bit / 8] & (1 << (bit % 8))) {
+        buffer[i] = buffer[value--];
+      }
+    }
+    return num_values;
+  }
+
+  // Advances past up to 'max_values' values without copying them, setting *data
+  // to the encoded bytes of the first one. Only supported by encodings whose
+  // encoded values have the same layout as T. Returns the number of values
+  // skipped over.
+  virtual int DecodeInPlace(int max_values, const uint8_t** data) {
+    throw ParquetException("Decoder does not support in-place decoding.");
+  }
+
+  // BYTE_ARRAY only. Decodes up to 'max_values' values, appending their bytes
+  // back to back to 'data' (whose size() is the number of bytes in use; it grows
+  // as needed) and the offset in 'data' past the end of the i-th value to
+  // offsets[i]. Returns the number of values decoded, throwing if 'data' would
+  // outgrow int32_t offsets.
+  virtual int DecodeBinary(int max_values, int32_t* offsets, OwnedMutableBuffer* data) {
+    throw ParquetException("Decoder does not support binary decoding.");
+  }
+
   // Returns the number of values left (for the last call to SetData()). This is
   // the number of values left in this page.
   int values_left() const { return num_values_; }
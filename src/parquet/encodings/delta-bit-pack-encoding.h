@@ -20,23 +20,188 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "parquet/encodings/decoder.h"
+#include "parquet/encodings/encoder.h"
 #include "parquet/util/bit-stream-utils.inline.h"
 #include "parquet/util/buffer.h"
+#include "parquet/util/output.h"
 
 namespace parquet {
 
+// DELTA_BINARY_PACKED data starts with a header of the block size, the number of
+// miniblocks per block, the number of values and the first value. Blocks of the
+// deltas between consecutive values follow, each made of the minimum delta of
+// the block, the bit width of each of its miniblocks and then the miniblocks:
+// the deltas minus the minimum delta, bit packed. Deltas wrap around like the
+// unsigned type of the values, so a block of INT64 deltas may need 64 bits.
+
+// ----------------------------------------------------------------------
+// Encoding::DELTA_BINARY_PACKED encoder implementation
+
+template <typename DType>
+class DeltaBitPackEncoder : public Encoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+  typedef typename std::make_unsigned<T>::type UT;
+
+  // Values per block and miniblocks per block, as written by parquet-mr
+  static const int BLOCK_SIZE = 128;
+  static const int NUM_MINI_BLOCKS = 4;
+  static const int VALUES_PER_MINI_BLOCK = BLOCK_SIZE / NUM_MINI_BLOCKS;
+
+  explicit DeltaBitPackEncoder(
+      const ColumnDescriptor* descr, MemoryAllocator* allocator = default_allocator())
+      : Encoder<DType>(descr, Encoding::DELTA_BINARY_PACKED, allocator),
+        blocks_sink_(new InMemoryOutputStream(IN_MEMORY_DEFAULT_CAPACITY, allocator)),
+        block_buffer_(MAX_BLOCK_BYTES, allocator),
+        num_values_(0),
+        first_value_(0),
+        last_value_(0),
+        num_deltas_(0) {
+    if (DType::type_num != Type::INT32 && DType::type_num != Type::INT64) {
+      throw ParquetException("Delta bit pack encoding should only be for integer data.");
+    }
+  }
+
+  virtual int64_t EstimatedDataEncodedSize() {
+    return MAX_HEADER_BYTES + blocks_sink_->Tell() + num_deltas_ * sizeof(T);
+  }
+
+  virtual std::shared_ptr<Buffer> FlushValues() {
+    if (num_deltas_ > 0) { FlushBlock(); }
+
+    uint8_t header[MAX_HEADER_BYTES];
+    BitWriter writer(header, MAX_HEADER_BYTES);
+    writer.PutVlqInt(BLOCK_SIZE);
+    writer.PutVlqInt(NUM_MINI_BLOCKS);
+    writer.PutVlqInt(num_values_);
+    writer.PutZigZagVlqInt64(first_value_);
+    writer.Flush();
+
+    std::shared_ptr<Buffer> blocks = blocks_sink_->GetBuffer();
+    auto buffer = std::make_shared<OwnedMutableBuffer>(
+        writer.bytes_written() + blocks->size(), this->allocator_);
+    memcpy(buffer->mutable_data(), header, writer.bytes_written());
+    memcpy(buffer->mutable_data() + writer.bytes_written(), blocks->data(),
+        blocks->size());
+
+    blocks_sink_.reset(
+        new InMemoryOutputStream(IN_MEMORY_DEFAULT_CAPACITY, this->allocator_));
+    num_values_ = 0;
+    return buffer;
+  }
+
+  virtual void Put(const T* src, int num_values) {
+    if (num_values == 0) { return; }
+    int i = 0;
+    if (num_values_ == 0) {
+      first_value_ = last_value_ = src[0];
+      i = 1;
+    }
+    num_values_ += num_values;
+    for (; i < num_values; ++i) {
+      deltas_[num_deltas_++] = static_cast<UT>(src[i]) - static_cast<UT>(last_value_);
+      last_value_ = src[i];
+      if (num_deltas_ == BLOCK_SIZE) { FlushBlock(); }
+    }
+  }
+
+ private:
+  // Three vlq ints and a 64-bit one
+  static const int MAX_HEADER_BYTES =
+      3 * BitReader::MAX_VLQ_BYTE_LEN + BitReader::MAX_VLQ64_BYTE_LEN;
+  // The minimum delta, the bit widths and the deltas at full width
+  static const int MAX_BLOCK_BYTES =
+      BitReader::MAX_VLQ64_BYTE_LEN + NUM_MINI_BLOCKS + BLOCK_SIZE * sizeof(T);
+
+  // Writes out the buffered deltas as a block. Miniblocks are padded with zeros
+  // to their full size, and those without deltas get a bit width of 0.
+  void FlushBlock() {
+    T min_delta = static_cast<T>(deltas_[0]);
+    for (int i = 1; i < num_deltas_; ++i) {
+      min_delta = std::min(min_delta, static_cast<T>(deltas_[i]));
+    }
+
+    BitWriter writer(block_buffer_.mutable_data(), MAX_BLOCK_BYTES);
+    writer.PutZigZagVlqInt64(min_delta);
+    uint8_t* bit_widths = writer.GetNextBytePtr(NUM_MINI_BLOCKS);
+    for (int i = 0; i < NUM_MINI_BLOCKS; ++i) {
+      int start = i * VALUES_PER_MINI_BLOCK;
+      int end = std::min(start + VALUES_PER_MINI_BLOCK, num_deltas_);
+      if (start >= end) {
+        bit_widths[i] = 0;
+        continue;
+      }
+      UT bits = 0;
+      for (int j = start; j < end; ++j) {
+        deltas_[j] -= static_cast<UT>(min_delta);
+        bits |= deltas_[j];
+      }
+      int bit_width = BitUtil::NumRequiredBits(bits);
+      bit_widths[i] = bit_width;
+      for (int j = start; j < start + VALUES_PER_MINI_BLOCK; ++j) {
+        PutDelta(&writer, j < end ? deltas_[j] : 0, bit_width);
+      }
+    }
+    writer.Flush();
+    blocks_sink_->Write(block_buffer_.data(), writer.bytes_written());
+    num_deltas_ = 0;
+  }
+
+  // BitWriter takes at most 32 bits at a time. As values are packed starting
+  // with their lowest bit, wider ones are written in two parts.
+  static void PutDelta(BitWriter* writer, uint64_t delta, int bit_width) {
+    if (bit_width <= 32) {
+      writer->PutValue(delta, bit_width);
+    } else {
+      writer->PutValue(delta & 0xFFFFFFFFULL, 32);
+      writer->PutValue(delta >> 32, bit_width - 32);
+    }
+  }
+
+  std::unique_ptr<InMemoryOutputStream> blocks_sink_;
+  OwnedMutableBuffer block_buffer_;
+
+  int num_values_;
+  T first_value_;
+  T last_value_;
+
+  UT deltas_[BLOCK_SIZE];
+  int num_deltas_;
+};
+
+// ----------------------------------------------------------------------
+// Encoding::DELTA_BINARY_PACKED decoder implementation
+
 template <typename DType>
 class DeltaBitPackDecoder : public Decoder<DType> {
  public:
   typedef typename DType::c_type T;
+  typedef typename std::make_unsigned<T>::type UT;
+
+  // Bounds on the header's block size and number of miniblocks, far above the
+  // 128 values in 4 miniblocks written by parquet-mr, so that a corrupt header
+  // cannot make the decoder allocate arbitrarily much
+  static const int MAX_BLOCK_SIZE = 4096;
+  static const int MAX_NUM_MINI_BLOCKS = 64;
 
   explicit DeltaBitPackDecoder(
       const ColumnDescriptor* descr, MemoryAllocator* allocator = default_allocator())
       : Decoder<DType>(descr, Encoding::DELTA_BINARY_PACKED),
-        delta_bit_widths_(0, allocator) {
+        num_mini_blocks_(0),
+        values_per_mini_block_(0),
+        values_remaining_(0),
+        first_value_pending_(false),
+        last_value_(0),
+        min_delta_(0),
+        mini_block_idx_(0),
+        mini_block_pos_(0),
+        mini_block_len_(0) {
     if (DType::type_num != Type::INT32 && DType::type_num != Type::INT64) {
       throw ParquetException("Delta bit pack encoding should only be for integer data.");
     }
@@ -45,78 +210,162 @@ class DeltaBitPackDecoder : public Decoder<DType> {
   virtual void SetData(int num_values, const uint8_t* data, int len) {
     num_values_ = num_values;
     decoder_ = BitReader(data, len);
-    values_current_block_ = 0;
-    values_current_mini_block_ = 0;
+
+    int32_t block_size;
+    int32_t total_values;
+    int64_t first_value;
+    if (!decoder_.GetVlqInt(&block_size) || !decoder_.GetVlqInt(&num_mini_blocks_) ||
+        !decoder_.GetVlqInt(&total_values) || !decoder_.GetZigZagVlqInt64(&first_value)) {
+      ParquetException::EofException();
+    }
+    if (block_size <= 0 || num_mini_blocks_ <= 0 || block_size % num_mini_blocks_ != 0 ||
+        (block_size / num_mini_blocks_) % 32 != 0 || total_values < 0) {
+      throw ParquetException("Invalid DELTA_BINARY_PACKED header");
+    }
+    if (block_size > MAX_BLOCK_SIZE || num_mini_blocks_ > MAX_NUM_MINI_BLOCKS) {
+      throw ParquetException("DELTA_BINARY_PACKED blocks too large");
+    }
+    values_per_mini_block_ = block_size / num_mini_blocks_;
+    bit_widths_.resize(num_mini_blocks_);
+    deltas_.resize(values_per_mini_block_);
+
+    values_remaining_ = total_values;
+    first_value_pending_ = total_values > 0;
+    last_value_ = static_cast<T>(first_value);
+    mini_block_idx_ = num_mini_blocks_;
+    mini_block_pos_ = mini_block_len_ = 0;
   }
 
   virtual int Decode(T* buffer, int max_values) {
-    return GetInternal(buffer, max_values);
+    max_values = std::min(max_values, num_values_);
+    int i = 0;
+    if (max_values > 0 && first_value_pending_) {
+      buffer[i++] = last_value_;
+      first_value_pending_ = false;
+      --values_remaining_;
+    }
+    while (i < max_values) {
+      if (mini_block_pos_ == mini_block_len_) { NextMiniBlock(); }
+      int n = std::min(max_values - i, mini_block_len_ - mini_block_pos_);
+      const UT* deltas = deltas_.data() + mini_block_pos_;
+      UT value = static_cast<UT>(last_value_);
+      for (int j = 0; j < n; ++j) {
+        value += min_delta_ + deltas[j];
+        buffer[i + j] = static_cast<T>(value);
+      }
+      last_value_ = static_cast<T>(value);
+      mini_block_pos_ += n;
+      i += n;
+    }
+    num_values_ -= max_values;
+    return max_values;
   }
 
  private:
   using Decoder<DType>::num_values_;
 
-  void InitBlock() {
-    int32_t block_size;
-    if (!decoder_.GetVlqInt(&block_size)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&num_mini_blocks_)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&values_current_block_)) { ParquetException::EofException(); }
-    if (!decoder_.GetZigZagVlqInt(&last_value_)) ParquetException::EofException();
-    delta_bit_widths_.Resize(num_mini_blocks_);
-
-    if (!decoder_.GetZigZagVlqInt(&min_delta_)) ParquetException::EofException();
+  // Reads the minimum delta and bit widths of the next block
+  void NextBlock() {
+    int64_t min_delta = 0;
+    if (!decoder_.GetZigZagVlqInt64(&min_delta)) { ParquetException::EofException(); }
+    min_delta_ = static_cast<UT>(min_delta);
     for (int i = 0; i < num_mini_blocks_; ++i) {
-      if (!decoder_.GetAligned<uint8_t>(1, &delta_bit_widths_[i])) {
+      if (!decoder_.GetAligned<uint8_t>(1, &bit_widths_[i])) {
         ParquetException::EofException();
       }
     }
-    values_per_mini_block_ = block_size / num_mini_blocks_;
     mini_block_idx_ = 0;
-    delta_bit_width_ = delta_bit_widths_[0];
-    values_current_mini_block_ = values_per_mini_block_;
   }
 
-  template <typename T>
-  int GetInternal(T* buffer, int max_values) {
-    max_values = std::min(max_values, num_values_);
-    for (int i = 0; i < max_values; ++i) {
-      if (UNLIKELY(values_current_mini_block_ == 0)) {
-        ++mini_block_idx_;
-        if (mini_block_idx_ < static_cast<size_t>(delta_bit_widths_.size())) {
-          delta_bit_width_ = delta_bit_widths_[mini_block_idx_];
-          values_current_mini_block_ = values_per_mini_block_;
-        } else {
-          InitBlock();
-          buffer[i] = last_value_;
-          continue;
+  // Unpacks the deltas of the next miniblock at once. Only the deltas of values
+  // which are left are read, as the padding of the last miniblock may be missing.
+  void NextMiniBlock() {
+    if (values_remaining_ == 0) { ParquetException::EofException(); }
+    if (mini_block_idx_ == num_mini_blocks_) { NextBlock(); }
+    int bit_width = bit_widths_[mini_block_idx_++];
+    if (bit_width > static_cast<int>(sizeof(T) * 8)) {
+      throw ParquetException("Invalid DELTA_BINARY_PACKED bit width");
+    }
+
+    int num_deltas = std::min(values_per_mini_block_, values_remaining_);
+    if (bit_width <= 32) {
+      if (decoder_.GetBatch(bit_width, deltas_.data(), num_deltas) != num_deltas) {
+        ParquetException::EofException();
+      }
+    } else {
+      // INT64 deltas wider than BitReader's 32 bits are read in two parts
+      for (int i = 0; i < num_deltas; ++i) {
+        uint64_t low, high;
+        if (!decoder_.GetValue(32, &low) || !decoder_.GetValue(bit_width - 32, &high)) {
+          ParquetException::EofException();
         }
+        deltas_[i] = static_cast<UT>(low | (high << 32));
       }
-
-      // TODO: the key to this algorithm is to decode the entire miniblock at once.
-      int64_t delta;
-      if (!decoder_.GetValue(delta_bit_width_, &delta)) ParquetException::EofException();
-      delta += min_delta_;
-      last_value_ += delta;
-      buffer[i] = last_value_;
-      --values_current_mini_block_;
     }
-    num_values_ -= max_values;
-    return max_values;
+    values_remaining_ -= num_deltas;
+    mini_block_pos_ = 0;
+    mini_block_len_ = num_deltas;
   }
 
   BitReader decoder_;
-  int32_t values_current_block_;
   int32_t num_mini_blocks_;
-  uint64_t values_per_mini_block_;
-  uint64_t values_current_mini_block_;
+  int values_per_mini_block_;
+  // Values in the page which have not been unpacked yet
+  int values_remaining_;
+  bool first_value_pending_;
+  T last_value_;
 
-  int32_t min_delta_;
-  size_t mini_block_idx_;
-  OwnedMutableBuffer delta_bit_widths_;
-  int delta_bit_width_;
+  UT min_delta_;
+  std::vector<uint8_t> bit_widths_;
+  int mini_block_idx_;
 
-  int32_t last_value_;
+  std::vector<UT> deltas_;
+  int mini_block_pos_;
+  int mini_block_len_;
 };
+
+// DELTA_BINARY_PACKED is only defined for INT32 and INT64. These create its
+// encoder and decoder for any type, throwing for the others.
+template <typename DType>
+std::unique_ptr<Encoder<DType>> MakeDeltaBitPackEncoder(
+    const ColumnDescriptor* descr, MemoryAllocator* allocator = default_allocator()) {
+  throw ParquetException("DELTA_BINARY_PACKED is only supported for INT32 and INT64");
+}
+
+template <typename DType>
+std::unique_ptr<Decoder<DType>> MakeDeltaBitPackDecoder(
+    const ColumnDescriptor* descr, MemoryAllocator* allocator = default_allocator()) {
+  throw ParquetException("DELTA_BINARY_PACKED is only supported for INT32 and INT64");
+}
+
+template <>
+inline std::unique_ptr<Encoder<Int32Type>> MakeDeltaBitPackEncoder<Int32Type>(
+    const ColumnDescriptor* descr, MemoryAllocator* allocator) {
+  return std::unique_ptr<Encoder<Int32Type>>(
+      new DeltaBitPackEncoder<Int32Type>(descr, allocator));
+}
+
+template <>
+inline std::unique_ptr<Encoder<Int64Type>> MakeDeltaBitPackEncoder<Int64Type>(
+    const ColumnDescriptor* descr, MemoryAllocator* allocator) {
+  return std::unique_ptr<Encoder<Int64Type>>(
+      new DeltaBitPackEncoder<Int64Type>(descr, allocator));
+}
+
+template <>
+inline std::unique_ptr<Decoder<Int32Type>> MakeDeltaBitPackDecoder<Int32Type>(
+    const ColumnDescriptor* descr, MemoryAllocator* allocator) {
+  return std::unique_ptr<Decoder<Int32Type>>(
+      new DeltaBitPackDecoder<Int32Type>(descr, allocator));
+}
+
+template <>
+inline std::unique_ptr<Decoder<Int64Type>> MakeDeltaBitPackDecoder<Int64Type>(
+    const ColumnDescriptor* descr, MemoryAllocator* allocator) {
+  return std::unique_ptr<Decoder<Int64Type>>(
+      new DeltaBitPackDecoder<Int64Type>(descr, allocator));
+}
+
 }  // namespace parquet
 
 #endif
@@ -48,7 +48,8 @@ class DictionaryDecoder : public Decoder<Type> {
       const ColumnDescriptor* descr, MemoryAllocator* allocator = default_allocator())
       : Decoder<Type>(descr, Encoding::RLE_DICTIONARY),
         dictionary_(0, allocator),
-        byte_array_data_(0, allocator) {}
+        byte_array_data_(0, allocator),
+        index_bit_width_(0) {}
 
   // Perform type-specific initiatialization
   void SetDict(Decoder<Type>* dictionary);
@@ -60,6 +61,7 @@ class DictionaryDecoder : public Decoder<Type> {
     ++data;
     --len;
     idx_decoder_ = RleDecoder(data, len, bit_width);
+    index_bit_width_ = bit_width;
   }
 
   virtual int Decode(T* buffer, int max_values) {
@@ -70,6 +72,48 @@ class DictionaryDecoder : public Decoder<Type> {
     return max_values;
   }
 
+  virtual int Skip(int max_values) {
+    max_values = std::min(max_values, num_values_);
+    if (idx_decoder_.Skip(max_values) != max_values) { ParquetException::EofException(); }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  // Like Decode, but returns the indices into the dictionary rather than the
+  // values. IndexType must be wide enough for the bit width of the page's indices
+  template <typename IndexType>
+  int DecodeIndices(IndexType* indices, int max_values) {
+    if (index_bit_width_ > static_cast<int>(sizeof(IndexType) * 8)) {
+      throw ParquetException("Dictionary indices are too wide for the index type");
+    }
+    max_values = std::min(max_values, num_values_);
+    int decoded_values = idx_decoder_.GetBatch(indices, max_values);
+    if (decoded_values != max_values) { ParquetException::EofException(); }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  // Consumes up to max_values indices, appending the position first_position + i
+  // of each i-th value whose dictionary entry has a non-zero byte in mask (of
+  // dictionary().size() entries) to selection[*num_selected]. No values are
+  // decoded. Returns the number of values consumed
+  int DecodeSelection(const uint8_t* mask, int max_values, int32_t first_position,
+      int32_t* selection, int64_t* num_selected) {
+    max_values = std::min(max_values, num_values_);
+    int decoded_values = idx_decoder_.GetSelection(max_values, mask, dictionary_.size(),
+        first_position, selection, num_selected);
+    if (decoded_values != max_values) { ParquetException::EofException(); }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  // Only valid for BYTE_ARRAY
+  virtual int DecodeBinary(int max_values, int32_t* offsets, OwnedMutableBuffer* data) {
+    return Decoder<Type>::DecodeBinary(max_values, offsets, data);
+  }
+
+  const Vector<T>& dictionary() const { return dictionary_; }
+
  private:
   using Decoder<Type>::num_values_;
 
@@ -81,6 +125,7 @@ class DictionaryDecoder : public Decoder<Type> {
   OwnedMutableBuffer byte_array_data_;
 
   RleDecoder idx_decoder_;
+  int index_bit_width_;
 };
 
 template <typename Type>
@@ -115,6 +160,53 @@ inline void DictionaryDecoder<ByteArrayType>::SetDict(
   }
 }
 
+// The entries of a BYTE_ARRAY dictionary lie back to back in byte_array_data_,
+// so the values of consecutive indices are copied with a single memcpy
+template <>
+inline int DictionaryDecoder<ByteArrayType>::DecodeBinary(
+    int max_values, int32_t* offsets, OwnedMutableBuffer* data) {
+  max_values = std::min(max_values, num_values_);
+  const int buffer_size = 1024;
+  int32_t indices[buffer_size];
+  const uint32_t dictionary_size = static_cast<uint32_t>(dictionary_.size());
+  int values_decoded = 0;
+  while (values_decoded < max_values) {
+    int batch_size = std::min(buffer_size, max_values - values_decoded);
+    if (idx_decoder_.GetBatch(indices, batch_size) != batch_size) {
+      ParquetException::EofException();
+    }
+    int32_t* batch_offsets = offsets + values_decoded;
+    int64_t offset = data->size();
+    for (int i = 0; i < batch_size; ++i) {
+      if (static_cast<uint32_t>(indices[i]) >= dictionary_size) {
+        throw ParquetException("Dictionary index out of range");
+      }
+      offset += dictionary_[indices[i]].len;
+      batch_offsets[i] = static_cast<int32_t>(offset);
+    }
+    CheckBinarySize(offset);
+    ReserveForAppend(data, offset);
+
+    uint8_t* out = data->mutable_data() + data->size();
+    for (int i = 0; i < batch_size;) {
+      int run_end = i + 1;
+      while (run_end < batch_size && indices[run_end] == indices[run_end - 1] + 1) {
+        ++run_end;
+      }
+      const ByteArray& last = dictionary_[indices[run_end - 1]];
+      const uint8_t* run_start = dictionary_[indices[i]].ptr;
+      int64_t run_size = last.ptr + last.len - run_start;
+      memcpy(out, run_start, run_size);
+      out += run_size;
+      i = run_end;
+    }
+    data->Resize(offset);
+    values_decoded += batch_size;
+  }
+  num_values_ -= max_values;
+  return max_values;
+}
+
 template <>
 inline void DictionaryDecoder<FLBAType>::SetDict(Decoder<FLBAType>* dictionary) {
   int num_dictionary_values = dictionary->values_left();
@@ -19,6 +19,7 @@
 
 #include "parquet/encodings/dictionary-encoding.h"
 #include "parquet/file/reader-internal.h"
+#include "parquet/util/bpacking-simd.h"
 #include "parquet/util/mem-pool.h"
 
 namespace parquet {
@@ -103,7 +104,8 @@ static void DecodeDict(
 
   MemPool pool;
   MemoryAllocator* allocator = default_allocator();
-  std::shared_ptr<ColumnDescriptor> descr = Int64Schema(Repetition::REQUIRED);
+  auto node = PrimitiveNode::Make("column", Repetition::REQUIRED, Type::type_num);
+  auto descr = std::make_shared<ColumnDescriptor>(node, 0, 0);
   std::shared_ptr<OwnedMutableBuffer> dict_buffer =
       std::make_shared<OwnedMutableBuffer>();
   auto indices = std::make_shared<OwnedMutableBuffer>();
@@ -154,6 +156,112 @@ static void BM_DictDecodingInt64_literals(::benchmark::State& state) {
 
 BENCHMARK(BM_DictDecodingInt64_literals)->Range(1024, 65536);
 
+static void BM_DictDecodingInt32_repeats(::benchmark::State& state) {
+  std::vector<int32_t> values(state.range_x(), 64);
+  DecodeDict<Int32Type>(values, state);
+}
+
+BENCHMARK(BM_DictDecodingInt32_repeats)->Range(1024, 65536);
+
+static void BM_DictDecodingInt32_literals(::benchmark::State& state) {
+  std::vector<int32_t> values(state.range_x());
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  DecodeDict<Int32Type>(values, state);
+}
+
+BENCHMARK(BM_DictDecodingInt32_literals)->Range(1024, 65536);
+
+// Short repeated runs mixed with literals
+static void BM_DictDecodingInt64_mixed(::benchmark::State& state) {
+  std::vector<int64_t> values(state.range_x());
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = (i / 64) % 2 == 0 ? i / 64 : i;
+  }
+  DecodeDict<Int64Type>(values, state);
+}
+
+BENCHMARK(BM_DictDecodingInt64_mixed)->Range(1024, 65536);
+
+// Unpacks 64K values of range_x() bits with kernel range_y() into 32-bit
+// (Unpack32) or 64-bit (Unpack64) output, or looks them up in a dictionary of
+// as many entries (UnpackDict32, UnpackDict64)
+template <typename OutType, bool kDict>
+static void UnpackBits(::benchmark::State& state) {
+  const int num_values = 65536;
+  int num_bits = state.range_x();
+  UnpackKernel::type kernel = static_cast<UnpackKernel::type>(state.range_y());
+  if (kernel > BestUnpackKernel()) {
+    state.SkipWithError("Unpacking kernel not supported by this CPU");
+    return;
+  }
+  std::vector<uint32_t> in(num_values / 32 * num_bits, 0x5A5A5A5A);
+  std::vector<OutType> out(num_values);
+  std::vector<OutType> dictionary(kDict ? 1 << num_bits : 0, 1);
+
+  while (state.KeepRunning()) {
+    if (kDict && sizeof(OutType) == 4) {
+      UnpackDict32(kernel, in.data(),
+          reinterpret_cast<const uint32_t*>(dictionary.data()),
+          reinterpret_cast<uint32_t*>(out.data()), num_values, num_bits);
+    } else if (kDict) {
+      UnpackDict64(kernel, in.data(),
+          reinterpret_cast<const uint64_t*>(dictionary.data()),
+          reinterpret_cast<uint64_t*>(out.data()), num_values, num_bits);
+    } else if (sizeof(OutType) == 4) {
+      UnpackBits32(kernel, in.data(), reinterpret_cast<uint32_t*>(out.data()),
+          num_values, num_bits);
+    } else {
+      UnpackBits64(kernel, in.data(), reinterpret_cast<uint64_t*>(out.data()),
+          num_values, num_bits);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_values);
+  state.SetBytesProcessed(state.iterations() * num_values * sizeof(OutType));
+}
+
+static void BM_Unpack32(::benchmark::State& state) {
+  UnpackBits<uint32_t, false>(state);
+}
+
+static void BM_Unpack64(::benchmark::State& state) {
+  UnpackBits<uint64_t, false>(state);
+}
+
+static void BM_UnpackDict32(::benchmark::State& state) {
+  UnpackBits<uint32_t, true>(state);
+}
+
+static void BM_UnpackDict64(::benchmark::State& state) {
+  UnpackBits<uint64_t, true>(state);
+}
+
+static void UnpackArguments(::benchmark::internal::Benchmark* b) {
+  for (int num_bits = 1; num_bits <= 32; ++num_bits) {
+    for (int kernel = UnpackKernel::SCALAR; kernel <= UnpackKernel::AVX512; ++kernel) {
+      b->ArgPair(num_bits, kernel);
+    }
+  }
+}
+
+BENCHMARK(BM_Unpack32)->Apply(UnpackArguments);
+
+BENCHMARK(BM_Unpack64)->Apply(UnpackArguments);
+
+// Dictionary indices of up to 20 bits
+static void UnpackDictArguments(::benchmark::internal::Benchmark* b) {
+  for (int num_bits = 1; num_bits <= 20; ++num_bits) {
+    for (int kernel = UnpackKernel::SCALAR; kernel <= UnpackKernel::AVX512; ++kernel) {
+      b->ArgPair(num_bits, kernel);
+    }
+  }
+}
+
+BENCHMARK(BM_UnpackDict32)->Apply(UnpackDictArguments);
+
+BENCHMARK(BM_UnpackDict64)->Apply(UnpackDictArguments);
+
 }  // namespace benchmark
 
 }  // namespace parquet
@@ -19,10 +19,12 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <string>
 #include <vector>
 
 #include "parquet/schema/descriptor.h"
+#include "parquet/encodings/delta-bit-pack-encoding.h"
 #include "parquet/encodings/dictionary-encoding.h"
 #include "parquet/encodings/plain-encoding.h"
 #include "parquet/types.h"
@@ -172,6 +174,20 @@ class TestEncodingBase : public ::testing::Test {
 
   virtual void CheckRoundtrip() = 0;
 
+  // Alternately skips and decodes values, checking the decoded ones
+  void CheckSkipDecode(Decoder<Type>* decoder) {
+    int i = 0;
+    while (i < num_values_) {
+      int num_skipped = decoder->Skip(7);
+      ASSERT_EQ(std::min(7, num_values_ - i), num_skipped);
+      i += num_skipped;
+      int num_decoded = decoder->Decode(decode_buf_ + i, 5);
+      ASSERT_EQ(std::min(5, num_values_ - i), num_decoded);
+      VerifyResults<T>(decode_buf_ + i, draws_ + i, num_decoded);
+      i += num_decoded;
+    }
+  }
+
   void Execute(int nvalues, int repeats) {
     InitData(nvalues, repeats);
     CheckRoundtrip();
@@ -195,16 +211,17 @@ class TestEncodingBase : public ::testing::Test {
 
 // Member variables are not visible to templated subclasses. Possibly figure
 // out an alternative to this class layering at some point
-#define USING_BASE_MEMBERS()                    \
-  using TestEncodingBase<Type>::pool_;          \
-  using TestEncodingBase<Type>::allocator_;     \
-  using TestEncodingBase<Type>::descr_;         \
-  using TestEncodingBase<Type>::num_values_;    \
-  using TestEncodingBase<Type>::draws_;         \
-  using TestEncodingBase<Type>::data_buffer_;   \
-  using TestEncodingBase<Type>::type_length_;   \
-  using TestEncodingBase<Type>::encode_buffer_; \
-  using TestEncodingBase<Type>::decode_buf_;
+#define USING_BASE_MEMBERS()                     \
+  using TestEncodingBase<Type>::pool_;           \
+  using TestEncodingBase<Type>::allocator_;      \
+  using TestEncodingBase<Type>::descr_;          \
+  using TestEncodingBase<Type>::num_values_;     \
+  using TestEncodingBase<Type>::draws_;          \
+  using TestEncodingBase<Type>::data_buffer_;    \
+  using TestEncodingBase<Type>::type_length_;    \
+  using TestEncodingBase<Type>::encode_buffer_;  \
+  using TestEncodingBase<Type>::decode_buf_;     \
+  using TestEncodingBase<Type>::CheckSkipDecode;
 
 template <typename Type>
 class TestPlainEncoding : public TestEncodingBase<Type> {
@@ -222,6 +239,9 @@ class TestPlainEncoding : public TestEncodingBase<Type> {
     int values_decoded = decoder.Decode(decode_buf_, num_values_);
     ASSERT_EQ(num_values_, values_decoded);
     VerifyResults<T>(decode_buf_, draws_, num_values_);
+
+    decoder.SetData(num_values_, encode_buffer_->data(), encode_buffer_->size());
+    CheckSkipDecode(&decoder);
   }
 
  protected:
@@ -272,6 +292,9 @@ class TestDictionaryEncoding : public TestEncodingBase<Type> {
     // values' data is owned by a buffer inside the DictionaryEncoder. We
     // should revisit when data lifetime is reviewed more generally.
     VerifyResults<T>(decode_buf_, draws_, num_values_);
+
+    decoder.SetData(num_values_, indices->data(), indices->size());
+    CheckSkipDecode(&decoder);
   }
 
  protected:
@@ -292,6 +315,149 @@ TEST(TestDictionaryEncoding, CannotDictDecodeBoolean) {
   ASSERT_THROW(decoder.SetDict(&dict_decoder), ParquetException);
 }
 
+// ----------------------------------------------------------------------
+// Delta bit pack encoding tests
+
+typedef ::testing::Types<Int32Type, Int64Type> DeltaBitPackTypes;
+
+template <typename Type>
+class TestDeltaBitPackEncoding : public TestEncodingBase<Type> {
+ public:
+  typedef typename Type::c_type T;
+  static constexpr int TYPE = Type::type_num;
+
+  void CheckRoundtrip() {
+    // Put the values in pieces which do not line up with blocks
+    DeltaBitPackEncoder<Type> encoder(descr_.get());
+    for (int i = 0; i < num_values_; i += 77) {
+      encoder.Put(draws_ + i, std::min(77, num_values_ - i));
+    }
+    encode_buffer_ = encoder.FlushValues();
+
+    DeltaBitPackDecoder<Type> decoder(descr_.get());
+    decoder.SetData(num_values_, encode_buffer_->data(), encode_buffer_->size());
+    int values_decoded = decoder.Decode(decode_buf_, num_values_);
+    ASSERT_EQ(num_values_, values_decoded);
+    VerifyResults<T>(decode_buf_, draws_, num_values_);
+
+    decoder.SetData(num_values_, encode_buffer_->data(), encode_buffer_->size());
+    CheckSkipDecode(&decoder);
+  }
+
+  // Round trips 'values', returning the encoded size
+  int64_t RoundTrip(const vector<T>& values) {
+    DeltaBitPackEncoder<Type> encoder(descr_.get());
+    encoder.Put(values.data(), values.size());
+    std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+
+    DeltaBitPackDecoder<Type> decoder(descr_.get());
+    decoder.SetData(values.size(), buffer->data(), buffer->size());
+    vector<T> decoded(values.size());
+    EXPECT_EQ(static_cast<int>(values.size()),
+        decoder.Decode(decoded.data(), values.size()));
+    EXPECT_EQ(values, decoded);
+    return buffer->size();
+  }
+
+ protected:
+  USING_BASE_MEMBERS();
+};
+
+TYPED_TEST_CASE(TestDeltaBitPackEncoding, DeltaBitPackTypes);
+
+TYPED_TEST(TestDeltaBitPackEncoding, BasicRoundTrip) {
+  this->Execute(2500, 2);
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, Sizes) {
+  typedef typename TypeParam::c_type T;
+  for (int n : {0, 1, 2, 31, 32, 33, 128, 129, 130, 1000}) {
+    vector<T> values(n);
+    for (int i = 0; i < n; ++i) {
+      values[i] = static_cast<T>((i * 7919) % 1013) - 500;
+    }
+    this->RoundTrip(values);
+  }
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, Extremes) {
+  typedef typename TypeParam::c_type T;
+  T min = std::numeric_limits<T>::min(), max = std::numeric_limits<T>::max();
+  vector<T> values = {min, max, 0, -1, min, min, max, 1, max, min};
+  for (int i = 0; i < 200; ++i) {
+    values.push_back(i % 2 == 0 ? min : max);
+  }
+  this->RoundTrip(values);
+}
+
+TYPED_TEST(TestDeltaBitPackEncoding, Monotonic) {
+  typedef typename TypeParam::c_type T;
+  // Timestamps at roughly regular intervals need a few bits per value
+  vector<T> values;
+  for (int i = 0; i < 10000; ++i) {
+    values.push_back(1000000 + i * 1000 + (i * 37) % 16);
+  }
+  ASSERT_LT(this->RoundTrip(values), 10000);
+
+  vector<T> constant(10000, 42);
+  ASSERT_LT(this->RoundTrip(constant), 1000);
+}
+
+TEST(TestDeltaBitPackEncoding, SpecExample) {
+  // 1, 2, 3, 4, 5: a header of block size 128, 4 miniblocks, 5 values and first
+  // value 1, then a block of minimum delta 1 and four miniblocks of 0 bits
+  vector<int32_t> values = {1, 2, 3, 4, 5};
+  DeltaBitPackEncoder<Int32Type> encoder(nullptr);
+  encoder.Put(values.data(), values.size());
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+  vector<uint8_t> expected = {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0, 0, 0, 0};
+  ASSERT_EQ(expected, vector<uint8_t>(buffer->data(), buffer->data() + buffer->size()));
+
+  // The encoder is reset for the next page
+  values = {-1};
+  encoder.Put(values.data(), values.size());
+  buffer = encoder.FlushValues();
+  expected = {0x80, 0x01, 0x04, 0x01, 0x01};
+  ASSERT_EQ(expected, vector<uint8_t>(buffer->data(), buffer->data() + buffer->size()));
+}
+
+TEST(TestDeltaBitPackEncoding, InvalidData) {
+  DeltaBitPackDecoder<Int32Type> decoder(nullptr);
+  int32_t values[10];
+
+  // Miniblocks of 8 values
+  vector<uint8_t> header = {0x20, 0x04, 0x05, 0x02};
+  ASSERT_THROW(decoder.SetData(5, header.data(), header.size()), ParquetException);
+
+  // Blocks of 8192 values, and 128 miniblocks of 32 values
+  header = {0x80, 0x40, 0x04, 0x05, 0x02};
+  ASSERT_THROW(decoder.SetData(5, header.data(), header.size()), ParquetException);
+  header = {0x80, 0x20, 0x80, 0x01, 0x05, 0x02};
+  ASSERT_THROW(decoder.SetData(5, header.data(), header.size()), ParquetException);
+  header = {0x80, 0x20, 0x04, 0x05, 0x02};
+  decoder.SetData(5, header.data(), header.size());
+
+  // Truncated header and truncated block
+  header = {0x80, 0x01, 0x04};
+  ASSERT_THROW(decoder.SetData(5, header.data(), header.size()), ParquetException);
+  vector<uint8_t> data = {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0x08};
+  decoder.SetData(5, data.data(), data.size());
+  ASSERT_THROW(decoder.Decode(values, 5), ParquetException);
+
+  // A bit width wider than the type
+  data = {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0x21, 0, 0, 0};
+  decoder.SetData(5, data.data(), data.size());
+  ASSERT_THROW(decoder.Decode(values, 5), ParquetException);
+
+  // More values than the header has
+  data = {0x80, 0x01, 0x04, 0x02, 0x02, 0x02, 0, 0, 0, 0};
+  decoder.SetData(5, data.data(), data.size());
+  ASSERT_THROW(decoder.Decode(values, 5), ParquetException);
+
+  ASSERT_THROW(MakeDeltaBitPackDecoder<DoubleType>(nullptr), ParquetException);
+  ASSERT_THROW(MakeDeltaBitPackEncoder<ByteArrayType>(nullptr), ParquetException);
+}
+
 }  // namespace test
 
 }  // namespace parquet
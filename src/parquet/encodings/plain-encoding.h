@@ -56,6 +56,15 @@ class PlainDecoder : public Decoder<DType> {
 
   virtual int Decode(T* buffer, int max_values);
 
+  virtual int Skip(int max_values);
+
+  // Only valid for fixed-width physical types other than BOOLEAN and
+  // FIXED_LEN_BYTE_ARRAY, whose PLAIN encoding is the in-memory layout of T
+  virtual int DecodeInPlace(int max_values, const uint8_t** data);
+
+  // Only valid for BYTE_ARRAY
+  virtual int DecodeBinary(int max_values, int32_t* offsets, OwnedMutableBuffer* data);
+
  private:
   using Decoder<DType>::descr_;
   const uint8_t* data_;
@@ -117,6 +126,107 @@ inline int PlainDecoder<DType>::Decode(T* buffer, int max_values) {
   return max_values;
 }
 
+// Returns the number of bytes taken by the next num_values PLAIN encoded values
+template <typename T>
+inline int SkipPlain(const uint8_t* data, int64_t data_size, int num_values,
+    int type_length) {
+  int bytes_to_skip = num_values * sizeof(T);
+  if (data_size < bytes_to_skip) { ParquetException::EofException(); }
+  return bytes_to_skip;
+}
+
+template <>
+inline int SkipPlain<ByteArray>(const uint8_t* data, int64_t data_size, int num_values,
+    int type_length) {
+  int bytes_skipped = 0;
+  for (int i = 0; i < num_values; ++i) {
+    if (data_size < static_cast<int64_t>(sizeof(uint32_t))) {
+      ParquetException::EofException();
+    }
+    int increment = sizeof(uint32_t) + *reinterpret_cast<const uint32_t*>(data);
+    if (data_size < increment) ParquetException::EofException();
+    data += increment;
+    data_size -= increment;
+    bytes_skipped += increment;
+  }
+  return bytes_skipped;
+}
+
+template <>
+inline int SkipPlain<FixedLenByteArray>(const uint8_t* data, int64_t data_size,
+    int num_values, int type_length) {
+  int bytes_to_skip = type_length * num_values;
+  if (data_size < bytes_to_skip) { ParquetException::EofException(); }
+  return bytes_to_skip;
+}
+
+template <typename DType>
+inline int PlainDecoder<DType>::Skip(int max_values) {
+  max_values = std::min(max_values, num_values_);
+  int bytes_skipped = SkipPlain<T>(data_, len_, max_values, type_length_);
+  data_ += bytes_skipped;
+  len_ -= bytes_skipped;
+  num_values_ -= max_values;
+  return max_values;
+}
+
+template <typename DType>
+inline int PlainDecoder<DType>::DecodeInPlace(int max_values, const uint8_t** data) {
+  max_values = std::min(max_values, num_values_);
+  int bytes_consumed = max_values * sizeof(T);
+  if (len_ < bytes_consumed) { ParquetException::EofException(); }
+  *data = data_;
+  data_ += bytes_consumed;
+  len_ -= bytes_consumed;
+  num_values_ -= max_values;
+  return max_values;
+}
+
+template <typename DType>
+inline int PlainDecoder<DType>::DecodeBinary(
+    int max_values, int32_t* offsets, OwnedMutableBuffer* data) {
+  return Decoder<DType>::DecodeBinary(max_values, offsets, data);
+}
+
+template <>
+inline int PlainDecoder<ByteArrayType>::DecodeBinary(
+    int max_values, int32_t* offsets, OwnedMutableBuffer* data) {
+  max_values = std::min(max_values, num_values_);
+  // Compute the offsets from the length prefixes first, so that 'data' grows at
+  // most once
+  const uint8_t* in = data_;
+  int64_t in_size = len_;
+  int64_t offset = data->size();
+  for (int i = 0; i < max_values; ++i) {
+    if (in_size < static_cast<int64_t>(sizeof(uint32_t))) {
+      ParquetException::EofException();
+    }
+    uint32_t len = *reinterpret_cast<const uint32_t*>(in);
+    int64_t increment = sizeof(uint32_t) + static_cast<int64_t>(len);
+    if (in_size < increment) { ParquetException::EofException(); }
+    offset += len;
+    offsets[i] = static_cast<int32_t>(offset);
+    in += increment;
+    in_size -= increment;
+  }
+  CheckBinarySize(offset);
+  ReserveForAppend(data, offset);
+
+  uint8_t* out = data->mutable_data() + data->size();
+  int32_t prev_offset = static_cast<int32_t>(data->size());
+  for (int i = 0; i < max_values; ++i) {
+    int32_t len = offsets[i] - prev_offset;
+    memcpy(out, data_ + sizeof(uint32_t), len);
+    out += len;
+    data_ += sizeof(uint32_t) + len;
+    prev_offset = offsets[i];
+  }
+  data->Resize(offset);
+  len_ = static_cast<int>(in_size);
+  num_values_ -= max_values;
+  return max_values;
+}
+
 template <>
 class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
  public:
@@ -149,6 +259,13 @@ class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
     return max_values;
   }
 
+  virtual int Skip(int max_values) {
+    max_values = std::min(max_values, num_values_);
+    if (!bit_reader_.Advance(max_values)) { ParquetException::EofException(); }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
  private:
   BitReader bit_reader_;
 };
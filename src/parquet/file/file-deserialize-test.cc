@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "parquet/column/page.h"
+#include "parquet/column/statistics.h"
 #include "parquet/compression/codec.h"
 #include "parquet/exception.h"
 #include "parquet/file/reader-internal.h"
@@ -60,11 +61,13 @@ class TestPageSerde : public ::testing::Test {
     ResetStream();
   }
 
-  void InitSerializedPageReader(Compression::type codec = Compression::UNCOMPRESSED) {
+  void InitSerializedPageReader(
+      Compression::type codec = Compression::UNCOMPRESSED, int pipeline_depth = 0) {
     EndStream();
     std::unique_ptr<InputStream> stream;
     stream.reset(new InMemoryInputStream(out_buffer_));
     page_reader_.reset(new SerializedPageReader(std::move(stream), codec));
+    page_reader_->set_pipeline_depth(pipeline_depth);
   }
 
   void WriteDataPageHeader(int max_serialized_len = 1024, int32_t uncompressed_size = 0,
@@ -86,6 +89,9 @@ class TestPageSerde : public ::testing::Test {
 
   void EndStream() { out_buffer_ = out_stream_->GetBuffer(); }
 
+  // Round trips compressed data pages of every supported codec
+  void CheckCompressedPages(int pipeline_depth);
+
  protected:
   std::unique_ptr<InMemoryOutputStream> out_stream_;
   std::shared_ptr<Buffer> out_buffer_;
@@ -166,7 +172,7 @@ TEST_F(TestPageSerde, TestFailLargePageHeaders) {
   ASSERT_THROW(page_reader_->NextPage(), ParquetException);
 }
 
-TEST_F(TestPageSerde, Compression) {
+void TestPageSerde::CheckCompressedPages(int pipeline_depth) {
   Compression::type codec_types[2] = {Compression::GZIP, Compression::SNAPPY};
 
   // This is a dummy number
@@ -199,7 +205,7 @@ TEST_F(TestPageSerde, Compression) {
       out_stream_->Write(buffer.data(), actual_size);
     }
 
-    InitSerializedPageReader(codec_type);
+    InitSerializedPageReader(codec_type, pipeline_depth);
 
     std::shared_ptr<Page> page;
     const DataPage* data_page;
@@ -210,11 +216,122 @@ TEST_F(TestPageSerde, Compression) {
       ASSERT_EQ(data_size, data_page->size());
       ASSERT_EQ(0, memcmp(faux_data[i].data(), data_page->data(), data_size));
     }
+    ASSERT_TRUE(page_reader_->NextPage() == nullptr);
 
     ResetStream();
   }
 }
 
+TEST_F(TestPageSerde, Compression) {
+  CheckCompressedPages(0);
+}
+
+TEST_F(TestPageSerde, PipelinedCompression) {
+  for (int pipeline_depth : {1, 3, 16}) {
+    CheckCompressedPages(pipeline_depth);
+  }
+}
+
+TEST_F(TestPageSerde, PipelinedFailLargePageHeaders) {
+  int stats_size = 256 * 1024;  // 256 KB
+  AddDummyStats(stats_size, data_page_header_);
+  WriteDataPageHeader(512 * 1024);
+
+  // The error raised on the decompression thread surfaces in NextPage
+  InitSerializedPageReader(Compression::GZIP, 2);
+  page_reader_->set_max_page_header_size(128 * 1024);
+  ASSERT_THROW(page_reader_->NextPage(), ParquetException);
+}
+
+TEST_F(TestPageSerde, SkipPage) {
+  // Three data pages of 100, 50 and 200 values, each with 10 bytes of data
+  std::vector<uint8_t> page_data(10, 0);
+  for (int32_t num_values : {100, 50, 200}) {
+    data_page_header_.num_values = num_values;
+    WriteDataPageHeader(1024, page_data.size(), page_data.size());
+    out_stream_->Write(page_data.data(), page_data.size());
+  }
+  InitSerializedPageReader();
+
+  // The first page does not fit, so it is not skipped
+  ASSERT_EQ(0, page_reader_->SkipPage(99));
+  ASSERT_EQ(100, page_reader_->SkipPage(100));
+  ASSERT_EQ(50, page_reader_->SkipPage(1000));
+
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_EQ(200, static_cast<const DataPage*>(page.get())->num_values());
+  ASSERT_EQ(10, page->size());
+  ASSERT_EQ(0, page_reader_->SkipPage(1000));
+  ASSERT_TRUE(page_reader_->NextPage() == nullptr);
+}
+
+TEST_F(TestPageSerde, DataPageFilter) {
+  // Four data pages of 10 values whose statistics claim the values [10 * i,
+  // 10 * i + 9]. The last page has no statistics
+  std::vector<uint8_t> page_data(40, 0);
+  data_page_header_.num_values = 10;
+  for (int32_t i = 0; i < 4; ++i) {
+    data_page_header_.__isset.statistics = i < 3;
+    if (i < 3) {
+      int32_t min = 10 * i, max = 10 * i + 9;
+      data_page_header_.statistics.__set_min(
+          std::string(reinterpret_cast<const char*>(&min), sizeof(int32_t)));
+      data_page_header_.statistics.__set_max(
+          std::string(reinterpret_cast<const char*>(&max), sizeof(int32_t)));
+    }
+    WriteDataPageHeader(1024, page_data.size(), page_data.size());
+    out_stream_->Write(page_data.data(), page_data.size());
+  }
+  InitSerializedPageReader();
+  RangePredicate<Int32Type> predicate = RangePredicate<Int32Type>::AtLeast(15);
+  page_reader_->set_data_page_filter(
+      [predicate](const std::string* min, const std::string* max) {
+        return predicate.MayMatchEncoded(min, max);
+      });
+
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  const DataPage* data_page = static_cast<const DataPage*>(page.get());
+  ASSERT_EQ(4, data_page->encoded_min()->size());
+  ASSERT_EQ(10, *reinterpret_cast<const int32_t*>(data_page->min()));
+  page = page_reader_->NextPage();
+  data_page = static_cast<const DataPage*>(page.get());
+  ASSERT_EQ(20, *reinterpret_cast<const int32_t*>(data_page->min()));
+  page = page_reader_->NextPage();
+  ASSERT_TRUE(static_cast<const DataPage*>(page.get())->encoded_min() == nullptr);
+  ASSERT_TRUE(page_reader_->NextPage() == nullptr);
+
+  PagePruningStats stats = page_reader_->pruning_stats();
+  ASSERT_EQ(1, stats.pages);
+  ASSERT_EQ(10, stats.values);
+  ASSERT_EQ(40, stats.bytes);
+}
+
+TEST_F(TestPageSerde, UnorderedDataPageStatistics) {
+  // Binary statistics of a writer which may have ordered them as signed bytes:
+  // only the page holding a single value is pruned
+  std::vector<uint8_t> page_data(40, 0);
+  data_page_header_.num_values = 10;
+  data_page_header_.__isset.statistics = true;
+  const char* bounds[][2] = {{"apple", "kiwi"}, {"fig", "fig"}, {"lemon", "pear"}};
+  for (auto& bound : bounds) {
+    data_page_header_.statistics.__set_min(bound[0]);
+    data_page_header_.statistics.__set_max(bound[1]);
+    WriteDataPageHeader(1024, page_data.size(), page_data.size());
+    out_stream_->Write(page_data.data(), page_data.size());
+  }
+  InitSerializedPageReader();
+  page_reader_->set_min_max_ordered(false);
+  page_reader_->set_data_page_filter(
+      [](const std::string* min, const std::string* max) { return false; });
+
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_EQ("apple", *static_cast<const DataPage*>(page.get())->encoded_min());
+  page = page_reader_->NextPage();
+  ASSERT_EQ("lemon", *static_cast<const DataPage*>(page.get())->encoded_min());
+  ASSERT_TRUE(page_reader_->NextPage() == nullptr);
+  ASSERT_EQ(1, page_reader_->pruning_stats().pages);
+}
+
 TEST_F(TestPageSerde, LZONotSupported) {
   // Must await PARQUET-530
   int data_size = 1024;
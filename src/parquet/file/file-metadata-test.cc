@@ -90,6 +90,9 @@ TEST(Metadata, TestBuildAccess) {
 
   // row group1 metadata
   auto rg1_accessor = f_accessor->RowGroup(0);
+  // accessors are created once and then reused
+  ASSERT_EQ(rg1_accessor, f_accessor->RowGroup(0));
+  ASSERT_EQ(rg1_accessor->ColumnChunk(0), rg1_accessor->ColumnChunk(0));
   ASSERT_EQ(2, rg1_accessor->num_columns());
   ASSERT_EQ(nrows / 2, rg1_accessor->num_rows());
   ASSERT_EQ(1024, rg1_accessor->total_byte_size());
@@ -153,5 +156,124 @@ TEST(Metadata, TestBuildAccess) {
   ASSERT_EQ(10, rg2_column1->data_page_offset());
   ASSERT_EQ(26, rg2_column2->data_page_offset());
 }
+
+TEST(Metadata, TestUnsignedBinaryStatistics) {
+  ASSERT_TRUE(HasUnsignedBinaryStatistics("parquet-mr version 1.10.0 (build 031a6654)"));
+  ASSERT_TRUE(HasUnsignedBinaryStatistics("parquet-mr version 1.12.3"));
+  ASSERT_TRUE(HasUnsignedBinaryStatistics("parquet-mr version 2.0"));
+  ASSERT_TRUE(HasUnsignedBinaryStatistics("parquet-cpp version 1.3.0"));
+  ASSERT_TRUE(HasUnsignedBinaryStatistics("parquet-cpp version 1.5.1-SNAPSHOT"));
+  ASSERT_TRUE(HasUnsignedBinaryStatistics("parquet-cpp-arrow version 14.0.1"));
+
+  ASSERT_FALSE(HasUnsignedBinaryStatistics("parquet-mr version 1.8.1 (build 4aba4dae)"));
+  ASSERT_FALSE(HasUnsignedBinaryStatistics("parquet-mr version 1.9.0-SNAPSHOT"));
+  ASSERT_FALSE(HasUnsignedBinaryStatistics("parquet-cpp version 1.2.0"));
+  ASSERT_FALSE(HasUnsignedBinaryStatistics("parquet-mr version"));
+  ASSERT_FALSE(HasUnsignedBinaryStatistics("impala version 2.9.0"));
+  ASSERT_FALSE(HasUnsignedBinaryStatistics(DEFAULT_CREATED_BY));
+  ASSERT_FALSE(HasUnsignedBinaryStatistics(""));
+}
+
+static std::unique_ptr<FileMetaData> MakeStatisticsMetaData(
+    const std::string& created_by, const std::string& name_min) {
+  parquet::schema::NodeVector fields;
+  fields.push_back(parquet::schema::Int32("int_col", Repetition::REQUIRED));
+  fields.push_back(parquet::schema::ByteArray("name", Repetition::REQUIRED));
+  parquet::SchemaDescriptor schema;
+  schema.Init(parquet::schema::GroupNode::Make("schema", Repetition::REPEATED, fields));
+
+  std::shared_ptr<WriterProperties> props =
+      WriterProperties::Builder().created_by(created_by)->build();
+  auto f_builder = FileMetaDataBuilder::Make(&schema, props);
+  auto rg_builder = f_builder->AppendRowGroup(100);
+
+  int32_t int_values[] = {-5, 5};
+  std::string int_min(reinterpret_cast<const char*>(&int_values[0]), sizeof(int32_t));
+  std::string int_max(reinterpret_cast<const char*>(&int_values[1]), sizeof(int32_t));
+  std::string name_max = "pear";
+  ColumnStatistics stats = {0, 0, &int_min, &int_max};
+  auto column = rg_builder->NextColumnChunk();
+  column->SetStatistics(stats);
+  column->Finish(100, 0, 0, 4, 400, 400, false);
+  stats.min = &name_min;
+  stats.max = &name_max;
+  column = rg_builder->NextColumnChunk();
+  column->SetStatistics(stats);
+  column->Finish(100, 0, 0, 404, 400, 400, false);
+  rg_builder->Finish(800);
+  return f_builder->Finish();
+}
+
+TEST(Metadata, TestLegacyBinaryStatistics) {
+  // Binary statistics of writers which may have ordered them as signed bytes
+  // are not decoded, numeric statistics are
+  auto metadata = MakeStatisticsMetaData("parquet-mr version 1.8.1", "apple");
+  const ColumnChunkMetaData* ints = metadata->RowGroup(0)->ColumnChunk(0);
+  const ColumnChunkMetaData* names = metadata->RowGroup(0)->ColumnChunk(1);
+  ASSERT_TRUE(ints->min_max_ordered());
+  ASSERT_TRUE(ints->typed_statistics<Int32Type>().has_min_max());
+  ASSERT_EQ(-5, ints->typed_statistics<Int32Type>().min());
+  ASSERT_FALSE(names->min_max_ordered());
+  TypedStatistics<ByteArrayType> name_stats = names->typed_statistics<ByteArrayType>();
+  ASSERT_FALSE(name_stats.has_min_max());
+  ASSERT_EQ(0, name_stats.null_count());
+  // The raw statistics are still available
+  ASSERT_EQ("apple", *names->statistics().min);
+
+  // A single value is the same in either order
+  metadata = MakeStatisticsMetaData("parquet-mr version 1.8.1", "pear");
+  names = metadata->RowGroup(0)->ColumnChunk(1);
+  ASSERT_TRUE(names->typed_statistics<ByteArrayType>().has_min_max());
+
+  metadata = MakeStatisticsMetaData("parquet-mr version 1.10.0", "apple");
+  names = metadata->RowGroup(0)->ColumnChunk(1);
+  ASSERT_TRUE(names->min_max_ordered());
+  name_stats = names->typed_statistics<ByteArrayType>();
+  ASSERT_TRUE(name_stats.has_min_max());
+  ASSERT_EQ(ByteArray(5, reinterpret_cast<const uint8_t*>("apple")), name_stats.min());
+}
+
+static std::shared_ptr<const FileMetaData> MakeMetaData(int64_t nrows) {
+  parquet::schema::NodeVector fields;
+  fields.push_back(parquet::schema::Int32("int_col", Repetition::REQUIRED));
+  parquet::SchemaDescriptor schema;
+  schema.Init(parquet::schema::GroupNode::Make("schema", Repetition::REPEATED, fields));
+
+  std::shared_ptr<WriterProperties> props = WriterProperties::Builder().build();
+  auto f_builder = FileMetaDataBuilder::Make(&schema, props);
+  auto rg_builder = f_builder->AppendRowGroup(nrows);
+  rg_builder->NextColumnChunk()->Finish(nrows, 0, 0, 4, 512, 600, false);
+  rg_builder->Finish(512);
+  return f_builder->Finish();
+}
+
+TEST(Metadata, TestMetaDataCache) {
+  FileMetaDataCache cache(2);
+  auto metadata1 = MakeMetaData(1);
+  auto metadata2 = MakeMetaData(2);
+  auto metadata3 = MakeMetaData(3);
+
+  ASSERT_EQ(nullptr, cache.Get("file1"));
+  cache.Put("file1", metadata1);
+  cache.Put("file2", metadata2);
+  ASSERT_EQ(metadata1, cache.Get("file1"));
+  ASSERT_EQ(2, cache.size());
+
+  // file2 is the least recently used entry
+  cache.Put("file3", metadata3);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(nullptr, cache.Get("file2"));
+  ASSERT_EQ(metadata1, cache.Get("file1"));
+  ASSERT_EQ(metadata3, cache.Get("file3"));
+
+  ASSERT_EQ(3, cache.hits());
+  ASSERT_EQ(2, cache.misses());
+  ASSERT_EQ(1, cache.evictions());
+
+  cache.Clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(nullptr, cache.Get("file1"));
+}
+
 }  // namespace metadata
 }  // namespace parquet
@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "parquet/column/reader.h"
 #include "parquet/column/writer.h"
 #include "parquet/file/reader.h"
@@ -33,6 +39,26 @@ using schema::PrimitiveNode;
 
 namespace test {
 
+// Counts the positional reads issued against an in-memory file
+class CountingBufferReader : public BufferReader {
+ public:
+  CountingBufferReader(const std::shared_ptr<Buffer>& buffer, int* num_reads)
+      : BufferReader(buffer), num_reads_(num_reads) {}
+
+  int64_t ReadAt(int64_t pos, int64_t nbytes, uint8_t* out) override {
+    ++*num_reads_;
+    return BufferReader::ReadAt(pos, nbytes, out);
+  }
+
+  std::shared_ptr<Buffer> ReadAt(int64_t pos, int64_t nbytes) override {
+    ++*num_reads_;
+    return BufferReader::ReadAt(pos, nbytes);
+  }
+
+ private:
+  int* num_reads_;
+};
+
 class TestSerialize : public ::testing::Test {
  public:
   void SetUpSchemaRequired() {
@@ -99,6 +125,302 @@ class TestSerialize : public ::testing::Test {
   }
 };
 
+TEST_F(TestSerialize, ParallelPageRuns) {
+  SetUpSchemaOptional();
+
+  int num_pages = 10;
+  int page_levels = 100;
+  int num_levels = num_pages * page_levels;
+
+  // Every third value is null
+  std::vector<int16_t> def_levels(num_levels);
+  std::vector<int64_t> values;
+  for (int i = 0; i < num_levels; ++i) {
+    def_levels[i] = i % 3 == 0 ? 0 : 1;
+    if (def_levels[i]) { values.push_back(i); }
+  }
+
+  for (auto codec_type : {Compression::UNCOMPRESSED, Compression::GZIP}) {
+    std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+    auto gnode = std::static_pointer_cast<GroupNode>(node_);
+    // Every WriteBatch call below fills a data page
+    std::shared_ptr<WriterProperties> writer_properties = WriterProperties::Builder()
+                                                              .compression(codec_type)
+                                                              ->disable_dictionary()
+                                                              ->data_pagesize(1)
+                                                              ->build();
+    auto file_writer = ParquetFileWriter::Open(sink, gnode, writer_properties);
+    auto row_group_writer = file_writer->AppendRowGroup(num_levels);
+    auto column_writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+    const int64_t* page_values = values.data();
+    for (int p = 0; p < num_pages; ++p) {
+      const int16_t* page_def_levels = def_levels.data() + p * page_levels;
+      column_writer->WriteBatch(page_levels, page_def_levels, nullptr, page_values);
+      page_values += std::count(page_def_levels, page_def_levels + page_levels, 1);
+    }
+    column_writer->Close();
+    row_group_writer->Close();
+    file_writer->Close();
+
+    std::unique_ptr<RandomAccessSource> source(new BufferReader(sink->GetBuffer()));
+    auto file_reader = ParquetFileReader::Open(std::move(source));
+
+    for (int max_runs : {1, 3, 4, 16}) {
+      std::vector<ColumnRun> runs = file_reader->RowGroup(0)->ColumnRuns(0, max_runs);
+      ASSERT_EQ(std::min(max_runs, num_pages), static_cast<int>(runs.size()));
+      ASSERT_EQ(num_levels, runs.back().level_offset + runs.back().num_levels);
+
+      std::vector<int16_t> def_levels_out(num_levels);
+      std::vector<int64_t> values_out(num_levels);
+      int64_t values_read = ReadColumnRuns<Int64Type>(
+          runs, 4, def_levels_out.data(), nullptr, values_out.data());
+      ASSERT_EQ(static_cast<int64_t>(values.size()), values_read);
+      values_out.resize(values_read);
+      ASSERT_EQ(def_levels, def_levels_out);
+      ASSERT_EQ(values, values_out);
+    }
+  }
+}
+
+TEST_F(TestSerialize, SpeculativeFooterRead) {
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(node_);
+  auto file_writer = ParquetFileWriter::Open(sink, gnode);
+  auto row_group_writer = file_writer->AppendRowGroup(100);
+  auto column_writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+  std::vector<int64_t> values(100, 128);
+  column_writer->WriteBatch(values.size(), nullptr, nullptr, values.data());
+  column_writer->Close();
+  row_group_writer->Close();
+  file_writer->Close();
+  auto buffer = sink->GetBuffer();
+
+  // The default read size captures footer and metadata of a small file at once
+  int num_reads = 0;
+  std::unique_ptr<RandomAccessSource> source(
+      new CountingBufferReader(buffer, &num_reads));
+  auto file_reader = ParquetFileReader::Open(std::move(source));
+  ASSERT_EQ(1, num_reads);
+  ASSERT_EQ(100, file_reader->metadata()->num_rows());
+
+  // Metadata that does not fit in the speculative read needs a second read
+  ReaderProperties props;
+  props.set_footer_read_size(16);
+  num_reads = 0;
+  source.reset(new CountingBufferReader(buffer, &num_reads));
+  file_reader = ParquetFileReader::Open(std::move(source), props);
+  ASSERT_EQ(2, num_reads);
+  ASSERT_EQ(100, file_reader->metadata()->num_rows());
+}
+
+TEST_F(TestSerialize, MetaDataCache) {
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(node_);
+  auto file_writer = ParquetFileWriter::Open(sink, gnode);
+  auto row_group_writer = file_writer->AppendRowGroup(100);
+  auto column_writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+  std::vector<int64_t> values(100, 128);
+  column_writer->WriteBatch(values.size(), nullptr, nullptr, values.data());
+  column_writer->Close();
+  row_group_writer->Close();
+  file_writer->Close();
+  auto buffer = sink->GetBuffer();
+
+  FileMetaDataCache cache(4);
+  ReaderProperties props;
+  props.set_metadata_cache(&cache);
+
+  int num_reads = 0;
+  std::unique_ptr<RandomAccessSource> source(
+      new CountingBufferReader(buffer, &num_reads));
+  auto file_reader = ParquetFileReader::Open(std::move(source), props, "file");
+  ASSERT_EQ(1, num_reads);
+  ASSERT_EQ(1, cache.misses());
+
+  // The second open is served from the cache without reading the footer
+  num_reads = 0;
+  source.reset(new CountingBufferReader(buffer, &num_reads));
+  auto cached_reader = ParquetFileReader::Open(std::move(source), props, "file");
+  ASSERT_EQ(0, num_reads);
+  ASSERT_EQ(1, cache.hits());
+  ASSERT_EQ(file_reader->metadata(), cached_reader->metadata());
+
+  auto col_reader =
+      std::static_pointer_cast<Int64Reader>(cached_reader->RowGroup(0)->Column(0));
+  std::vector<int64_t> values_out(100);
+  int64_t values_read;
+  col_reader->ReadBatch(values_out.size(), nullptr, nullptr, values_out.data(),
+      &values_read);
+  ASSERT_EQ(values, values_out);
+}
+
+// A compressed column chunk is decompressed page by page into the same buffer,
+// so values read in one batch from several pages must not point into it
+TEST_F(TestSerialize, CompressedByteArrayPages) {
+  auto pnode = PrimitiveNode::Make("name", Repetition::REQUIRED, Type::BYTE_ARRAY);
+  node_ = GroupNode::Make("schema", Repetition::REQUIRED, std::vector<NodePtr>({pnode}));
+  schema_.Init(node_);
+
+  const int num_rows = 2000;
+  std::vector<std::string> strings;
+  std::vector<ByteArray> values;
+  for (int i = 0; i < num_rows; ++i) {
+    strings.push_back("value-" + std::to_string(i));
+  }
+  for (const std::string& str : strings) {
+    values.push_back(ByteArray(static_cast<uint32_t>(str.size()),
+        reinterpret_cast<const uint8_t*>(str.data())));
+  }
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  WriterProperties::Builder builder;
+  builder.compression(Compression::SNAPPY)->disable_dictionary()->data_pagesize(1024);
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(node_), builder.build());
+  auto row_group_writer = file_writer->AppendRowGroup(num_rows);
+  auto column_writer = static_cast<ByteArrayWriter*>(row_group_writer->NextColumn());
+  for (int i = 0; i < num_rows; i += 100) {
+    column_writer->WriteBatch(100, nullptr, nullptr, values.data() + i);
+  }
+  column_writer->Close();
+  row_group_writer->Close();
+  file_writer->Close();
+
+  std::unique_ptr<RandomAccessSource> source(new BufferReader(sink->GetBuffer()));
+  auto file_reader = ParquetFileReader::Open(std::move(source));
+  auto col_reader =
+      std::static_pointer_cast<ByteArrayReader>(file_reader->RowGroup(0)->Column(0));
+  std::vector<ByteArray> values_out(num_rows);
+  int64_t values_read = 0;
+  int64_t page_transitions = 0;
+  ASSERT_EQ(num_rows, col_reader->ReadBatch(num_rows, nullptr, nullptr,
+                          values_out.data(), &values_read, &page_transitions));
+  ASSERT_EQ(num_rows, values_read);
+  ASSERT_GT(page_transitions, 1);
+  for (int i = 0; i < num_rows; ++i) {
+    ASSERT_EQ(values[i], values_out[i]) << i;
+  }
+}
+
+TEST_F(TestSerialize, MetaDataCacheKeyFollowsFile) {
+  auto gnode = std::static_pointer_cast<GroupNode>(node_);
+  auto write_file = [&gnode](const std::string& path, int64_t value) {
+    std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+    auto file_writer = ParquetFileWriter::Open(sink, gnode);
+    auto column_writer =
+        static_cast<Int64Writer*>(file_writer->AppendRowGroup(100)->NextColumn());
+    std::vector<int64_t> values(100, value);
+    column_writer->WriteBatch(values.size(), nullptr, nullptr, values.data());
+    column_writer->Close();
+    file_writer->Close();
+    auto buffer = sink->GetBuffer();
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+  };
+
+  const std::string path = "parquet-cpp-test-metadata-cache.parquet";
+  const std::string replacement = path + ".tmp";
+  write_file(path, 128);
+
+  FileMetaDataCache cache(4);
+  ReaderProperties props;
+  props.set_metadata_cache(&cache);
+  ParquetFileReader::OpenFile(path, false, props);
+  ParquetFileReader::OpenFile(path, true, props);
+  ASSERT_EQ(1, cache.misses());
+  ASSERT_EQ(1, cache.hits());
+
+  // A file of the same size renamed over the original within the same second
+  // is a different inode, so its metadata is not served from the cache
+  write_file(replacement, 256);
+  ASSERT_EQ(0, std::rename(replacement.c_str(), path.c_str()));
+  auto file_reader = ParquetFileReader::OpenFile(path, false, props);
+  ASSERT_EQ(2, cache.misses());
+  ASSERT_EQ(1, cache.hits());
+
+  auto col_reader =
+      std::static_pointer_cast<Int64Reader>(file_reader->RowGroup(0)->Column(0));
+  std::vector<int64_t> values_out(100);
+  int64_t values_read;
+  col_reader->ReadBatch(values_out.size(), nullptr, nullptr, values_out.data(),
+      &values_read);
+  ASSERT_EQ(std::vector<int64_t>(100, 256), values_out);
+  std::remove(path.c_str());
+}
+
+TEST_F(TestSerialize, LazyMetaData) {
+  auto int32_node = PrimitiveNode::Make("int32", Repetition::REQUIRED, Type::INT32);
+  auto int64_node = PrimitiveNode::Make("int64", Repetition::REQUIRED, Type::INT64);
+  node_ = GroupNode::Make(
+      "schema", Repetition::REQUIRED, std::vector<NodePtr>({int32_node, int64_node}));
+  schema_.Init(node_);
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(node_);
+  auto file_writer = ParquetFileWriter::Open(sink, gnode);
+  std::vector<int32_t> int32_values(100, 32);
+  std::vector<int64_t> int64_values(100, 64);
+  for (int r = 0; r < 2; ++r) {
+    auto row_group_writer = file_writer->AppendRowGroup(100);
+    auto int32_writer = static_cast<Int32Writer*>(row_group_writer->NextColumn());
+    int32_writer->WriteBatch(100, nullptr, nullptr, int32_values.data());
+    int32_writer->Close();
+    auto int64_writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+    int64_writer->WriteBatch(100, nullptr, nullptr, int64_values.data());
+    int64_writer->Close();
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+  auto buffer = sink->GetBuffer();
+
+  ReaderProperties props;
+  props.enable_lazy_metadata();
+  std::unique_ptr<RandomAccessSource> source(new BufferReader(buffer));
+  auto lazy_reader = ParquetFileReader::Open(std::move(source), props);
+  source.reset(new BufferReader(buffer));
+  auto file_reader = ParquetFileReader::Open(std::move(source));
+
+  const FileMetaData* lazy_metadata = lazy_reader->metadata();
+  const FileMetaData* metadata = file_reader->metadata();
+  ASSERT_EQ(metadata->num_rows(), lazy_metadata->num_rows());
+  ASSERT_EQ(metadata->num_row_groups(), lazy_metadata->num_row_groups());
+  ASSERT_EQ(metadata->created_by(), lazy_metadata->created_by());
+  ASSERT_EQ(lazy_metadata->RowGroup(1), lazy_metadata->RowGroup(1));
+
+  for (int r = 0; r < 2; ++r) {
+    auto row_group = metadata->RowGroup(r);
+    auto lazy_row_group = lazy_metadata->RowGroup(r);
+    ASSERT_EQ(row_group->num_columns(), lazy_row_group->num_columns());
+    ASSERT_EQ(row_group->num_rows(), lazy_row_group->num_rows());
+    ASSERT_EQ(row_group->total_byte_size(), lazy_row_group->total_byte_size());
+    // Decode the second column chunk first
+    for (int i : {1, 0}) {
+      auto column = row_group->ColumnChunk(i);
+      auto lazy_column = lazy_row_group->ColumnChunk(i);
+      ASSERT_EQ(column->type(), lazy_column->type());
+      ASSERT_EQ(column->num_values(), lazy_column->num_values());
+      ASSERT_EQ(column->data_page_offset(), lazy_column->data_page_offset());
+      ASSERT_EQ(column->total_compressed_size(), lazy_column->total_compressed_size());
+    }
+  }
+
+  auto col_reader =
+      std::static_pointer_cast<Int64Reader>(lazy_reader->RowGroup(1)->Column(1));
+  std::vector<int64_t> values_out(100);
+  int64_t values_read;
+  col_reader->ReadBatch(
+      values_out.size(), nullptr, nullptr, values_out.data(), &values_read);
+  ASSERT_EQ(int64_values, values_out);
+
+  // The footer is written back unchanged
+  InMemoryOutputStream out;
+  const_cast<FileMetaData*>(lazy_metadata)->WriteTo(&out);
+  auto footer = out.GetBuffer();
+  const uint8_t* file_end = buffer->data() + buffer->size();
+  ASSERT_EQ(*reinterpret_cast<const uint32_t*>(file_end - 8), footer->size());
+  ASSERT_EQ(0, memcmp(file_end - 8 - footer->size(), footer->data(), footer->size()));
+}
+
 TEST_F(TestSerialize, SmallFileUncompressed) {
   FileSerializeTest(Compression::UNCOMPRESSED);
 }
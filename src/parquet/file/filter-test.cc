@@ -0,0 +1,212 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/column/statistics.h"
+#include "parquet/exception.h"
+#include "parquet/file/filter.h"
+#include "parquet/file/metadata.h"
+#include "parquet/schema/descriptor.h"
+#include "parquet/schema/types.h"
+#include "parquet/types.h"
+
+using std::string;
+using std::vector;
+
+namespace parquet {
+
+namespace test {
+
+// The ByteArray points into s, which must outlive it
+static ByteArray ToByteArray(const string& s) {
+  return ByteArray(s.size(), reinterpret_cast<const uint8_t*>(s.data()));
+}
+
+// Three row groups of 100 rows with statistics
+//
+//   row group | ts (INT64)     | name (BYTE_ARRAY)  | x (DOUBLE)
+//   0         | [0, 99]        | ["apple", "kiwi"]  | no statistics
+//   1         | [100, 199]     | ["lemon", "peach"] | 100 nulls
+//   2         | [200, 299]     | ["pear", "plum"]   | [1.5, 2.5], 10 nulls
+class TestRowGroupFilter : public ::testing::Test {
+ public:
+  void SetUp() { Init("parquet-mr version 1.10.0 (build 031a6654)"); }
+
+  void Init(const string& created_by) {
+    schema::NodeVector fields;
+    fields.push_back(schema::Int64("ts", Repetition::REQUIRED));
+    fields.push_back(schema::ByteArray("name", Repetition::OPTIONAL));
+    fields.push_back(schema::Double("x", Repetition::OPTIONAL));
+    schema_.Init(schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+    std::shared_ptr<WriterProperties> props =
+        WriterProperties::Builder().created_by(created_by)->build();
+    auto builder = FileMetaDataBuilder::Make(&schema_, props);
+    const char* names[] = {"apple", "kiwi", "lemon", "peach", "pear", "plum"};
+    for (int i = 0; i < 3; ++i) {
+      auto rg_builder = builder->AppendRowGroup(100);
+
+      string ts_min = Encode<Int64Type>(100 * i);
+      string ts_max = Encode<Int64Type>(100 * i + 99);
+      auto column = rg_builder->NextColumnChunk();
+      column->SetStatistics(MakeStatistics(0, &ts_min, &ts_max));
+      column->Finish(100, 0, 0, 4, 800, 800, false);
+
+      string name_min = names[2 * i], name_max = names[2 * i + 1];
+      column = rg_builder->NextColumnChunk();
+      column->SetStatistics(MakeStatistics(0, &name_min, &name_max));
+      column->Finish(100, 0, 0, 804, 800, 800, false);
+
+      string x_min = Encode<DoubleType>(1.5), x_max = Encode<DoubleType>(2.5);
+      column = rg_builder->NextColumnChunk();
+      if (i == 1) {
+        column->SetStatistics(MakeStatistics(100, nullptr, nullptr));
+      } else if (i == 2) {
+        column->SetStatistics(MakeStatistics(10, &x_min, &x_max));
+      }
+      column->Finish(100, 0, 0, 1604, 800, 800, false);
+      rg_builder->Finish(2400);
+    }
+    metadata_ = builder->Finish();
+  }
+
+  template <typename DType>
+  static string Encode(const typename DType::c_type& value) {
+    return StatisticsTraits<DType>::Encode(value, -1);
+  }
+
+  static ColumnStatistics MakeStatistics(
+      int64_t null_count, const string* min, const string* max) {
+    ColumnStatistics stats;
+    stats.null_count = null_count;
+    stats.distinct_count = 0;
+    stats.min = min;
+    stats.max = max;
+    return stats;
+  }
+
+  vector<int> Filter(const RowGroupFilterPtr& filter) {
+    vector<int> row_groups;
+    for (int i = 0; i < metadata_->num_row_groups(); ++i) {
+      if (filter->MayMatch(*metadata_->RowGroup(i))) { row_groups.push_back(i); }
+    }
+    return row_groups;
+  }
+
+ protected:
+  SchemaDescriptor schema_;
+  std::unique_ptr<FileMetaData> metadata_;
+};
+
+TEST_F(TestRowGroupFilter, TypedStatistics) {
+  TypedStatistics<Int64Type> ts =
+      metadata_->RowGroup(1)->ColumnChunk(0)->typed_statistics<Int64Type>();
+  ASSERT_TRUE(ts.has_min_max());
+  ASSERT_EQ(100, ts.min());
+  ASSERT_EQ(199, ts.max());
+  ASSERT_EQ(0, ts.null_count());
+
+  TypedStatistics<ByteArrayType> name =
+      metadata_->RowGroup(2)->ColumnChunk(1)->typed_statistics<ByteArrayType>();
+  ASSERT_TRUE(name.has_min_max());
+  string pear = "pear", plum = "plum";
+  ASSERT_EQ(ToByteArray(pear), name.min());
+  ASSERT_EQ(ToByteArray(plum), name.max());
+
+  TypedStatistics<DoubleType> x =
+      metadata_->RowGroup(0)->ColumnChunk(2)->typed_statistics<DoubleType>();
+  ASSERT_FALSE(x.has_min_max());
+  ASSERT_FALSE(x.has_null_count());
+  x = metadata_->RowGroup(1)->ColumnChunk(2)->typed_statistics<DoubleType>();
+  ASSERT_FALSE(x.has_min_max());
+  ASSERT_EQ(100, x.null_count());
+
+  ASSERT_THROW(metadata_->RowGroup(0)->ColumnChunk(0)->typed_statistics<Int32Type>(),
+      ParquetException);
+}
+
+TEST_F(TestRowGroupFilter, Comparisons) {
+  ASSERT_EQ(vector<int>({1}), Filter(filter::Equal<Int64Type>(0, 150)));
+  ASSERT_EQ(vector<int>(), Filter(filter::Equal<Int64Type>(0, 300)));
+  ASSERT_EQ(vector<int>({0, 1, 2}), Filter(filter::NotEqual<Int64Type>(0, 150)));
+  ASSERT_EQ(vector<int>({0}), Filter(filter::Less<Int64Type>(0, 100)));
+  ASSERT_EQ(vector<int>({0, 1}), Filter(filter::LessEqual<Int64Type>(0, 100)));
+  ASSERT_EQ(vector<int>({2}), Filter(filter::Greater<Int64Type>(0, 199)));
+  ASSERT_EQ(vector<int>({1, 2}), Filter(filter::GreaterEqual<Int64Type>(0, 199)));
+
+  string fig = "fig", kiwi = "kiwi";
+  ASSERT_EQ(vector<int>({0}), Filter(filter::Equal<ByteArrayType>(1, ToByteArray(fig))));
+  ASSERT_EQ(
+      vector<int>({1, 2}), Filter(filter::Greater<ByteArrayType>(1, ToByteArray(kiwi))));
+
+  // Row group 0 has no statistics and row group 1 only nulls
+  ASSERT_EQ(vector<int>({0, 2}), Filter(filter::Less<DoubleType>(2, 2.0)));
+  ASSERT_EQ(vector<int>({0}), Filter(filter::Greater<DoubleType>(2, 3.0)));
+}
+
+TEST_F(TestRowGroupFilter, In) {
+  ASSERT_EQ(vector<int>({0, 2}), Filter(filter::In<Int64Type>(0, {5, 250, 400})));
+  ASSERT_EQ(vector<int>(), Filter(filter::In<Int64Type>(0, {-1, 300})));
+  string mango = "mango", zucchini = "zucchini";
+  vector<ByteArray> names = {ToByteArray(mango), ToByteArray(zucchini)};
+  ASSERT_EQ(vector<int>({1}), Filter(filter::In<ByteArrayType>(1, names)));
+}
+
+TEST_F(TestRowGroupFilter, Nulls) {
+  ASSERT_EQ(vector<int>(), Filter(filter::IsNull(0)));
+  ASSERT_EQ(vector<int>({0, 1, 2}), Filter(filter::IsNotNull(0)));
+  ASSERT_EQ(vector<int>({0, 1, 2}), Filter(filter::IsNull(2)));
+  ASSERT_EQ(vector<int>({0, 2}), Filter(filter::IsNotNull(2)));
+}
+
+TEST_F(TestRowGroupFilter, AndOr) {
+  RowGroupFilterPtr recent = filter::GreaterEqual<Int64Type>(0, 150);
+  string pear_name = "pear";
+  RowGroupFilterPtr pear = filter::Equal<ByteArrayType>(1, ToByteArray(pear_name));
+  RowGroupFilterPtr early = filter::Less<Int64Type>(0, 10);
+
+  ASSERT_EQ(vector<int>({2}), Filter(filter::And({recent, pear})));
+  ASSERT_EQ(vector<int>({0, 2}), Filter(filter::Or({early, pear})));
+  ASSERT_EQ(
+      vector<int>({0, 2}), Filter(filter::Or({filter::And({recent, pear}), early})));
+  ASSERT_EQ(vector<int>({0, 1, 2}), Filter(filter::And({})));
+  ASSERT_EQ(vector<int>(), Filter(filter::Or({})));
+}
+
+TEST_F(TestRowGroupFilter, LegacyBinaryStatistics) {
+  // This writer may have ordered the names as signed bytes
+  Init("parquet-mr version 1.8.1 (build 4aba4dae)");
+  string fig = "fig";
+  ASSERT_EQ(
+      vector<int>({0, 1, 2}), Filter(filter::Equal<ByteArrayType>(1, ToByteArray(fig))));
+  ASSERT_EQ(vector<int>({1}), Filter(filter::Equal<Int64Type>(0, 150)));
+}
+
+TEST_F(TestRowGroupFilter, Invalid) {
+  ASSERT_THROW(Filter(filter::Equal<Int64Type>(3, 0)), ParquetException);
+  ASSERT_THROW(Filter(filter::Equal<Int32Type>(0, 0)), ParquetException);
+}
+
+}  // namespace test
+
+}  // namespace parquet
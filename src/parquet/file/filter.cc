@@ -0,0 +1,269 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/file/filter.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/column/statistics.h"
+#include "parquet/exception.h"
+#include "parquet/schema/descriptor.h"
+
+namespace parquet {
+
+namespace {
+
+const ColumnChunkMetaData* GetColumnChunk(const RowGroupMetaData& row_group, int i) {
+  if (i < 0 || i >= row_group.num_columns()) {
+    throw ParquetException("Filter column index out of range");
+  }
+  return row_group.ColumnChunk(i);
+}
+
+// Negative if the column chunk has no null count
+int64_t NullCount(const ColumnChunkMetaData& chunk) {
+  switch (chunk.type()) {
+    case Type::BOOLEAN:
+      return chunk.typed_statistics<BooleanType>().null_count();
+    case Type::INT32:
+      return chunk.typed_statistics<Int32Type>().null_count();
+    case Type::INT64:
+      return chunk.typed_statistics<Int64Type>().null_count();
+    case Type::INT96:
+      return chunk.typed_statistics<Int96Type>().null_count();
+    case Type::FLOAT:
+      return chunk.typed_statistics<FloatType>().null_count();
+    case Type::DOUBLE:
+      return chunk.typed_statistics<DoubleType>().null_count();
+    case Type::BYTE_ARRAY:
+      return chunk.typed_statistics<ByteArrayType>().null_count();
+    case Type::FIXED_LEN_BYTE_ARRAY:
+      return chunk.typed_statistics<FLBAType>().null_count();
+    default:
+      return -1;
+  }
+}
+
+struct CompareOp {
+  enum type { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+};
+
+// Matches rows whose value compares with any of the given values as op. The
+// values are kept encoded, so that BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values
+// need not outlive the filter
+template <typename DType>
+class ComparisonFilter : public RowGroupFilter {
+ public:
+  typedef typename DType::c_type T;
+  typedef StatisticsTraits<DType> Traits;
+
+  ComparisonFilter(int column, CompareOp::type op, const std::vector<T>& values,
+      int type_length)
+      : column_(column), op_(op) {
+    for (const T& value : values) {
+      values_.push_back(Traits::Encode(value, type_length));
+    }
+  }
+
+  virtual bool MayMatch(const RowGroupMetaData& row_group) const {
+    const ColumnChunkMetaData* chunk = GetColumnChunk(row_group, column_);
+    int type_length = row_group.schema()->Column(column_)->type_length();
+    TypedStatistics<DType> stats = chunk->typed_statistics<DType>(type_length);
+    if (stats.has_null_count() && stats.null_count() >= chunk->num_values()) {
+      return false;
+    }
+    if (!stats.has_min_max()) { return true; }
+
+    T value;
+    for (const std::string& encoded : values_) {
+      // NaN, or a value of the wrong size, is not ordered against the statistics
+      if (!Traits::Decode(encoded, type_length, &value)) { return true; }
+      if (ValueMayMatch(stats, value)) { return true; }
+    }
+    return false;
+  }
+
+ private:
+  bool ValueMayMatch(const TypedStatistics<DType>& stats, const T& value) const {
+    int type_length = stats.type_length();
+    int min_cmp = Traits::Compare(stats.min(), value, type_length);
+    int max_cmp = Traits::Compare(stats.max(), value, type_length);
+    switch (op_) {
+      case CompareOp::EQUAL:
+        return min_cmp <= 0 && max_cmp >= 0;
+      case CompareOp::NOT_EQUAL:
+        return min_cmp != 0 || max_cmp != 0;
+      case CompareOp::LESS:
+        return min_cmp < 0;
+      case CompareOp::LESS_EQUAL:
+        return min_cmp <= 0;
+      case CompareOp::GREATER:
+        return max_cmp > 0;
+      case CompareOp::GREATER_EQUAL:
+        return max_cmp >= 0;
+    }
+    return true;
+  }
+
+  int column_;
+  CompareOp::type op_;
+  std::vector<std::string> values_;
+};
+
+class NullFilter : public RowGroupFilter {
+ public:
+  NullFilter(int column, bool is_null) : column_(column), is_null_(is_null) {}
+
+  virtual bool MayMatch(const RowGroupMetaData& row_group) const {
+    const ColumnChunkMetaData* chunk = GetColumnChunk(row_group, column_);
+    int64_t null_count = NullCount(*chunk);
+    if (null_count < 0) { return true; }
+    return is_null_ ? null_count > 0 : null_count < chunk->num_values();
+  }
+
+ private:
+  int column_;
+  bool is_null_;
+};
+
+class AndFilter : public RowGroupFilter {
+ public:
+  explicit AndFilter(const std::vector<RowGroupFilterPtr>& filters) : filters_(filters) {}
+
+  virtual bool MayMatch(const RowGroupMetaData& row_group) const {
+    for (const RowGroupFilterPtr& filter : filters_) {
+      if (!filter->MayMatch(row_group)) { return false; }
+    }
+    return true;
+  }
+
+ private:
+  std::vector<RowGroupFilterPtr> filters_;
+};
+
+class OrFilter : public RowGroupFilter {
+ public:
+  explicit OrFilter(const std::vector<RowGroupFilterPtr>& filters) : filters_(filters) {}
+
+  virtual bool MayMatch(const RowGroupMetaData& row_group) const {
+    for (const RowGroupFilterPtr& filter : filters_) {
+      if (filter->MayMatch(row_group)) { return true; }
+    }
+    return false;
+  }
+
+ private:
+  std::vector<RowGroupFilterPtr> filters_;
+};
+
+template <typename DType>
+RowGroupFilterPtr MakeComparison(int column, CompareOp::type op,
+    const typename DType::c_type& value, int type_length) {
+  return std::make_shared<ComparisonFilter<DType>>(
+      column, op, std::vector<typename DType::c_type>(1, value), type_length);
+}
+
+}  // namespace
+
+namespace filter {
+
+template <typename DType>
+RowGroupFilterPtr Equal(
+    int column, const typename DType::c_type& value, int type_length) {
+  return MakeComparison<DType>(column, CompareOp::EQUAL, value, type_length);
+}
+
+template <typename DType>
+RowGroupFilterPtr NotEqual(
+    int column, const typename DType::c_type& value, int type_length) {
+  return MakeComparison<DType>(column, CompareOp::NOT_EQUAL, value, type_length);
+}
+
+template <typename DType>
+RowGroupFilterPtr Less(int column, const typename DType::c_type& value, int type_length) {
+  return MakeComparison<DType>(column, CompareOp::LESS, value, type_length);
+}
+
+template <typename DType>
+RowGroupFilterPtr LessEqual(
+    int column, const typename DType::c_type& value, int type_length) {
+  return MakeComparison<DType>(column, CompareOp::LESS_EQUAL, value, type_length);
+}
+
+template <typename DType>
+RowGroupFilterPtr Greater(
+    int column, const typename DType::c_type& value, int type_length) {
+  return MakeComparison<DType>(column, CompareOp::GREATER, value, type_length);
+}
+
+template <typename DType>
+RowGroupFilterPtr GreaterEqual(
+    int column, const typename DType::c_type& value, int type_length) {
+  return MakeComparison<DType>(column, CompareOp::GREATER_EQUAL, value, type_length);
+}
+
+template <typename DType>
+RowGroupFilterPtr In(int column, const std::vector<typename DType::c_type>& values,
+    int type_length) {
+  return std::make_shared<ComparisonFilter<DType>>(
+      column, CompareOp::EQUAL, values, type_length);
+}
+
+RowGroupFilterPtr IsNull(int column) {
+  return std::make_shared<NullFilter>(column, true);
+}
+
+RowGroupFilterPtr IsNotNull(int column) {
+  return std::make_shared<NullFilter>(column, false);
+}
+
+RowGroupFilterPtr And(const std::vector<RowGroupFilterPtr>& filters) {
+  return std::make_shared<AndFilter>(filters);
+}
+
+RowGroupFilterPtr Or(const std::vector<RowGroupFilterPtr>& filters) {
+  return std::make_shared<OrFilter>(filters);
+}
+
+// ----------------------------------------------------------------------
+// Instantiate templated functions
+
+#define INSTANTIATE_FILTERS(DType)                                                  \
+  template RowGroupFilterPtr Equal<DType>(int, const DType::c_type&, int);          \
+  template RowGroupFilterPtr NotEqual<DType>(int, const DType::c_type&, int);       \
+  template RowGroupFilterPtr Less<DType>(int, const DType::c_type&, int);           \
+  template RowGroupFilterPtr LessEqual<DType>(int, const DType::c_type&, int);      \
+  template RowGroupFilterPtr Greater<DType>(int, const DType::c_type&, int);        \
+  template RowGroupFilterPtr GreaterEqual<DType>(int, const DType::c_type&, int);   \
+  template RowGroupFilterPtr In<DType>(int, const std::vector<DType::c_type>&, int)
+
+INSTANTIATE_FILTERS(BooleanType);
+INSTANTIATE_FILTERS(Int32Type);
+INSTANTIATE_FILTERS(Int64Type);
+INSTANTIATE_FILTERS(Int96Type);
+INSTANTIATE_FILTERS(FloatType);
+INSTANTIATE_FILTERS(DoubleType);
+INSTANTIATE_FILTERS(ByteArrayType);
+INSTANTIATE_FILTERS(FLBAType);
+
+#undef INSTANTIATE_FILTERS
+
+}  // namespace filter
+
+}  // namespace parquet
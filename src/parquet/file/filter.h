@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_FILE_FILTER_H
+#define PARQUET_FILE_FILTER_H
+
+#include <memory>
+#include <vector>
+
+#include "parquet/file/metadata.h"
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// A filter expression evaluated against the column chunk statistics of a row
+// group. Evaluation is conservative: a row group is only rejected when its
+// statistics prove that none of its rows can match, so row groups without
+// statistics always pass.
+//
+// Columns are referred to by their leaf index in the schema, and comparison
+// values must have the column's physical type. Null values never satisfy a
+// comparison.
+class PARQUET_EXPORT RowGroupFilter {
+ public:
+  virtual ~RowGroupFilter() {}
+
+  // Returns false if no row of the row group can match
+  virtual bool MayMatch(const RowGroupMetaData& row_group) const = 0;
+};
+
+typedef std::shared_ptr<const RowGroupFilter> RowGroupFilterPtr;
+
+namespace filter {
+
+// column == value
+template <typename DType>
+RowGroupFilterPtr Equal(
+    int column, const typename DType::c_type& value, int type_length = -1);
+
+// column != value
+template <typename DType>
+RowGroupFilterPtr NotEqual(
+    int column, const typename DType::c_type& value, int type_length = -1);
+
+// column < value
+template <typename DType>
+RowGroupFilterPtr Less(
+    int column, const typename DType::c_type& value, int type_length = -1);
+
+// column <= value
+template <typename DType>
+RowGroupFilterPtr LessEqual(
+    int column, const typename DType::c_type& value, int type_length = -1);
+
+// column > value
+template <typename DType>
+RowGroupFilterPtr Greater(
+    int column, const typename DType::c_type& value, int type_length = -1);
+
+// column >= value
+template <typename DType>
+RowGroupFilterPtr GreaterEqual(
+    int column, const typename DType::c_type& value, int type_length = -1);
+
+// column IN (values)
+template <typename DType>
+RowGroupFilterPtr In(int column, const std::vector<typename DType::c_type>& values,
+    int type_length = -1);
+
+PARQUET_EXPORT RowGroupFilterPtr IsNull(int column);
+
+PARQUET_EXPORT RowGroupFilterPtr IsNotNull(int column);
+
+PARQUET_EXPORT RowGroupFilterPtr And(const std::vector<RowGroupFilterPtr>& filters);
+
+PARQUET_EXPORT RowGroupFilterPtr Or(const std::vector<RowGroupFilterPtr>& filters);
+
+}  // namespace filter
+
+}  // namespace parquet
+
+#endif  // PARQUET_FILE_FILTER_H
@@ -15,23 +15,54 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <cstdio>
 #include <vector>
 
+#include "parquet/exception.h"
 #include "parquet/file/metadata.h"
 #include "parquet/schema/converter.h"
 #include "parquet/thrift/util.h"
 
 namespace parquet {
 
+bool HasUnsignedBinaryStatistics(const std::string& created_by) {
+  // e.g. "parquet-mr version 1.10.0 (build ...)"
+  static const std::string kVersion = " version ";
+  size_t pos = created_by.find(kVersion);
+  if (pos == std::string::npos) { return false; }
+  std::string application = created_by.substr(0, pos);
+  int major = 0, minor = 0;
+  if (sscanf(created_by.c_str() + pos + kVersion.size(), "%d.%d", &major, &minor) < 1) {
+    return false;
+  }
+  if (application == "parquet-mr") {
+    return major > 1 || (major == 1 && minor >= 10);
+  } else if (application == "parquet-cpp") {
+    return major > 1 || (major == 1 && minor >= 3);
+  }
+  // The parquet-cpp releases made with Arrow, from 4.0.0 on
+  return application == "parquet-cpp-arrow";
+}
+
 // MetaData Accessor
 // ColumnChunk metadata
 class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
  public:
-  explicit ColumnChunkMetaDataImpl(const format::ColumnChunk* column) : column_(column) {
+  ColumnChunkMetaDataImpl(
+      const format::ColumnChunk* column, const std::string* created_by)
+      : column_(column) {
     const format::ColumnMetaData& meta_data = column->meta_data;
+    bool binary = meta_data.type == format::Type::BYTE_ARRAY ||
+                  meta_data.type == format::Type::FIXED_LEN_BYTE_ARRAY;
+    min_max_ordered_ =
+        !binary || (created_by != nullptr && HasUnsignedBinaryStatistics(*created_by));
     for (auto encoding : meta_data.encodings) {
       encodings_.push_back(FromThrift(encoding));
     }
+    stats_.null_count = 0;
+    stats_.distinct_count = 0;
+    stats_.min = nullptr;
+    stats_.max = nullptr;
     if (meta_data.__isset.statistics) {
       stats_.null_count = meta_data.statistics.null_count;
       stats_.distinct_count = meta_data.statistics.distinct_count;
@@ -58,6 +89,26 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
 
   inline const ColumnStatistics& statistics() const { return stats_; }
 
+  template <typename DType>
+  TypedStatistics<DType> typed_statistics(int type_length) {
+    if (type() != DType::type_num) {
+      throw ParquetException("Statistics requested for the wrong physical type");
+    }
+    const format::ColumnMetaData& meta_data = column_->meta_data;
+    if (!meta_data.__isset.statistics) {
+      return TypedStatistics<DType>(nullptr, nullptr, -1, type_length);
+    }
+    const format::Statistics& stats = meta_data.statistics;
+    // Unordered statistics still bound a single value
+    bool has_min_max = stats.__isset.min && stats.__isset.max &&
+                       (min_max_ordered_ || stats.min == stats.max);
+    return TypedStatistics<DType>(has_min_max ? &stats.min : nullptr,
+        has_min_max ? &stats.max : nullptr,
+        stats.__isset.null_count ? stats.null_count : -1, type_length);
+  }
+
+  inline bool min_max_ordered() const { return min_max_ordered_; }
+
   inline Compression::type compression() const {
     return FromThrift(column_->meta_data.codec);
   }
@@ -89,16 +140,20 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
  private:
   ColumnStatistics stats_;
   std::vector<Encoding::type> encodings_;
+  bool min_max_ordered_;
   const format::ColumnChunk* column_;
 };
 
-std::unique_ptr<ColumnChunkMetaData> ColumnChunkMetaData::Make(const uint8_t* metadata) {
-  return std::unique_ptr<ColumnChunkMetaData>(new ColumnChunkMetaData(metadata));
+std::unique_ptr<ColumnChunkMetaData> ColumnChunkMetaData::Make(
+    const uint8_t* metadata, const std::string* created_by) {
+  return std::unique_ptr<ColumnChunkMetaData>(
+      new ColumnChunkMetaData(metadata, created_by));
 }
 
-ColumnChunkMetaData::ColumnChunkMetaData(const uint8_t* metadata)
+ColumnChunkMetaData::ColumnChunkMetaData(
+    const uint8_t* metadata, const std::string* created_by)
     : impl_{std::unique_ptr<ColumnChunkMetaDataImpl>(new ColumnChunkMetaDataImpl(
-          reinterpret_cast<const format::ColumnChunk*>(metadata)))} {}
+          reinterpret_cast<const format::ColumnChunk*>(metadata), created_by))} {}
 ColumnChunkMetaData::~ColumnChunkMetaData() {}
 
 // column chunk
@@ -127,10 +182,36 @@ const ColumnStatistics& ColumnChunkMetaData::statistics() const {
   return impl_->statistics();
 }
 
+template <typename DType>
+TypedStatistics<DType> ColumnChunkMetaData::typed_statistics(int type_length) const {
+  return impl_->typed_statistics<DType>(type_length);
+}
+
+template TypedStatistics<BooleanType> ColumnChunkMetaData::typed_statistics<BooleanType>(
+    int type_length) const;
+template TypedStatistics<Int32Type> ColumnChunkMetaData::typed_statistics<Int32Type>(
+    int type_length) const;
+template TypedStatistics<Int64Type> ColumnChunkMetaData::typed_statistics<Int64Type>(
+    int type_length) const;
+template TypedStatistics<Int96Type> ColumnChunkMetaData::typed_statistics<Int96Type>(
+    int type_length) const;
+template TypedStatistics<FloatType> ColumnChunkMetaData::typed_statistics<FloatType>(
+    int type_length) const;
+template TypedStatistics<DoubleType> ColumnChunkMetaData::typed_statistics<DoubleType>(
+    int type_length) const;
+template TypedStatistics<ByteArrayType>
+ColumnChunkMetaData::typed_statistics<ByteArrayType>(int type_length) const;
+template TypedStatistics<FLBAType> ColumnChunkMetaData::typed_statistics<FLBAType>(
+    int type_length) const;
+
 bool ColumnChunkMetaData::is_stats_set() const {
   return impl_->is_stats_set();
 }
 
+bool ColumnChunkMetaData::min_max_ordered() const {
+  return impl_->min_max_ordered();
+}
+
 int64_t ColumnChunkMetaData::has_dictionary_page() const {
   return impl_->has_dictionary_page();
 }
@@ -166,12 +247,22 @@ int64_t ColumnChunkMetaData::total_compressed_size() const {
 // row-group metadata
 class RowGroupMetaData::RowGroupMetaDataImpl {
  public:
-  explicit RowGroupMetaDataImpl(
-      const format::RowGroup* row_group, const SchemaDescriptor* schema)
-      : row_group_(row_group), schema_(schema) {}
+  RowGroupMetaDataImpl(const format::RowGroup* row_group, const SchemaDescriptor* schema,
+      const std::string* created_by, const uint8_t* serialized_metadata = nullptr,
+      const std::vector<SerializedRange>* serialized_columns = nullptr)
+      : row_group_(row_group),
+        schema_(schema),
+        created_by_(created_by),
+        serialized_metadata_(serialized_metadata),
+        serialized_columns_(serialized_columns) {
+    column_chunks_.resize(num_columns());
+    if (serialized_columns_) { decoded_columns_.resize(num_columns()); }
+  }
   ~RowGroupMetaDataImpl() {}
 
-  inline int num_columns() const { return row_group_->columns.size(); }
+  inline int num_columns() const {
+    return serialized_columns_ ? serialized_columns_->size() : row_group_->columns.size();
+  }
 
   inline int64_t num_rows() const { return row_group_->num_rows; }
 
@@ -179,31 +270,67 @@ class RowGroupMetaData::RowGroupMetaDataImpl {
 
   inline const SchemaDescriptor* schema() const { return schema_; }
 
-  std::unique_ptr<ColumnChunkMetaData> ColumnChunk(int i) {
+  const ColumnChunkMetaData* ColumnChunk(int i) {
     if (!(i < num_columns())) {
       std::stringstream ss;
       ss << "The file only has " << num_columns()
          << " columns, requested metadata for column: " << i;
       throw ParquetException(ss.str());
     }
-    return ColumnChunkMetaData::Make(
-        reinterpret_cast<const uint8_t*>(&row_group_->columns[i]));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!column_chunks_[i]) {
+      const format::ColumnChunk* column;
+      if (serialized_columns_) {
+        const SerializedRange& range = (*serialized_columns_)[i];
+        uint32_t length = range.length;
+        decoded_columns_[i].reset(new format::ColumnChunk);
+        DeserializeThriftMsg(
+            serialized_metadata_ + range.offset, &length, decoded_columns_[i].get());
+        column = decoded_columns_[i].get();
+      } else {
+        column = &row_group_->columns[i];
+      }
+      column_chunks_[i] = ColumnChunkMetaData::Make(
+          reinterpret_cast<const uint8_t*>(column), created_by_);
+    }
+    return column_chunks_[i].get();
   }
 
  private:
   const format::RowGroup* row_group_;
   const SchemaDescriptor* schema_;
+  const std::string* created_by_;
+
+  // Only set for lazily deserialized metadata
+  const uint8_t* serialized_metadata_;
+  const std::vector<SerializedRange>* serialized_columns_;
+  std::vector<std::unique_ptr<format::ColumnChunk>> decoded_columns_;
+
+  // Guards the accessors created on first use, as metadata may be shared
+  // between threads
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ColumnChunkMetaData>> column_chunks_;
 };
 
-std::unique_ptr<RowGroupMetaData> RowGroupMetaData::Make(
-    const uint8_t* metadata, const SchemaDescriptor* schema) {
-  return std::unique_ptr<RowGroupMetaData>(new RowGroupMetaData(metadata, schema));
+std::unique_ptr<RowGroupMetaData> RowGroupMetaData::Make(const uint8_t* metadata,
+    const SchemaDescriptor* schema, const std::string* created_by) {
+  return std::unique_ptr<RowGroupMetaData>(
+      new RowGroupMetaData(metadata, schema, created_by));
 }
 
-RowGroupMetaData::RowGroupMetaData(
-    const uint8_t* metadata, const SchemaDescriptor* schema)
+RowGroupMetaData::RowGroupMetaData(const uint8_t* metadata,
+    const SchemaDescriptor* schema, const std::string* created_by)
     : impl_{std::unique_ptr<RowGroupMetaDataImpl>(new RowGroupMetaDataImpl(
-          reinterpret_cast<const format::RowGroup*>(metadata), schema))} {}
+          reinterpret_cast<const format::RowGroup*>(metadata), schema, created_by))} {}
+
+RowGroupMetaData::RowGroupMetaData(const uint8_t* metadata,
+    const SchemaDescriptor* schema, const std::string* created_by,
+    const uint8_t* serialized_metadata, const std::vector<SerializedRange>* columns)
+    : impl_{std::unique_ptr<RowGroupMetaDataImpl>(
+          new RowGroupMetaDataImpl(reinterpret_cast<const format::RowGroup*>(metadata),
+              schema, created_by, serialized_metadata, columns))} {}
+
 RowGroupMetaData::~RowGroupMetaData() {}
 
 int RowGroupMetaData::num_columns() const {
@@ -222,18 +349,163 @@ const SchemaDescriptor* RowGroupMetaData::schema() const {
   return impl_->schema();
 }
 
-std::unique_ptr<ColumnChunkMetaData> RowGroupMetaData::ColumnChunk(int i) const {
+const ColumnChunkMetaData* RowGroupMetaData::ColumnChunk(int i) const {
   return impl_->ColumnChunk(i);
 }
 
+// Deserializes a format::FileMetaData like its generated read() method, except
+// that the column chunks of each row group are skipped over. Their positions
+// are recorded instead so they can be deserialized on their own later.
+//
+// Compact protocol field ids are delta encoded within their enclosing struct
+// only, so every column chunk can be decoded starting from its own offset
+class LazyFileMetaDataReader {
+ public:
+  LazyFileMetaDataReader(const uint8_t* metadata, uint32_t* metadata_len)
+      : metadata_len_(metadata_len) {
+    transport_.reset(new apache::thrift::transport::TMemoryBuffer(
+        const_cast<uint8_t*>(metadata), *metadata_len));
+    apache::thrift::protocol::TCompactProtocolFactoryT<
+        apache::thrift::transport::TMemoryBuffer> protocol_factory;
+    protocol_ = protocol_factory.getProtocol(transport_);
+  }
+
+  void Read(format::FileMetaData* metadata,
+      std::vector<std::vector<SerializedRange>>* serialized_columns) {
+    try {
+      ReadFileMetaData(metadata, serialized_columns);
+    } catch (std::exception& e) {
+      std::stringstream ss;
+      ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+      throw ParquetException(ss.str());
+    }
+    *metadata_len_ = position();
+  }
+
+ private:
+  typedef apache::thrift::protocol::TType TType;
+
+  uint32_t position() const { return *metadata_len_ - transport_->available_read(); }
+
+  // Reads a list of structs with their generated read() method
+  template <typename T>
+  void ReadList(std::vector<T>* out) {
+    TType elem_type;
+    uint32_t size;
+    protocol_->readListBegin(elem_type, size);
+    out->resize(size);
+    for (uint32_t i = 0; i < size; ++i) {
+      (*out)[i].read(protocol_.get());
+    }
+    protocol_->readListEnd();
+  }
+
+  void ReadRowGroup(
+      format::RowGroup* row_group, std::vector<SerializedRange>* serialized_columns) {
+    std::string name;
+    TType field_type;
+    int16_t field_id;
+    protocol_->readStructBegin(name);
+    while (true) {
+      protocol_->readFieldBegin(name, field_type, field_id);
+      if (field_type == apache::thrift::protocol::T_STOP) { break; }
+      if (field_id == 1 && field_type == apache::thrift::protocol::T_LIST) {
+        TType elem_type;
+        uint32_t size;
+        protocol_->readListBegin(elem_type, size);
+        serialized_columns->resize(size);
+        for (uint32_t i = 0; i < size; ++i) {
+          uint32_t start = position();
+          protocol_->skip(elem_type);
+          (*serialized_columns)[i] = {start, position() - start};
+        }
+        protocol_->readListEnd();
+        row_group->__isset.columns = true;
+      } else if (field_id == 2 && field_type == apache::thrift::protocol::T_I64) {
+        protocol_->readI64(row_group->total_byte_size);
+        row_group->__isset.total_byte_size = true;
+      } else if (field_id == 3 && field_type == apache::thrift::protocol::T_I64) {
+        protocol_->readI64(row_group->num_rows);
+        row_group->__isset.num_rows = true;
+      } else if (field_id == 4 && field_type == apache::thrift::protocol::T_LIST) {
+        ReadList(&row_group->sorting_columns);
+        row_group->__isset.sorting_columns = true;
+      } else {
+        protocol_->skip(field_type);
+      }
+      protocol_->readFieldEnd();
+    }
+    protocol_->readStructEnd();
+  }
+
+  void ReadFileMetaData(format::FileMetaData* metadata,
+      std::vector<std::vector<SerializedRange>>* serialized_columns) {
+    std::string name;
+    TType field_type;
+    int16_t field_id;
+    protocol_->readStructBegin(name);
+    while (true) {
+      protocol_->readFieldBegin(name, field_type, field_id);
+      if (field_type == apache::thrift::protocol::T_STOP) { break; }
+      if (field_id == 1 && field_type == apache::thrift::protocol::T_I32) {
+        protocol_->readI32(metadata->version);
+        metadata->__isset.version = true;
+      } else if (field_id == 2 && field_type == apache::thrift::protocol::T_LIST) {
+        ReadList(&metadata->schema);
+        metadata->__isset.schema = true;
+      } else if (field_id == 3 && field_type == apache::thrift::protocol::T_I64) {
+        protocol_->readI64(metadata->num_rows);
+        metadata->__isset.num_rows = true;
+      } else if (field_id == 4 && field_type == apache::thrift::protocol::T_LIST) {
+        TType elem_type;
+        uint32_t size;
+        protocol_->readListBegin(elem_type, size);
+        metadata->row_groups.resize(size);
+        serialized_columns->resize(size);
+        for (uint32_t i = 0; i < size; ++i) {
+          ReadRowGroup(&metadata->row_groups[i], &(*serialized_columns)[i]);
+        }
+        protocol_->readListEnd();
+        metadata->__isset.row_groups = true;
+      } else if (field_id == 5 && field_type == apache::thrift::protocol::T_LIST) {
+        ReadList(&metadata->key_value_metadata);
+        metadata->__isset.key_value_metadata = true;
+      } else if (field_id == 6 && field_type == apache::thrift::protocol::T_STRING) {
+        protocol_->readString(metadata->created_by);
+        metadata->__isset.created_by = true;
+      } else {
+        protocol_->skip(field_type);
+      }
+      protocol_->readFieldEnd();
+    }
+    protocol_->readStructEnd();
+
+    if (!metadata->__isset.schema || metadata->schema.empty()) {
+      throw ParquetException("File metadata has no schema");
+    }
+  }
+
+  uint32_t* metadata_len_;
+  boost::shared_ptr<apache::thrift::transport::TMemoryBuffer> transport_;
+  boost::shared_ptr<apache::thrift::protocol::TProtocol> protocol_;
+};
+
 // file metadata
 class FileMetaData::FileMetaDataImpl {
  public:
   FileMetaDataImpl() {}
 
-  explicit FileMetaDataImpl(const uint8_t* metadata, uint32_t* metadata_len) {
+  explicit FileMetaDataImpl(const uint8_t* metadata, uint32_t* metadata_len, bool lazy) {
     metadata_.reset(new format::FileMetaData);
-    DeserializeThriftMsg(metadata, metadata_len, metadata_.get());
+    if (lazy) {
+      // Column chunks are deserialized from this copy of the footer on demand
+      serialized_metadata_.assign(metadata, metadata + *metadata_len);
+      LazyFileMetaDataReader reader(serialized_metadata_.data(), metadata_len);
+      reader.Read(metadata_.get(), &serialized_columns_);
+      serialized_metadata_.resize(*metadata_len);
+    } else {
+      DeserializeThriftMsg(metadata, metadata_len, metadata_.get());
+    }
     InitSchema();
   }
   ~FileMetaDataImpl() {}
@@ -245,17 +517,37 @@ class FileMetaData::FileMetaDataImpl {
   inline const std::string& created_by() const { return metadata_->created_by; }
   inline int num_schema_elements() const { return metadata_->schema.size(); }
 
-  void WriteTo(OutputStream* dst) { SerializeThriftMsg(metadata_.get(), 1024, dst); }
+  void WriteTo(OutputStream* dst) {
+    if (is_lazy()) {
+      // The column chunks were never decoded, but the footer is unchanged
+      dst->Write(serialized_metadata_.data(), serialized_metadata_.size());
+    } else {
+      SerializeThriftMsg(metadata_.get(), 1024, dst);
+    }
+  }
 
-  std::unique_ptr<RowGroupMetaData> RowGroup(int i) {
+  const RowGroupMetaData* RowGroup(int i) {
     if (!(i < num_row_groups())) {
       std::stringstream ss;
       ss << "The file only has " << num_row_groups()
          << " row groups, requested metadata for row group: " << i;
       throw ParquetException(ss.str());
     }
-    return RowGroupMetaData::Make(
-        reinterpret_cast<const uint8_t*>(&metadata_->row_groups[i]), &schema_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (row_groups_.empty()) { row_groups_.resize(num_row_groups()); }
+    if (!row_groups_[i]) {
+      auto row_group = reinterpret_cast<const uint8_t*>(&metadata_->row_groups[i]);
+      if (is_lazy()) {
+        row_groups_[i].reset(new RowGroupMetaData(row_group, &schema_,
+            &metadata_->created_by, serialized_metadata_.data(),
+            &serialized_columns_[i]));
+      } else {
+        row_groups_[i] =
+            RowGroupMetaData::Make(row_group, &schema_, &metadata_->created_by);
+      }
+    }
+    return row_groups_[i].get();
   }
 
   const SchemaDescriptor* schema() const { return &schema_; }
@@ -269,23 +561,34 @@ class FileMetaData::FileMetaDataImpl {
     schema_.Init(converter.Convert());
   }
   SchemaDescriptor schema_;
+
+  bool is_lazy() const { return !serialized_metadata_.empty(); }
+
+  // Only set for lazily deserialized metadata
+  std::vector<uint8_t> serialized_metadata_;
+  std::vector<std::vector<SerializedRange>> serialized_columns_;
+
+  // Guards the accessors created on first use, as metadata may be shared
+  // between threads
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<RowGroupMetaData>> row_groups_;
 };
 
 std::unique_ptr<FileMetaData> FileMetaData::Make(
-    const uint8_t* metadata, uint32_t* metadata_len) {
-  return std::unique_ptr<FileMetaData>(new FileMetaData(metadata, metadata_len));
+    const uint8_t* metadata, uint32_t* metadata_len, bool lazy) {
+  return std::unique_ptr<FileMetaData>(new FileMetaData(metadata, metadata_len, lazy));
 }
 
-FileMetaData::FileMetaData(const uint8_t* metadata, uint32_t* metadata_len)
+FileMetaData::FileMetaData(const uint8_t* metadata, uint32_t* metadata_len, bool lazy)
     : impl_{std::unique_ptr<FileMetaDataImpl>(
-          new FileMetaDataImpl(metadata, metadata_len))} {}
+          new FileMetaDataImpl(metadata, metadata_len, lazy))} {}
 
 FileMetaData::FileMetaData()
     : impl_{std::unique_ptr<FileMetaDataImpl>(new FileMetaDataImpl())} {}
 
 FileMetaData::~FileMetaData() {}
 
-std::unique_ptr<RowGroupMetaData> FileMetaData::RowGroup(int i) const {
+const RowGroupMetaData* FileMetaData::RowGroup(int i) const {
   return impl_->RowGroup(i);
 }
 
@@ -321,6 +624,74 @@ void FileMetaData::WriteTo(OutputStream* dst) {
   return impl_->WriteTo(dst);
 }
 
+// ----------------------------------------------------------------------
+// FileMetaDataCache
+
+FileMetaDataCache::FileMetaDataCache(int64_t capacity)
+    : capacity_(capacity), hits_(0), misses_(0), evictions_(0) {}
+
+std::shared_ptr<const FileMetaData> FileMetaDataCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void FileMetaDataCache::Put(
+    const std::string& key, const std::shared_ptr<const FileMetaData>& metadata) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->second = metadata;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  entries_.emplace_front(key, metadata);
+  index_[key] = entries_.begin();
+  while (static_cast<int64_t>(entries_.size()) > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
+
+void FileMetaDataCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+}
+
+int64_t FileMetaDataCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+int64_t FileMetaDataCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+int64_t FileMetaDataCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+int64_t FileMetaDataCache::evictions() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return evictions_;
+}
+
+FileMetaDataCache* default_metadata_cache() {
+  static FileMetaDataCache default_cache(DEFAULT_METADATA_CACHE_CAPACITY);
+  return &default_cache;
+}
+
 // MetaData Builders
 // row-group metadata
 class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
@@ -342,10 +713,10 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
   // column metadata
   void SetStatistics(const ColumnStatistics& val) {
     format::Statistics stats;
-    stats.null_count = val.null_count;
-    stats.distinct_count = val.distinct_count;
-    stats.max = *val.max;
-    stats.min = *val.min;
+    stats.__set_null_count(val.null_count);
+    stats.__set_distinct_count(val.distinct_count);
+    if (val.max != nullptr) { stats.__set_max(*val.max); }
+    if (val.min != nullptr) { stats.__set_min(*val.min); }
 
     column_chunk_->meta_data.statistics = stats;
     column_chunk_->meta_data.__isset.statistics = true;
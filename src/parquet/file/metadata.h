@@ -18,11 +18,18 @@
 #ifndef PARQUET_FILE_METADATA_H
 #define PARQUET_FILE_METADATA_H
 
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <set>
 
 #include "parquet/column/properties.h"
+#include "parquet/column/statistics.h"
 #include "parquet/compression/codec.h"
 #include "parquet/schema/descriptor.h"
 #include "parquet/types.h"
@@ -39,10 +46,18 @@ struct ColumnStatistics {
   const std::string* max;
 };
 
+// Older writers ordered the min and max statistics of BYTE_ARRAY and
+// FIXED_LEN_BYTE_ARRAY columns as signed bytes (PARQUET-686). Returns true if
+// created_by names a writer known to order them as unsigned bytes, like
+// StatisticsTraits: parquet-mr 1.10.0 and parquet-cpp 1.3.0 onwards
+PARQUET_EXPORT bool HasUnsignedBinaryStatistics(const std::string& created_by);
+
 class PARQUET_EXPORT ColumnChunkMetaData {
  public:
-  // API convenience to get a MetaData accessor
-  static std::unique_ptr<ColumnChunkMetaData> Make(const uint8_t* metadata);
+  // API convenience to get a MetaData accessor. created_by is the writer of the
+  // file, nullptr if it is not known
+  static std::unique_ptr<ColumnChunkMetaData> Make(
+      const uint8_t* metadata, const std::string* created_by = nullptr);
 
   ~ColumnChunkMetaData();
 
@@ -56,6 +71,15 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   std::shared_ptr<schema::ColumnPath> path_in_schema() const;
   bool is_stats_set() const;
   const ColumnStatistics& statistics() const;
+  // The statistics decoded for the physical type DType, which must match type().
+  // type_length is only used for FIXED_LEN_BYTE_ARRAY columns. A min and max
+  // which are not min_max_ordered() are left out unless they are equal
+  template <typename DType>
+  TypedStatistics<DType> typed_statistics(int type_length = -1) const;
+  // False if the min and max statistics of the chunk and of its data pages may
+  // not be ordered like StatisticsTraits, i.e. for BYTE_ARRAY and
+  // FIXED_LEN_BYTE_ARRAY columns unless HasUnsignedBinaryStatistics(created_by)
+  bool min_max_ordered() const;
   Compression::type compression() const;
   const std::vector<Encoding::type>& encodings() const;
   int64_t has_dictionary_page() const;
@@ -66,17 +90,24 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   int64_t total_uncompressed_size() const;
 
  private:
-  explicit ColumnChunkMetaData(const uint8_t* metadata);
+  ColumnChunkMetaData(const uint8_t* metadata, const std::string* created_by);
   // PIMPL Idiom
   class ColumnChunkMetaDataImpl;
   std::unique_ptr<ColumnChunkMetaDataImpl> impl_;
 };
 
+// Position of a serialized Thrift message within the file footer
+struct SerializedRange {
+  uint32_t offset;
+  uint32_t length;
+};
+
 class PARQUET_EXPORT RowGroupMetaData {
  public:
-  // API convenience to get a MetaData accessor
-  static std::unique_ptr<RowGroupMetaData> Make(
-      const uint8_t* metadata, const SchemaDescriptor* schema);
+  // API convenience to get a MetaData accessor. created_by is the writer of the
+  // file, nullptr if it is not known
+  static std::unique_ptr<RowGroupMetaData> Make(const uint8_t* metadata,
+      const SchemaDescriptor* schema, const std::string* created_by = nullptr);
 
   ~RowGroupMetaData();
 
@@ -86,10 +117,17 @@ class PARQUET_EXPORT RowGroupMetaData {
   int64_t total_byte_size() const;
   // Return const-pointer to make it clear that this object is not to be copied
   const SchemaDescriptor* schema() const;
-  std::unique_ptr<ColumnChunkMetaData> ColumnChunk(int i) const;
+  // The accessor is created on first use and owned by the RowGroupMetaData
+  const ColumnChunkMetaData* ColumnChunk(int i) const;
 
  private:
-  explicit RowGroupMetaData(const uint8_t* metadata, const SchemaDescriptor* schema);
+  friend class FileMetaData;
+  RowGroupMetaData(const uint8_t* metadata, const SchemaDescriptor* schema,
+      const std::string* created_by);
+  // Column chunks are deserialized from the given footer ranges on first use
+  RowGroupMetaData(const uint8_t* metadata, const SchemaDescriptor* schema,
+      const std::string* created_by, const uint8_t* serialized_metadata,
+      const std::vector<SerializedRange>* columns);
   // PIMPL Idiom
   class RowGroupMetaDataImpl;
   std::unique_ptr<RowGroupMetaDataImpl> impl_;
@@ -100,8 +138,12 @@ class FileMetaDataBuilder;
 class PARQUET_EXPORT FileMetaData {
  public:
   // API convenience to get a MetaData accessor
+  //
+  // With lazy set, the column chunks of every row group are skipped over
+  // during deserialization and decoded individually when first accessed, so
+  // the cost of reading a projection does not grow with the schema width
   static std::unique_ptr<FileMetaData> Make(
-      const uint8_t* serialized_metadata, uint32_t* metadata_len);
+      const uint8_t* serialized_metadata, uint32_t* metadata_len, bool lazy = false);
 
   ~FileMetaData();
 
@@ -112,7 +154,8 @@ class PARQUET_EXPORT FileMetaData {
   int32_t version() const;
   const std::string& created_by() const;
   int num_schema_elements() const;
-  std::unique_ptr<RowGroupMetaData> RowGroup(int i) const;
+  // The accessor is created on first use and owned by the FileMetaData
+  const RowGroupMetaData* RowGroup(int i) const;
 
   void WriteTo(OutputStream* dst);
 
@@ -121,13 +164,56 @@ class PARQUET_EXPORT FileMetaData {
 
  private:
   friend FileMetaDataBuilder;
-  explicit FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len);
+  FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len, bool lazy);
   // PIMPL Idiom
   FileMetaData();
   class FileMetaDataImpl;
   std::unique_ptr<FileMetaDataImpl> impl_;
 };
 
+// Thread-safe LRU cache of deserialized file metadata, holding at most
+// capacity entries. Readers of the same immutable file share one FileMetaData
+// instead of decoding the footer again. Keys identify a file version, e.g. its
+// path, size and modification time
+class PARQUET_EXPORT FileMetaDataCache {
+ public:
+  explicit FileMetaDataCache(int64_t capacity);
+
+  // Returns nullptr if the key is not cached
+  std::shared_ptr<const FileMetaData> Get(const std::string& key);
+
+  void Put(const std::string& key, const std::shared_ptr<const FileMetaData>& metadata);
+
+  void Clear();
+
+  int64_t capacity() const { return capacity_; }
+  int64_t size() const;
+
+  int64_t hits() const;
+  int64_t misses() const;
+  int64_t evictions() const;
+
+ private:
+  typedef std::pair<std::string, std::shared_ptr<const FileMetaData>> Entry;
+
+  const int64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Most recently used entry first
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+
+  int64_t hits_;
+  int64_t misses_;
+  int64_t evictions_;
+};
+
+// 1024 files
+static constexpr int64_t DEFAULT_METADATA_CACHE_CAPACITY = 1024;
+
+// Process-wide cache with DEFAULT_METADATA_CACHE_CAPACITY entries
+PARQUET_EXPORT FileMetaDataCache* default_metadata_cache();
+
 // Builder API
 class PARQUET_EXPORT ColumnChunkMetaDataBuilder {
  public:
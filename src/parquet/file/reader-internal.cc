@@ -34,6 +34,7 @@
 #include "parquet/types.h"
 #include "parquet/util/buffer.h"
 #include "parquet/util/input.h"
+#include "parquet/util/logging.h"
 
 namespace parquet {
 
@@ -43,67 +44,199 @@ namespace parquet {
 
 SerializedPageReader::SerializedPageReader(std::unique_ptr<InputStream> stream,
     Compression::type codec_type, MemoryAllocator* allocator)
-    : stream_(std::move(stream)), decompression_buffer_(0, allocator) {
+    : stream_(std::move(stream)),
+      decompression_buffer_(0, allocator),
+      allocator_(allocator),
+      pipeline_depth_(0),
+      pages_produced_(0),
+      pages_consumed_(0),
+      pipeline_done_(false),
+      pipeline_stop_(false),
+      min_max_ordered_(true),
+      pruned_pages_(0),
+      pruned_values_(0),
+      pruned_bytes_(0) {
   max_page_header_size_ = DEFAULT_MAX_PAGE_HEADER_SIZE;
   decompressor_ = Codec::Create(codec_type);
 }
 
+SerializedPageReader::~SerializedPageReader() {
+  if (pipeline_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(pipeline_mutex_);
+      pipeline_stop_ = true;
+    }
+    pipeline_cv_.notify_all();
+    pipeline_thread_.join();
+  }
+}
+
 std::shared_ptr<Page> SerializedPageReader::NextPage() {
+  if (pipeline_depth_ > 0 && decompressor_ != NULL) { return NextPipelinedPage(); }
+  return ReadPage(&decompression_buffer_);
+}
+
+std::shared_ptr<Page> SerializedPageReader::NextPipelinedPage() {
+  std::unique_lock<std::mutex> lock(pipeline_mutex_);
+  if (!pipeline_thread_.joinable() && !pipeline_done_) {
+    for (int i = 0; i <= pipeline_depth_; ++i) {
+      page_buffers_.emplace_back(new OwnedMutableBuffer(0, allocator_));
+    }
+    pipeline_thread_ = std::thread(&SerializedPageReader::PipelineWorker, this);
+  }
+
+  pipeline_cv_.wait(lock, [this]() { return !ready_pages_.empty() || pipeline_done_; });
+  if (ready_pages_.empty()) {
+    if (pipeline_error_) { std::rethrow_exception(pipeline_error_); }
+    return std::shared_ptr<Page>(nullptr);
+  }
+
+  std::shared_ptr<Page> page = ready_pages_.front();
+  ready_pages_.pop_front();
+  // The page returned by the previous call is released, so its buffer may
+  // now be refilled
+  ++pages_consumed_;
+  pipeline_cv_.notify_all();
+  return page;
+}
+
+void SerializedPageReader::PipelineWorker() {
+  std::unique_lock<std::mutex> lock(pipeline_mutex_);
+  while (true) {
+    // The caller still holds page pages_consumed_ - 1, so pages up to
+    // pages_consumed_ + pipeline_depth_ - 1 can be decompressed without
+    // touching its buffer
+    pipeline_cv_.wait(lock, [this]() {
+      return pipeline_stop_ || pages_produced_ < pages_consumed_ + pipeline_depth_;
+    });
+    if (pipeline_stop_) { return; }
+
+    OwnedMutableBuffer* buffer =
+        page_buffers_[pages_produced_ % page_buffers_.size()].get();
+    lock.unlock();
+
+    std::shared_ptr<Page> page;
+    std::exception_ptr error;
+    try {
+      page = ReadPage(buffer);
+    } catch (...) { error = std::current_exception(); }
+
+    lock.lock();
+    if (!page) {
+      pipeline_error_ = error;
+      pipeline_done_ = true;
+      pipeline_cv_.notify_all();
+      return;
+    }
+    ready_pages_.push_back(page);
+    ++pages_produced_;
+    pipeline_cv_.notify_all();
+  }
+}
+
+PagePruningStats SerializedPageReader::pruning_stats() const {
+  return PagePruningStats{pruned_pages_, pruned_values_, pruned_bytes_};
+}
+
+int64_t SerializedPageReader::SkipPage(int64_t max_values) {
+  if (pipeline_depth_ > 0 && decompressor_ != NULL) { return 0; }
+
+  uint32_t header_size = 0;
+  if (!PeekPageHeader(&header_size)) { return 0; }
+  if (current_page_header_.type != format::PageType::DATA_PAGE) { return 0; }
+
+  int64_t num_values = current_page_header_.data_page_header.num_values;
+  if (num_values == 0 || num_values > max_values) { return 0; }
+
+  // The header is parsed again by NextPage if the page is not skipped
+  stream_->Advance(header_size + current_page_header_.compressed_page_size);
+  return num_values;
+}
+
+bool SerializedPageReader::PeekPageHeader(uint32_t* header_size) {
+  int64_t bytes_available = 0;
+  uint32_t allowed_page_size = DEFAULT_PAGE_HEADER_SIZE;
+
+  // Page headers can be very large because of page statistics
+  // We try to deserialize a larger buffer progressively
+  // until a maximum allowed header limit
+  while (true) {
+    const uint8_t* buffer = stream_->Peek(allowed_page_size, &bytes_available);
+    if (bytes_available == 0) { return false; }
+
+    // This gets used, then set by DeserializeThriftMsg
+    *header_size = bytes_available;
+    try {
+      DeserializeThriftMsg(buffer, header_size, &current_page_header_);
+      return true;
+    } catch (std::exception& e) {
+      // Failed to deserialize. Double the allowed page header size and try again
+      std::stringstream ss;
+      ss << e.what();
+      allowed_page_size *= 2;
+      if (allowed_page_size > max_page_header_size_) {
+        ss << "Deserializing page header failed.\n";
+        throw ParquetException(ss.str());
+      }
+    }
+  }
+}
+
+std::shared_ptr<Page> SerializedPageReader::ReadPage(
+    OwnedMutableBuffer* decompression_buffer) {
   // Loop here because there may be unhandled page types that we skip until
   // finding a page that we do know what to do with
   while (true) {
     int64_t bytes_read = 0;
-    int64_t bytes_available = 0;
     uint32_t header_size = 0;
     const uint8_t* buffer;
-    uint32_t allowed_page_size = DEFAULT_PAGE_HEADER_SIZE;
-
-    // Page headers can be very large because of page statistics
-    // We try to deserialize a larger buffer progressively
-    // until a maximum allowed header limit
-    while (true) {
-      buffer = stream_->Peek(allowed_page_size, &bytes_available);
-      if (bytes_available == 0) { return std::shared_ptr<Page>(nullptr); }
-
-      // This gets used, then set by DeserializeThriftMsg
-      header_size = bytes_available;
-      try {
-        DeserializeThriftMsg(buffer, &header_size, &current_page_header_);
-        break;
-      } catch (std::exception& e) {
-        // Failed to deserialize. Double the allowed page header size and try again
-        std::stringstream ss;
-        ss << e.what();
-        allowed_page_size *= 2;
-        if (allowed_page_size > max_page_header_size_) {
-          ss << "Deserializing page header failed.\n";
-          throw ParquetException(ss.str());
-        }
-      }
-    }
+
+    if (!PeekPageHeader(&header_size)) { return std::shared_ptr<Page>(nullptr); }
     // Advance the stream offset
     stream_->Advance(header_size);
 
     int compressed_len = current_page_header_.compressed_page_size;
     int uncompressed_len = current_page_header_.uncompressed_page_size;
 
-    // Read the compressed data page.
-    buffer = stream_->Read(compressed_len, &bytes_read);
-    if (bytes_read != compressed_len) ParquetException::EofException();
+    if (data_page_filter_ && current_page_header_.type == format::PageType::DATA_PAGE &&
+        current_page_header_.data_page_header.__isset.statistics) {
+      const format::DataPageHeader& header = current_page_header_.data_page_header;
+      const format::Statistics& stats = header.statistics;
+      // Unordered statistics still bound a single value
+      bool has_min_max = min_max_ordered_ ||
+                         (stats.__isset.min && stats.__isset.max &&
+                             stats.min == stats.max);
+      if (has_min_max && !data_page_filter_(stats.__isset.min ? &stats.min : nullptr,
+                             stats.__isset.max ? &stats.max : nullptr)) {
+        stream_->Advance(compressed_len);
+        ++pruned_pages_;
+        pruned_values_ += header.num_values;
+        pruned_bytes_ += compressed_len;
+        continue;
+      }
+    }
 
-    // Uncompress it if we need to
+    std::shared_ptr<Buffer> page_buffer;
     if (decompressor_ != NULL) {
+      // Read the compressed data page.
+      buffer = stream_->Read(compressed_len, &bytes_read);
+      if (bytes_read != compressed_len) ParquetException::EofException();
+
       // Grow the uncompressed buffer if we need to.
-      if (uncompressed_len > static_cast<int>(decompression_buffer_.size())) {
-        decompression_buffer_.Resize(uncompressed_len);
+      if (uncompressed_len > static_cast<int>(decompression_buffer->size())) {
+        decompression_buffer->Resize(uncompressed_len);
       }
       decompressor_->Decompress(
-          compressed_len, buffer, uncompressed_len, &decompression_buffer_[0]);
-      buffer = &decompression_buffer_[0];
+          compressed_len, buffer, uncompressed_len, decompression_buffer->mutable_data());
+      page_buffer =
+          std::make_shared<Buffer>(decompression_buffer->data(), uncompressed_len);
+    } else {
+      // Uncompressed pages are slices of the stream's memory where possible, so
+      // column readers can hand out views into them (see ReadBatchView)
+      page_buffer = stream_->ReadBuffer(compressed_len);
+      if (page_buffer->size() != compressed_len) ParquetException::EofException();
     }
 
-    auto page_buffer = std::make_shared<Buffer>(buffer, uncompressed_len);
-
     if (current_page_header_.type == format::PageType::DICTIONARY_PAGE) {
       const format::DictionaryPageHeader& dict_header =
           current_page_header_.dictionary_page_header;
@@ -120,9 +253,9 @@ std::shared_ptr<Page> SerializedPageReader::NextPage() {
           FromThrift(header.repetition_level_encoding));
 
       if (header.__isset.statistics) {
-        const format::Statistics stats = header.statistics;
-        if (stats.__isset.max) { page->max_ = stats.max; }
-        if (stats.__isset.min) { page->min_ = stats.min; }
+        const format::Statistics& stats = header.statistics;
+        page->SetStatistics(stats.__isset.min ? &stats.min : nullptr,
+            stats.__isset.max ? &stats.max : nullptr);
       }
       return page;
     } else if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
@@ -142,29 +275,195 @@ std::shared_ptr<Page> SerializedPageReader::NextPage() {
 }
 
 const RowGroupMetaData* SerializedRowGroup::metadata() const {
-  return row_group_metadata_.get();
+  return row_group_metadata_;
 }
 
 const ReaderProperties* SerializedRowGroup::properties() const {
   return &properties_;
 }
 
-std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReader(int i) {
-  // Read column chunk from the file
+ReadRange SerializedRowGroup::ColumnChunkRange(int i) const {
   auto col = row_group_metadata_->ColumnChunk(i);
 
   int64_t col_start = col->data_page_offset();
   if (col->has_dictionary_page() && col_start > col->dictionary_page_offset()) {
     col_start = col->dictionary_page_offset();
   }
+  return {col_start, col->total_compressed_size()};
+}
+
+std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReader(int i) {
+  // Read column chunk from the file
+  auto col = row_group_metadata_->ColumnChunk(i);
 
-  int64_t bytes_to_read = col->total_compressed_size();
   std::unique_ptr<InputStream> stream;
 
-  stream = properties_.GetStream(source_, col_start, bytes_to_read);
+  auto it = prefetched_chunks_.find(i);
+  if (it != prefetched_chunks_.end()) {
+    stream.reset(new InMemoryInputStream(it->second));
+    prefetched_chunks_.erase(it);
+  } else {
+    ReadRange range = ColumnChunkRange(i);
+    stream = properties_.GetStream(source_, range.offset, range.length);
+  }
 
-  return std::unique_ptr<PageReader>(new SerializedPageReader(
+  std::unique_ptr<SerializedPageReader> page_reader(new SerializedPageReader(
       std::move(stream), col->compression(), properties_.allocator()));
+  page_reader->set_pipeline_depth(properties_.page_pipeline_depth());
+  page_reader->set_min_max_ordered(col->min_max_ordered());
+  return std::move(page_reader);
+}
+
+void SerializedRowGroup::Prefetch(const std::vector<int>& column_indices) {
+  std::vector<ReadRange> column_ranges;
+  for (int i : column_indices) {
+    column_ranges.push_back(ColumnChunkRange(i));
+  }
+
+  std::vector<ReadRange> read_ranges = CoalesceReadRanges(column_ranges,
+      properties_.prefetch_hole_size_limit(), properties_.prefetch_range_size_limit());
+
+  std::vector<std::shared_ptr<Buffer>> read_buffers;
+  for (const ReadRange& range : read_ranges) {
+    std::shared_ptr<Buffer> buffer = source_->ReadAt(range.offset, range.length);
+    if (buffer->size() < range.length) {
+      throw ParquetException("Unable to read column chunk data");
+    }
+    read_buffers.push_back(buffer);
+  }
+
+  // Serve each column chunk as a slice of the coalesced read that contains it
+  for (size_t k = 0; k < column_indices.size(); ++k) {
+    const ReadRange& column_range = column_ranges[k];
+    auto it = std::upper_bound(read_ranges.begin(), read_ranges.end(), column_range,
+        [](const ReadRange& a, const ReadRange& b) { return a.offset < b.offset; });
+    DCHECK(it != read_ranges.begin());
+    size_t read_index = (it - read_ranges.begin()) - 1;
+
+    prefetched_chunks_[column_indices[k]] = std::make_shared<Buffer>(
+        read_buffers[read_index], column_range.offset - read_ranges[read_index].offset,
+        column_range.length);
+  }
+}
+
+std::shared_ptr<Buffer> SerializedRowGroup::ColumnChunkBuffer(int i) {
+  auto it = prefetched_chunks_.find(i);
+  if (it != prefetched_chunks_.end()) {
+    std::shared_ptr<Buffer> buffer = it->second;
+    prefetched_chunks_.erase(it);
+    return buffer;
+  }
+
+  ReadRange range = ColumnChunkRange(i);
+  std::shared_ptr<Buffer> buffer = source_->ReadAt(range.offset, range.length);
+  if (buffer->size() < range.length) {
+    throw ParquetException("Unable to read column chunk data");
+  }
+  return buffer;
+}
+
+// Location of a serialized page, header included, within its column chunk
+struct PageLocation {
+  int64_t offset;
+  int64_t length;
+  format::PageType::type type;
+  int64_t num_values;
+};
+
+// Deserializes only the page headers of a column chunk to find its pages
+static std::vector<PageLocation> ScanPageHeaders(
+    const Buffer& chunk, uint32_t max_page_header_size) {
+  std::vector<PageLocation> pages;
+  format::PageHeader page_header;
+  int64_t offset = 0;
+  while (offset < chunk.size()) {
+    uint32_t header_size = static_cast<uint32_t>(
+        std::min<int64_t>(chunk.size() - offset, max_page_header_size));
+    DeserializeThriftMsg(chunk.data() + offset, &header_size, &page_header);
+
+    PageLocation page;
+    page.offset = offset;
+    page.length = header_size + page_header.compressed_page_size;
+    page.type = page_header.type;
+    page.num_values = 0;
+    if (page_header.type == format::PageType::DATA_PAGE) {
+      page.num_values = page_header.data_page_header.num_values;
+    } else if (page_header.type == format::PageType::DATA_PAGE_V2) {
+      page.num_values = page_header.data_page_header_v2.num_values;
+    }
+    if (page.offset + page.length > chunk.size()) { ParquetException::EofException(); }
+
+    pages.push_back(page);
+    offset += page.length;
+  }
+  return pages;
+}
+
+std::vector<PageRun> SerializedRowGroup::GetColumnPageRuns(int i, int max_runs) {
+  auto col = row_group_metadata_->ColumnChunk(i);
+  std::shared_ptr<Buffer> chunk = ColumnChunkBuffer(i);
+  std::vector<PageLocation> pages = ScanPageHeaders(*chunk, DEFAULT_MAX_PAGE_HEADER_SIZE);
+
+  auto page_buffer = [&chunk](const PageLocation& page) {
+    return std::make_shared<Buffer>(chunk, page.offset, page.length);
+  };
+
+  // The dictionary page, if any, comes first and is replayed ahead of every run
+  std::shared_ptr<Buffer> dictionary_page;
+  size_t first_page = 0;
+  if (!pages.empty() && pages[0].type == format::PageType::DICTIONARY_PAGE) {
+    dictionary_page = page_buffer(pages[0]);
+    first_page = 1;
+  }
+
+  int64_t data_bytes = 0;
+  for (size_t k = first_page; k < pages.size(); ++k) {
+    data_bytes += pages[k].length;
+  }
+  int64_t run_bytes_target = data_bytes / std::max(max_runs, 1);
+
+  std::vector<PageRun> runs;
+  std::vector<std::shared_ptr<Buffer>> run_pages;
+  int64_t run_bytes = 0;
+  int64_t run_values = 0;
+  for (size_t k = first_page; k < pages.size(); ++k) {
+    if (run_pages.empty() && dictionary_page) { run_pages.push_back(dictionary_page); }
+    run_pages.push_back(page_buffer(pages[k]));
+    run_bytes += pages[k].length;
+    run_values += pages[k].num_values;
+
+    bool last_run = static_cast<int>(runs.size()) == max_runs - 1;
+    if (k + 1 == pages.size() || (!last_run && run_bytes >= run_bytes_target)) {
+      PageRun run;
+      run.pager.reset(new PageRunReader(
+          std::move(run_pages), col->compression(), properties_.allocator()));
+      run.num_values = run_values;
+      runs.push_back(std::move(run));
+      run_pages.clear();
+      run_bytes = 0;
+      run_values = 0;
+    }
+  }
+  return runs;
+}
+
+// ----------------------------------------------------------------------
+// PageRunReader
+
+PageRunReader::PageRunReader(std::vector<std::shared_ptr<Buffer>> pages,
+    Compression::type codec, MemoryAllocator* allocator)
+    : pages_(std::move(pages)), next_page_(0), codec_(codec), allocator_(allocator) {}
+
+std::shared_ptr<Page> PageRunReader::NextPage() {
+  while (next_page_ < pages_.size()) {
+    std::unique_ptr<InputStream> stream(new InMemoryInputStream(pages_[next_page_++]));
+    page_readers_.emplace_back(
+        new SerializedPageReader(std::move(stream), codec_, allocator_));
+    // Unknown page types come back as null and are skipped
+    std::shared_ptr<Page> page = page_readers_.back()->NextPage();
+    if (page) { return page; }
+  }
+  return std::shared_ptr<Page>(nullptr);
 }
 
 // ----------------------------------------------------------------------
@@ -174,15 +473,23 @@ static constexpr uint32_t FOOTER_SIZE = 8;
 static constexpr uint8_t PARQUET_MAGIC[4] = {'P', 'A', 'R', '1'};
 
 std::unique_ptr<ParquetFileReader::Contents> SerializedFile::Open(
-    std::unique_ptr<RandomAccessSource> source, ReaderProperties props) {
+    std::unique_ptr<RandomAccessSource> source, ReaderProperties props,
+    const std::string& metadata_cache_key) {
   std::unique_ptr<ParquetFileReader::Contents> result(
       new SerializedFile(std::move(source), props));
 
   // Access private methods here, but otherwise unavailable
   SerializedFile* file = static_cast<SerializedFile*>(result.get());
 
-  // Validates magic bytes, parses metadata, and initializes the SchemaDescriptor
-  file->ParseMetaData();
+  FileMetaDataCache* cache =
+      metadata_cache_key.empty() ? nullptr : props.metadata_cache();
+  if (cache) { file->file_metadata_ = cache->Get(metadata_cache_key); }
+
+  if (!file->file_metadata_) {
+    // Validates magic bytes, parses metadata, and initializes the SchemaDescriptor
+    file->ParseMetaData();
+    if (cache) { cache->Put(metadata_cache_key, file->file_metadata_); }
+  }
 
   return result;
 }
@@ -196,8 +503,8 @@ SerializedFile::~SerializedFile() {
 }
 
 std::shared_ptr<RowGroupReader> SerializedFile::GetRowGroup(int i) {
-  std::unique_ptr<SerializedRowGroup> contents(new SerializedRowGroup(
-      source_.get(), std::move(file_metadata_->RowGroup(i)), properties_));
+  std::unique_ptr<SerializedRowGroup> contents(
+      new SerializedRowGroup(source_.get(), file_metadata_, i, properties_));
 
   return std::make_shared<RowGroupReader>(std::move(contents));
 }
@@ -217,29 +524,40 @@ void SerializedFile::ParseMetaData() {
     throw ParquetException("Corrupted file, smaller than file footer");
   }
 
-  uint8_t footer_buffer[FOOTER_SIZE];
-  source_->Seek(filesize - FOOTER_SIZE);
-  int64_t bytes_read = source_->Read(FOOTER_SIZE, footer_buffer);
-  if (bytes_read != FOOTER_SIZE || memcmp(footer_buffer + 4, PARQUET_MAGIC, 4) != 0) {
+  // Speculatively read the tail of the file, which for most files holds the
+  // metadata as well as the footer. Sources backed by memory return a view
+  // without copying
+  int64_t tail_size =
+      std::min(filesize, std::max<int64_t>(properties_.footer_read_size(), FOOTER_SIZE));
+  std::shared_ptr<Buffer> tail = source_->ReadAt(filesize - tail_size, tail_size);
+  if (tail->size() != tail_size ||
+      memcmp(tail->data() + tail_size - 4, PARQUET_MAGIC, 4) != 0) {
     throw ParquetException("Invalid parquet file. Corrupt footer.");
   }
 
-  uint32_t metadata_len = *reinterpret_cast<uint32_t*>(footer_buffer);
+  uint32_t metadata_len =
+      *reinterpret_cast<const uint32_t*>(tail->data() + tail_size - FOOTER_SIZE);
   int64_t metadata_start = filesize - FOOTER_SIZE - metadata_len;
   if (FOOTER_SIZE + metadata_len > filesize) {
     throw ParquetException(
         "Invalid parquet file. File is less than "
         "file metadata size.");
   }
-  source_->Seek(metadata_start);
 
-  OwnedMutableBuffer metadata_buffer(metadata_len, properties_.allocator());
-  bytes_read = source_->Read(metadata_len, &metadata_buffer[0]);
-  if (bytes_read != metadata_len) {
-    throw ParquetException("Invalid parquet file. Could not read metadata bytes.");
+  std::shared_ptr<Buffer> metadata_buffer;
+  if (FOOTER_SIZE + metadata_len <= tail_size) {
+    metadata_buffer = std::make_shared<Buffer>(
+        tail, tail_size - FOOTER_SIZE - metadata_len, metadata_len);
+  } else {
+    // The metadata is larger than the speculative read
+    metadata_buffer = source_->ReadAt(metadata_start, metadata_len);
+    if (metadata_buffer->size() != metadata_len) {
+      throw ParquetException("Invalid parquet file. Could not read metadata bytes.");
+    }
   }
 
-  file_metadata_ = FileMetaData::Make(&metadata_buffer[0], &metadata_len);
+  file_metadata_ = FileMetaData::Make(metadata_buffer->data(), &metadata_len,
+      properties_.is_lazy_metadata_enabled());
 }
 
 }  // namespace parquet
@@ -18,8 +18,16 @@
 #ifndef PARQUET_FILE_READER_INTERNAL_H
 #define PARQUET_FILE_READER_INTERNAL_H
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "parquet/column/page.h"
@@ -42,19 +50,56 @@ static constexpr uint32_t DEFAULT_PAGE_HEADER_SIZE = 16 * 1024;
 // This subclass delimits pages appearing in a serialized stream, each preceded
 // by a serialized Thrift format::PageHeader indicating the type of each page
 // and the page metadata.
+//
+// With a non-zero pipeline depth, a compressed column chunk is read and
+// decompressed on a background thread up to that many pages ahead of the
+// caller. A page returned by NextPage stays valid until the following call
 class SerializedPageReader : public PageReader {
  public:
   SerializedPageReader(std::unique_ptr<InputStream> stream, Compression::type codec,
       MemoryAllocator* allocator = default_allocator());
 
-  virtual ~SerializedPageReader() {}
+  virtual ~SerializedPageReader();
 
   // Implement the PageReader interface
   virtual std::shared_ptr<Page> NextPage();
 
+  // Pages are only skipped when the column chunk is not read by the pipeline
+  // thread, which may already have decompressed the next pages
+  virtual int64_t SkipPage(int64_t max_values);
+
+  // Applied to data pages with statistics in their header. Rejected pages are
+  // skipped without being decompressed
+  virtual void set_data_page_filter(const DataPageFilter& filter) {
+    data_page_filter_ = filter;
+  }
+
+  // Unless set, page statistics are only given to the data page filter if their
+  // min and max are equal. See ColumnChunkMetaData::min_max_ordered
+  void set_min_max_ordered(bool ordered) { min_max_ordered_ = ordered; }
+
+  // May be called while the pipeline thread is running
+  virtual PagePruningStats pruning_stats() const;
+
   void set_max_page_header_size(uint32_t size) { max_page_header_size_ = size; }
 
+  // Must be set before the first call to NextPage. Has no effect on
+  // uncompressed column chunks
+  void set_pipeline_depth(int depth) { pipeline_depth_ = depth; }
+
  private:
+  // Deserializes the next page header into current_page_header_ without
+  // advancing the stream. Returns false at the end of the stream
+  bool PeekPageHeader(uint32_t* header_size);
+
+  // Reads the next page, decompressing it into the passed buffer if needed
+  std::shared_ptr<Page> ReadPage(OwnedMutableBuffer* decompression_buffer);
+
+  std::shared_ptr<Page> NextPipelinedPage();
+
+  // Body of the background thread filling ready_pages_
+  void PipelineWorker();
+
   std::unique_ptr<InputStream> stream_;
 
   format::PageHeader current_page_header_;
@@ -65,14 +110,62 @@ class SerializedPageReader : public PageReader {
   OwnedMutableBuffer decompression_buffer_;
   // Maximum allowed page size
   uint32_t max_page_header_size_;
+
+  MemoryAllocator* allocator_;
+
+  // Pipelined decompression state. The worker decompresses page i into
+  // page_buffers_[i % page_buffers_.size()]; the ring holds one buffer more
+  // than the pipeline depth so the page held by the caller is never reused
+  int pipeline_depth_;
+  std::thread pipeline_thread_;
+  std::mutex pipeline_mutex_;
+  std::condition_variable pipeline_cv_;
+  std::vector<std::unique_ptr<OwnedMutableBuffer>> page_buffers_;
+  std::deque<std::shared_ptr<Page>> ready_pages_;
+  int64_t pages_produced_;
+  int64_t pages_consumed_;
+  bool pipeline_done_;
+  bool pipeline_stop_;
+  std::exception_ptr pipeline_error_;
+
+  DataPageFilter data_page_filter_;
+  bool min_max_ordered_;
+  std::atomic<int64_t> pruned_pages_;
+  std::atomic<int64_t> pruned_values_;
+  std::atomic<int64_t> pruned_bytes_;
+};
+
+// Serves serialized pages that each occupy their own buffer, decompressing
+// every page into separate memory that lives as long as this reader. Values
+// decoded from an earlier page therefore stay valid after moving on, which
+// lets runs of pages be decoded into one output
+class PageRunReader : public PageReader {
+ public:
+  PageRunReader(std::vector<std::shared_ptr<Buffer>> pages, Compression::type codec,
+      MemoryAllocator* allocator = default_allocator());
+
+  virtual std::shared_ptr<Page> NextPage();
+
+ private:
+  std::vector<std::shared_ptr<Buffer>> pages_;
+  size_t next_page_;
+  Compression::type codec_;
+  MemoryAllocator* allocator_;
+
+  // One reader per page handed out so far, owning its decompressed data
+  std::vector<std::unique_ptr<SerializedPageReader>> page_readers_;
 };
 
 // RowGroupReader::Contents implementation for the Parquet file specification
 class SerializedRowGroup : public RowGroupReader::Contents {
  public:
   SerializedRowGroup(RandomAccessSource* source,
-      std::unique_ptr<RowGroupMetaData> metadata, const ReaderProperties props)
-      : source_(source), row_group_metadata_(std::move(metadata)), properties_(props) {}
+      std::shared_ptr<const FileMetaData> file_metadata, int row_group,
+      const ReaderProperties props)
+      : source_(source),
+        file_metadata_(file_metadata),
+        row_group_metadata_(file_metadata->RowGroup(row_group)),
+        properties_(props) {}
 
   virtual const RowGroupMetaData* metadata() const;
 
@@ -80,10 +173,26 @@ class SerializedRowGroup : public RowGroupReader::Contents {
 
   virtual std::unique_ptr<PageReader> GetColumnPageReader(int i);
 
+  virtual void Prefetch(const std::vector<int>& column_indices);
+
+  virtual std::vector<PageRun> GetColumnPageRuns(int i, int max_runs);
+
  private:
+  // Byte range of column chunk i within the file
+  ReadRange ColumnChunkRange(int i) const;
+
+  // Serialized column chunk i, taken from the prefetched chunks if present
+  std::shared_ptr<Buffer> ColumnChunkBuffer(int i);
+
   RandomAccessSource* source_;
-  std::unique_ptr<RowGroupMetaData> row_group_metadata_;
+  // Owns row_group_metadata_
+  std::shared_ptr<const FileMetaData> file_metadata_;
+  const RowGroupMetaData* row_group_metadata_;
   ReaderProperties properties_;
+
+  // Column chunks loaded by Prefetch, keyed by column index. An entry is
+  // handed off to the page reader on the first GetColumnPageReader call
+  std::unordered_map<int, std::shared_ptr<Buffer>> prefetched_chunks_;
 };
 
 // An implementation of ParquetFileReader::Contents that deals with the Parquet
@@ -95,9 +204,13 @@ class SerializedFile : public ParquetFileReader::Contents {
   //
   // This class does _not_ take ownership of the data source. You must manage its
   // lifetime separately
+  //
+  // With a metadata cache in props and a non-empty metadata_cache_key, cached
+  // metadata is used without reading the footer
   static std::unique_ptr<ParquetFileReader::Contents> Open(
       std::unique_ptr<RandomAccessSource> source,
-      ReaderProperties props = default_reader_properties());
+      ReaderProperties props = default_reader_properties(),
+      const std::string& metadata_cache_key = "");
   virtual void Close();
   virtual std::shared_ptr<RowGroupReader> GetRowGroup(int i);
   virtual const FileMetaData* metadata() const;
@@ -109,7 +222,7 @@ class SerializedFile : public ParquetFileReader::Contents {
       std::unique_ptr<RandomAccessSource> source, ReaderProperties props);
 
   std::unique_ptr<RandomAccessSource> source_;
-  std::unique_ptr<FileMetaData> file_metadata_;
+  std::shared_ptr<const FileMetaData> file_metadata_;
   ReaderProperties properties_;
 
   void ParseMetaData();
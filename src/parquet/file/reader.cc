@@ -17,10 +17,18 @@
 
 #include "parquet/file/reader.h"
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -28,6 +36,7 @@
 #include "parquet/column/reader.h"
 #include "parquet/column/scanner.h"
 #include "parquet/exception.h"
+#include "parquet/file/filter.h"
 #include "parquet/file/reader-internal.h"
 #include "parquet/util/input.h"
 #include "parquet/util/logging.h"
@@ -38,6 +47,61 @@ using std::vector;
 
 namespace parquet {
 
+// ----------------------------------------------------------------------
+// Task execution for parallel decoding
+
+// Runs the tasks on num_threads threads that pull from a shared task index
+static ParquetFileReader::Executor ThreadExecutor(int num_threads) {
+  return [num_threads](const std::vector<std::function<void()>>& tasks) {
+    if (num_threads <= 1) {
+      for (auto& task : tasks) {
+        task();
+      }
+      return;
+    }
+
+    std::atomic<size_t> next_task(0);
+    auto worker = [&tasks, &next_task]() {
+      size_t i;
+      while ((i = next_task++) < tasks.size()) {
+        tasks[i]();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+}
+
+// Runs the tasks on the executor. Tasks must not throw into the executor, so
+// the first error is kept and rethrown once every task has run
+static void ExecuteTasks(const ParquetFileReader::Executor& executor,
+    const std::vector<std::function<void()>>& tasks) {
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  std::vector<std::function<void()>> guarded_tasks;
+  for (auto& task : tasks) {
+    guarded_tasks.push_back([&task, &error_mutex, &error]() {
+      try {
+        task();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) { error = std::current_exception(); }
+      }
+    });
+  }
+
+  executor(guarded_tasks);
+
+  if (error) { std::rethrow_exception(error); }
+}
+
 // ----------------------------------------------------------------------
 // RowGroupReader public API
 
@@ -55,6 +119,104 @@ std::shared_ptr<ColumnReader> RowGroupReader::Column(int i) {
       const_cast<ReaderProperties*>(contents_->properties())->allocator());
 }
 
+std::vector<ColumnRun> RowGroupReader::ColumnRuns(int i, int max_runs) {
+  DCHECK(i < metadata()->num_columns()) << "The RowGroup only has "
+                                        << metadata()->num_columns()
+                                        << "columns, requested column: " << i;
+  const ColumnDescriptor* descr = metadata()->schema()->Column(i);
+  MemoryAllocator* allocator =
+      const_cast<ReaderProperties*>(contents_->properties())->allocator();
+
+  std::vector<ColumnRun> runs;
+  int64_t level_offset = 0;
+  for (PageRun& page_run : contents_->GetColumnPageRuns(i, max_runs)) {
+    ColumnRun run;
+    run.reader = ColumnReader::Make(descr, std::move(page_run.pager), allocator);
+    run.level_offset = level_offset;
+    run.num_levels = page_run.num_values;
+    level_offset += page_run.num_values;
+    runs.push_back(run);
+  }
+  return runs;
+}
+
+std::vector<PageRun> RowGroupReader::Contents::GetColumnPageRuns(int i, int max_runs) {
+  std::vector<PageRun> runs(1);
+  runs[0].pager = GetColumnPageReader(i);
+  runs[0].num_values = metadata()->ColumnChunk(i)->num_values();
+  return runs;
+}
+
+template <typename DType>
+int64_t ReadColumnRuns(const std::vector<ColumnRun>& runs, int num_threads,
+    int16_t* def_levels, int16_t* rep_levels, typename DType::c_type* values) {
+  typedef typename DType::c_type T;
+
+  for (const ColumnRun& run : runs) {
+    if (run.reader->type() != DType::type_num) {
+      throw ParquetException("Column run does not match the requested type");
+    }
+  }
+
+  // Each run first writes its values at its level offset, which is an upper
+  // bound on the number of values in the preceding runs
+  std::vector<int64_t> run_values(runs.size(), 0);
+  std::vector<std::function<void()>> tasks;
+  for (size_t k = 0; k < runs.size(); ++k) {
+    tasks.push_back([&runs, &run_values, k, def_levels, rep_levels, values]() {
+      const ColumnRun& run = runs[k];
+      auto reader = static_cast<TypedColumnReader<DType>*>(run.reader.get());
+      int64_t levels_read = 0;
+      while (levels_read < run.num_levels && reader->HasNext()) {
+        int64_t offset = run.level_offset + levels_read;
+        int32_t batch_size = static_cast<int32_t>(std::min<int64_t>(
+            run.num_levels - levels_read, std::numeric_limits<int32_t>::max()));
+        int64_t values_read;
+        levels_read += reader->ReadBatch(batch_size,
+            def_levels ? def_levels + offset : nullptr,
+            rep_levels ? rep_levels + offset : nullptr,
+            values + run.level_offset + run_values[k], &values_read);
+        run_values[k] += values_read;
+      }
+    });
+  }
+
+  ExecuteTasks(ThreadExecutor(num_threads), tasks);
+
+  int64_t total_values = 0;
+  for (size_t k = 0; k < runs.size(); ++k) {
+    T* run_start = values + runs[k].level_offset;
+    if (values + total_values != run_start) {
+      std::copy(run_start, run_start + run_values[k], values + total_values);
+    }
+    total_values += run_values[k];
+  }
+  return total_values;
+}
+
+#define INSTANTIATE_READ_COLUMN_RUNS(DType)                                          \
+  template PARQUET_EXPORT int64_t ReadColumnRuns<DType>(                             \
+      const std::vector<ColumnRun>& runs, int num_threads, int16_t* def_levels,      \
+      int16_t* rep_levels, typename DType::c_type* values)
+
+INSTANTIATE_READ_COLUMN_RUNS(BooleanType);
+INSTANTIATE_READ_COLUMN_RUNS(Int32Type);
+INSTANTIATE_READ_COLUMN_RUNS(Int64Type);
+INSTANTIATE_READ_COLUMN_RUNS(Int96Type);
+INSTANTIATE_READ_COLUMN_RUNS(FloatType);
+INSTANTIATE_READ_COLUMN_RUNS(DoubleType);
+INSTANTIATE_READ_COLUMN_RUNS(ByteArrayType);
+INSTANTIATE_READ_COLUMN_RUNS(FLBAType);
+
+void RowGroupReader::Prefetch(const std::vector<int>& column_indices) {
+  for (int i : column_indices) {
+    if (i < 0 || i >= metadata()->num_columns()) {
+      throw ParquetException("Prefetched column is out of range");
+    }
+  }
+  contents_->Prefetch(column_indices);
+}
+
 // Returns the rowgroup metadata
 const RowGroupMetaData* RowGroupReader::metadata() const {
   return contents_->metadata();
@@ -69,8 +231,9 @@ ParquetFileReader::~ParquetFileReader() {
 }
 
 std::unique_ptr<ParquetFileReader> ParquetFileReader::Open(
-    std::unique_ptr<RandomAccessSource> source, ReaderProperties props) {
-  auto contents = SerializedFile::Open(std::move(source), props);
+    std::unique_ptr<RandomAccessSource> source, ReaderProperties props,
+    const std::string& metadata_cache_key) {
+  auto contents = SerializedFile::Open(std::move(source), props, metadata_cache_key);
 
   std::unique_ptr<ParquetFileReader> result(new ParquetFileReader());
   result->Open(std::move(contents));
@@ -88,7 +251,23 @@ std::unique_ptr<ParquetFileReader> ParquetFileReader::OpenFile(
   }
   file->Open(path);
 
-  return Open(std::move(file), props);
+  // Identify the opened file down to the nanosecond of its last modification,
+  // so that files rewritten in place or replaced by a rename get new keys
+  std::string metadata_cache_key;
+  struct stat file_stat;
+  if (props.metadata_cache() && fstat(file->file_descriptor(), &file_stat) == 0) {
+#ifdef __APPLE__
+    const struct timespec& mtime = file_stat.st_mtimespec;
+#else
+    const struct timespec& mtime = file_stat.st_mtim;
+#endif
+    std::stringstream ss;
+    ss << path << ":" << file_stat.st_dev << ":" << file_stat.st_ino << ":"
+       << file_stat.st_size << ":" << mtime.tv_sec << "." << mtime.tv_nsec;
+    metadata_cache_key = ss.str();
+  }
+
+  return Open(std::move(file), props, metadata_cache_key);
 }
 
 void ParquetFileReader::Open(std::unique_ptr<ParquetFileReader::Contents> contents) {
@@ -103,6 +282,15 @@ const FileMetaData* ParquetFileReader::metadata() const {
   return contents_->metadata();
 }
 
+std::vector<int> ParquetFileReader::FilterRowGroups(const RowGroupFilter& filter) const {
+  const FileMetaData* file_metadata = metadata();
+  std::vector<int> row_groups;
+  for (int i = 0; i < file_metadata->num_row_groups(); ++i) {
+    if (filter.MayMatch(*file_metadata->RowGroup(i))) { row_groups.push_back(i); }
+  }
+  return row_groups;
+}
+
 std::shared_ptr<RowGroupReader> ParquetFileReader::RowGroup(int i) {
   DCHECK(i < metadata()->num_row_groups()) << "The file only has "
                                            << metadata()->num_row_groups()
@@ -110,6 +298,43 @@ std::shared_ptr<RowGroupReader> ParquetFileReader::RowGroup(int i) {
   return contents_->GetRowGroup(i);
 }
 
+// ----------------------------------------------------------------------
+// ParquetFileReader::ParallelScan
+
+void ParquetFileReader::ParallelScan(const std::vector<int>& columns, int num_threads,
+    const ColumnChunkCallback& callback) {
+  ParallelScan(columns, ThreadExecutor(num_threads), callback);
+}
+
+void ParquetFileReader::ParallelScan(const std::vector<int>& columns,
+    const Executor& executor, const ColumnChunkCallback& callback) {
+  const FileMetaData* file_metadata = metadata();
+
+  std::vector<int> selected_columns = columns;
+  if (selected_columns.empty()) {
+    for (int i = 0; i < file_metadata->num_columns(); ++i) {
+      selected_columns.push_back(i);
+    }
+  }
+  for (int i : selected_columns) {
+    if (i < 0 || i >= file_metadata->num_columns()) {
+      throw ParquetException("Selected column is out of range");
+    }
+  }
+
+  std::vector<std::function<void()>> tasks;
+  for (int r = 0; r < file_metadata->num_row_groups(); ++r) {
+    for (int i : selected_columns) {
+      tasks.push_back([this, r, i, &callback]() {
+        std::shared_ptr<ColumnReader> reader = RowGroup(r)->Column(i);
+        callback(r, i, reader.get());
+      });
+    }
+  }
+
+  ExecuteTasks(executor, tasks);
+}
+
 // ----------------------------------------------------------------------
 // ParquetFileReader::DebugPrint
 
@@ -152,7 +377,7 @@ void ParquetFileReader::DebugPrint(
     stream << "--- Row Group " << r << " ---\n";
 
     auto group_reader = RowGroup(r);
-    std::unique_ptr<RowGroupMetaData> group_metadata = file_metadata->RowGroup(r);
+    const RowGroupMetaData* group_metadata = file_metadata->RowGroup(r);
 
     stream << "--- Total Bytes " << group_metadata->total_byte_size() << " ---\n";
     stream << "  rows: " << group_metadata->num_rows() << "---\n";
@@ -19,6 +19,7 @@
 #define PARQUET_FILE_READER_H
 
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <list>
@@ -35,6 +36,24 @@ namespace parquet {
 
 class ColumnReader;
 class RandomAccessSource;
+class RowGroupFilter;
+
+// Consecutive data pages of a column chunk, preceded by the chunk's dictionary
+// page if it has one, so that they can be decoded independently of the rest
+// of the chunk
+struct PageRun {
+  std::unique_ptr<PageReader> pager;
+  // Total number of levels in the run's data pages
+  int64_t num_values;
+};
+
+// A ColumnReader over one PageRun, along with the position of its first
+// level within the column chunk
+struct ColumnRun {
+  std::shared_ptr<ColumnReader> reader;
+  int64_t level_offset;
+  int64_t num_levels;
+};
 
 class PARQUET_EXPORT RowGroupReader {
  public:
@@ -46,6 +65,12 @@ class PARQUET_EXPORT RowGroupReader {
     virtual std::unique_ptr<PageReader> GetColumnPageReader(int i) = 0;
     virtual const RowGroupMetaData* metadata() const = 0;
     virtual const ReaderProperties* properties() const = 0;
+    // Load the indicated column chunks ahead of decoding. The default does
+    // nothing and columns are read on demand
+    virtual void Prefetch(const std::vector<int>& column_indices) {}
+    // Split column chunk i into at most max_runs runs of data pages. The
+    // default does not split the column chunk
+    virtual std::vector<PageRun> GetColumnPageRuns(int i, int max_runs);
   };
 
   explicit RowGroupReader(std::unique_ptr<Contents> contents);
@@ -53,15 +78,41 @@ class PARQUET_EXPORT RowGroupReader {
   // Returns the rowgroup metadata
   const RowGroupMetaData* metadata() const;
 
+  // Read the column chunks for a projection up front, merging nearby byte
+  // ranges into a few large reads (see ReaderProperties for the thresholds).
+  // Subsequent calls to Column(i) for these columns are served from memory.
+  void Prefetch(const std::vector<int>& column_indices);
+
   // Construct a ColumnReader for the indicated row group-relative
   // column. Ownership is shared with the RowGroupReader.
   std::shared_ptr<ColumnReader> Column(int i);
 
+  // Construct readers over at most max_runs runs of consecutive data pages of
+  // column i, balanced by size, that may be decoded concurrently. The page
+  // headers of the column chunk are scanned up front to locate the pages.
+  //
+  // Values that point into page data (BYTE_ARRAY, FIXED_LEN_BYTE_ARRAY) stay
+  // valid for as long as the run's reader is alive.
+  std::vector<ColumnRun> ColumnRuns(int i, int max_runs);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
 };
 
+// Decode the runs of a column chunk on up to num_threads threads, each into its
+// own slice of the output, so def_levels, rep_levels and values must have room
+// for the levels of all runs. The values are compacted to the front of values
+// once every run is decoded. Set def_levels or rep_levels to nullptr under the
+// same conditions as for TypedColumnReader::ReadBatch. BYTE_ARRAY and
+// FIXED_LEN_BYTE_ARRAY values point into memory held by the runs' readers, as
+// with ReadBatch, and are valid until the readers read further.
+//
+// @returns: the number of values read
+template <typename DType>
+int64_t ReadColumnRuns(const std::vector<ColumnRun>& runs, int num_threads,
+    int16_t* def_levels, int16_t* rep_levels, typename DType::c_type* values);
+
 class PARQUET_EXPORT ParquetFileReader {
  public:
   // Forward declare a virtual class 'Contents' to aid dependency injection and more
@@ -75,6 +126,17 @@ class PARQUET_EXPORT ParquetFileReader {
     virtual const FileMetaData* metadata() const = 0;
   };
 
+  // Invoked once for every (row group, column) pair of a parallel scan, on the
+  // worker thread that decodes that column chunk. The reader is owned by that
+  // thread for the duration of the call and is typically drained with ReadBatch
+  typedef std::function<void(int row_group, int column, ColumnReader* reader)>
+      ColumnChunkCallback;
+
+  // Runs every task, possibly concurrently, and returns once all of them
+  // have completed. Lets callers plug in their own thread pool
+  typedef std::function<void(const std::vector<std::function<void()>>& tasks)>
+      Executor;
+
   ParquetFileReader();
   ~ParquetFileReader();
 
@@ -82,9 +144,14 @@ class PARQUET_EXPORT ParquetFileReader {
   static std::unique_ptr<ParquetFileReader> OpenFile(const std::string& path,
       bool memory_map = true, ReaderProperties props = default_reader_properties());
 
+  // When props has a metadata cache, the file metadata is looked up under
+  // metadata_cache_key, which must change whenever the file contents do.
+  // OpenFile derives the key from the path, device, inode, size and modification
+  // time (with nanoseconds where the file system records them)
   static std::unique_ptr<ParquetFileReader> Open(
       std::unique_ptr<RandomAccessSource> source,
-      ReaderProperties props = default_reader_properties());
+      ReaderProperties props = default_reader_properties(),
+      const std::string& metadata_cache_key = "");
 
   void Open(std::unique_ptr<Contents> contents);
   void Close();
@@ -95,6 +162,25 @@ class PARQUET_EXPORT ParquetFileReader {
   // Returns the file metadata
   const FileMetaData* metadata() const;
 
+  // The indices of the row groups which may contain rows matching filter, in
+  // order. Only the column chunk statistics in the file footer are consulted,
+  // so skipped row groups cost no I/O (see parquet/file/filter.h).
+  std::vector<int> FilterRowGroups(const RowGroupFilter& filter) const;
+
+  // Decode the indicated columns of every row group concurrently, one task
+  // per column chunk. An empty column list selects all columns. With
+  // num_threads <= 1 the chunks are decoded in order on the calling thread.
+  // The tasks read the file through RandomAccessSource::ReadAt concurrently;
+  // sources which do not override it are read one task at a time.
+  //
+  // The first exception raised by a task is rethrown on the calling thread
+  // after all tasks have finished.
+  void ParallelScan(const std::vector<int>& columns, int num_threads,
+      const ColumnChunkCallback& callback);
+
+  void ParallelScan(const std::vector<int>& columns, const Executor& executor,
+      const ColumnChunkCallback& callback);
+
   void DebugPrint(
       std::ostream& stream, std::list<int> selected_columns, bool print_values = true);
 
@@ -0,0 +1,245 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parquet/column/page.h"
+#include "parquet/column/properties.h"
+#include "parquet/column/test-util.h"
+#include "parquet/exception.h"
+#include "parquet/file/metadata.h"
+#include "parquet/file/reader.h"
+#include "parquet/file/selection-reader.h"
+#include "parquet/schema/descriptor.h"
+#include "parquet/schema/types.h"
+#include "parquet/types.h"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace parquet {
+
+namespace test {
+
+static constexpr int kNumRows = 1000;
+
+// Serves each column chunk of a row group from in-memory pages
+class MockRowGroupContents : public RowGroupReader::Contents {
+ public:
+  MockRowGroupContents(const RowGroupMetaData* metadata,
+      const vector<vector<shared_ptr<Page>>>& pages, vector<MockPageReader*>* pagers)
+      : metadata_(metadata), pages_(pages), pagers_(pagers) {}
+
+  virtual std::unique_ptr<PageReader> GetColumnPageReader(int i) {
+    MockPageReader* pager = new MockPageReader(pages_[i]);
+    pagers_->push_back(pager);
+    return std::unique_ptr<PageReader>(pager);
+  }
+
+  virtual const RowGroupMetaData* metadata() const { return metadata_; }
+
+  virtual const ReaderProperties* properties() const { return &properties_; }
+
+ private:
+  const RowGroupMetaData* metadata_;
+  vector<vector<shared_ptr<Page>>> pages_;
+  vector<MockPageReader*>* pagers_;
+  ReaderProperties properties_;
+};
+
+// A row group of 1000 rows in pages of 100 rows
+//
+//   column | type  | repetition | encoding
+//   0      | INT32 | OPTIONAL   | RLE_DICTIONARY
+//   1      | INT32 | REQUIRED   | PLAIN
+//   2      | INT32 | OPTIONAL   | PLAIN
+class TestRowGroupSelectionReader : public ::testing::Test {
+ public:
+  void SetUp() {
+    schema::NodeVector fields;
+    fields.push_back(schema::Int32("a", Repetition::OPTIONAL));
+    fields.push_back(schema::Int32("b", Repetition::REQUIRED));
+    fields.push_back(schema::Int32("c", Repetition::OPTIONAL));
+    schema_.Init(schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+    std::shared_ptr<WriterProperties> props = WriterProperties::Builder().build();
+    auto builder = FileMetaDataBuilder::Make(&schema_, props);
+    auto rg_builder = builder->AppendRowGroup(kNumRows);
+    for (int i = 0; i < 3; ++i) {
+      rg_builder->NextColumnChunk()->Finish(kNumRows, 0, 0, 4 + i * 4000, 4000, 4000,
+          false);
+    }
+    rg_builder->Finish(12000);
+    metadata_ = builder->Finish();
+
+    columns_.resize(3);
+    pages_.resize(3);
+    for (int i = 0; i < 3; ++i) {
+      Column& column = columns_[i];
+      MakePages<Int32Type>(schema_.Column(i), kNumRows / 100, 100, column.def_levels,
+          column.rep_levels, column.values, column.buffer, pages_[i],
+          i == 0 ? Encoding::RLE_DICTIONARY : Encoding::PLAIN);
+      // Map each row to its value, or to nothing if it is null
+      int value = 0;
+      for (int row = 0; row < kNumRows; ++row) {
+        bool defined = column.def_levels.empty() || column.def_levels[row] > 0;
+        column.row_values.push_back(defined ? &column.values[value++] : nullptr);
+      }
+    }
+  }
+
+  std::unique_ptr<RowGroupSelectionReader> MakeReader(int64_t batch_size) {
+    std::unique_ptr<RowGroupReader::Contents> contents(
+        new MockRowGroupContents(metadata_->RowGroup(0), pages_, &pagers_));
+    auto row_group = std::make_shared<RowGroupReader>(std::move(contents));
+    return std::unique_ptr<RowGroupSelectionReader>(
+        new RowGroupSelectionReader(row_group, batch_size));
+  }
+
+  // Read the selected rows of column i batch by batch, returning the values of
+  // the selected rows, nullptr for nulls
+  vector<const int32_t*> ReadAll(RowGroupSelectionReader* reader, int i,
+      vector<int32_t>* values, vector<int>* rows) {
+    vector<const int32_t*> result;
+    values->resize(kNumRows);
+    vector<int16_t> def_levels(kNumRows);
+    int16_t max_def_level = schema_.Column(i)->max_definition_level();
+    int64_t batch_start = 0;
+    int64_t num_values = 0;
+    int64_t batch_rows;
+    while ((batch_rows = reader->NextBatch()) > 0) {
+      int64_t values_read = 0;
+      int64_t rows_read = reader->ReadColumn<Int32Type>(i, def_levels.data(),
+          values->data() + num_values, &values_read);
+      EXPECT_EQ(reader->num_selected(), rows_read);
+      for (int64_t j = 0; j < rows_read; ++j) {
+        rows->push_back(static_cast<int>(batch_start + reader->selection()[j]));
+        bool defined = max_def_level == 0 || def_levels[j] == max_def_level;
+        result.push_back(defined ? &(*values)[num_values++] : nullptr);
+      }
+      batch_start += batch_rows;
+    }
+    EXPECT_EQ(kNumRows, batch_start);
+    return result;
+  }
+
+ protected:
+  struct Column {
+    vector<int16_t> def_levels;
+    vector<int16_t> rep_levels;
+    vector<int32_t> values;
+    vector<uint8_t> buffer;
+    vector<const int32_t*> row_values;
+  };
+
+  SchemaDescriptor schema_;
+  std::unique_ptr<FileMetaData> metadata_;
+  vector<Column> columns_;
+  vector<vector<shared_ptr<Page>>> pages_;
+  vector<MockPageReader*> pagers_;
+};
+
+static bool DivisibleByFour(const int32_t& value) {
+  return value % 4 == 0;
+}
+
+static bool NotDivisibleByThree(const int32_t& value) {
+  return value % 3 != 0;
+}
+
+TEST_F(TestRowGroupSelectionReader, Filters) {
+  auto reader = MakeReader(128);
+  reader->AddFilter<Int32Type>(0, DivisibleByFour);
+  reader->AddFilter<Int32Type>(1, NotDivisibleByThree);
+
+  vector<int> expected_rows;
+  for (int row = 0; row < kNumRows; ++row) {
+    const int32_t* a = columns_[0].row_values[row];
+    const int32_t* b = columns_[1].row_values[row];
+    if (a && DivisibleByFour(*a) && NotDivisibleByThree(*b)) {
+      expected_rows.push_back(row);
+    }
+  }
+  ASSERT_FALSE(expected_rows.empty());
+
+  vector<int32_t> values;
+  vector<int> rows;
+  vector<const int32_t*> result = ReadAll(reader.get(), 2, &values, &rows);
+  ASSERT_EQ(expected_rows, rows);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const int32_t* expected = columns_[2].row_values[rows[i]];
+    if (expected) {
+      ASSERT_TRUE(result[i] != nullptr) << rows[i];
+      ASSERT_EQ(*expected, *result[i]) << rows[i];
+    } else {
+      ASSERT_TRUE(result[i] == nullptr) << rows[i];
+    }
+  }
+}
+
+TEST_F(TestRowGroupSelectionReader, SkipsPages) {
+  int32_t needle = *columns_[1].row_values[250];
+  auto reader = MakeReader(200);
+  reader->AddFilter<Int32Type>(
+      1, [needle](const int32_t& value) { return value == needle; });
+
+  vector<int32_t> values;
+  vector<int> rows;
+  ReadAll(reader.get(), 2, &values, &rows);
+  ASSERT_EQ(vector<int>({250}), rows);
+
+  // The payload column only decodes page 2, which holds the selected row; the
+  // other pages are skipped by their headers
+  ASSERT_EQ(9, pagers_.back()->pages_skipped());
+}
+
+TEST_F(TestRowGroupSelectionReader, NoFilters) {
+  auto reader = MakeReader(300);
+  vector<int32_t> values;
+  vector<int> rows;
+  vector<const int32_t*> result = ReadAll(reader.get(), 1, &values, &rows);
+  ASSERT_EQ(kNumRows, static_cast<int>(rows.size()));
+  for (int row = 0; row < kNumRows; ++row) {
+    ASSERT_EQ(row, rows[row]);
+    ASSERT_EQ(*columns_[1].row_values[row], *result[row]);
+  }
+}
+
+TEST_F(TestRowGroupSelectionReader, Invalid) {
+  auto reader = MakeReader(100);
+  ASSERT_THROW(reader->AddFilter<Int64Type>(0, [](const int64_t&) { return true; }),
+      ParquetException);
+  ASSERT_THROW(reader->AddFilter<Int32Type>(3, DivisibleByFour), ParquetException);
+
+  reader->AddFilter<Int32Type>(0, DivisibleByFour);
+  ASSERT_EQ(100, reader->NextBatch());
+  ASSERT_THROW(reader->AddFilter<Int32Type>(1, DivisibleByFour), ParquetException);
+
+  vector<int32_t> values(100);
+  int64_t values_read = 0;
+  reader->ReadColumn<Int32Type>(1, nullptr, values.data(), &values_read);
+  ASSERT_THROW(reader->ReadColumn<Int32Type>(1, nullptr, values.data(), &values_read),
+      ParquetException);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,208 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/file/selection-reader.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "parquet/exception.h"
+#include "parquet/schema/descriptor.h"
+#include "parquet/util/buffer.h"
+
+namespace parquet {
+
+// Evaluates a predicate on one column, batch by batch
+class SelectionFilter {
+ public:
+  virtual ~SelectionFilter() {}
+
+  // Select the matching rows among the next num_rows rows
+  //
+  // @returns: the number of rows evaluated
+  virtual int64_t Select(int64_t num_rows, int32_t* selection, int64_t* num_selected) = 0;
+
+  // Deselect the rows of the next num_rows rows that do not match, only
+  // decoding the rows currently selected
+  virtual void Refine(int64_t num_rows, int32_t* selection, int64_t* num_selected) = 0;
+};
+
+namespace {
+
+template <typename DType>
+class TypedSelectionFilter : public SelectionFilter {
+ public:
+  typedef typename DType::c_type T;
+  typedef typename TypedColumnReader<DType>::ValuePredicate ValuePredicate;
+
+  TypedSelectionFilter(
+      const std::shared_ptr<ColumnReader>& reader, const ValuePredicate& predicate)
+      : reader_(reader),
+        typed_reader_(static_cast<TypedColumnReader<DType>*>(reader.get())),
+        predicate_(predicate) {
+    typed_reader_->SetSelectionPredicate(predicate);
+  }
+
+  virtual int64_t Select(int64_t num_rows, int32_t* selection, int64_t* num_selected) {
+    return typed_reader_->ReadBatchSelection(
+        static_cast<int32_t>(num_rows), nullptr, nullptr, selection, num_selected);
+  }
+
+  virtual void Refine(int64_t num_rows, int32_t* selection, int64_t* num_selected) {
+    if (*num_selected == 0) {
+      typed_reader_->Skip(num_rows);
+      return;
+    }
+
+    int16_t max_def_level = reader_->descr()->max_definition_level();
+    def_levels_.resize(max_def_level > 0 ? *num_selected : 0);
+    values_.Resize(*num_selected * sizeof(T));
+    T* values = reinterpret_cast<T*>(values_.mutable_data());
+    int64_t values_read = 0;
+    int64_t rows_read = typed_reader_->ReadSelected(num_rows, selection, *num_selected,
+        max_def_level > 0 ? def_levels_.data() : nullptr, values, &values_read);
+
+    int64_t value = 0;
+    int64_t kept = 0;
+    for (int64_t i = 0; i < rows_read; ++i) {
+      bool defined = max_def_level == 0 || def_levels_[i] == max_def_level;
+      selection[kept] = selection[i];
+      kept += defined && predicate_(values[value]);
+      value += defined;
+    }
+    *num_selected = kept;
+  }
+
+ private:
+  std::shared_ptr<ColumnReader> reader_;
+  TypedColumnReader<DType>* typed_reader_;
+  ValuePredicate predicate_;
+
+  std::vector<int16_t> def_levels_;
+  OwnedMutableBuffer values_;
+};
+
+}  // namespace
+
+RowGroupSelectionReader::RowGroupSelectionReader(
+    std::shared_ptr<RowGroupReader> row_group, int64_t batch_size)
+    : row_group_(row_group),
+      batch_size_(batch_size),
+      batch_start_(0),
+      batch_rows_(0),
+      num_selected_(0) {}
+
+RowGroupSelectionReader::~RowGroupSelectionReader() {}
+
+std::shared_ptr<ColumnReader> RowGroupSelectionReader::MakeReader(
+    int i, Type::type type) {
+  if (i < 0 || i >= row_group_->metadata()->num_columns()) {
+    throw ParquetException("Column index out of range");
+  }
+  const ColumnDescriptor* descr = row_group_->metadata()->schema()->Column(i);
+  if (descr->physical_type() != type) {
+    throw ParquetException("Column has a different physical type");
+  }
+  if (descr->max_repetition_level() > 0) {
+    ParquetException::NYI("Selective reads of repeated columns");
+  }
+  return row_group_->Column(i);
+}
+
+template <typename DType>
+void RowGroupSelectionReader::AddFilter(
+    int i, const std::function<bool(const typename DType::c_type&)>& predicate) {
+  if (batch_start_ + batch_rows_ > 0) {
+    throw ParquetException("Filters must be added before reading");
+  }
+  filters_.emplace_back(
+      new TypedSelectionFilter<DType>(MakeReader(i, DType::type_num), predicate));
+}
+
+int64_t RowGroupSelectionReader::NextBatch() {
+  batch_start_ += batch_rows_;
+  batch_rows_ = std::min(batch_size_, row_group_->metadata()->num_rows() - batch_start_);
+  num_selected_ = 0;
+  if (batch_rows_ <= 0) {
+    batch_rows_ = 0;
+    return 0;
+  }
+
+  selection_.resize(batch_rows_);
+  if (filters_.empty()) {
+    for (int64_t i = 0; i < batch_rows_; ++i) {
+      selection_[i] = static_cast<int32_t>(i);
+    }
+    num_selected_ = batch_rows_;
+    return batch_rows_;
+  }
+
+  if (filters_[0]->Select(batch_rows_, selection_.data(), &num_selected_) !=
+      batch_rows_) {
+    throw ParquetException("Column chunk has fewer rows than its row group");
+  }
+  for (size_t i = 1; i < filters_.size(); ++i) {
+    filters_[i]->Refine(batch_rows_, selection_.data(), &num_selected_);
+  }
+  return batch_rows_;
+}
+
+template <typename DType>
+int64_t RowGroupSelectionReader::ReadColumn(
+    int i, int16_t* def_levels, typename DType::c_type* values, int64_t* values_read) {
+  auto it = columns_.find(i);
+  if (it == columns_.end()) {
+    ProjectedColumn column = {MakeReader(i, DType::type_num), 0};
+    it = columns_.emplace(i, column).first;
+  }
+  ProjectedColumn& column = it->second;
+  auto reader = static_cast<TypedColumnReader<DType>*>(column.reader.get());
+
+  if (column.position > batch_start_) {
+    throw ParquetException("Column was already read for the current batch");
+  }
+  if (column.position < batch_start_) {
+    column.position += reader->Skip(batch_start_ - column.position);
+  }
+  int64_t rows_read = reader->ReadSelected(
+      batch_rows_, selection_.data(), num_selected_, def_levels, values, values_read);
+  column.position = batch_start_ + batch_rows_;
+  return rows_read;
+}
+
+// ----------------------------------------------------------------------
+// Instantiate templated methods
+
+#define INSTANTIATE_SELECTION_READER(DType)                                      \
+  template void RowGroupSelectionReader::AddFilter<DType>(                       \
+      int, const std::function<bool(const DType::c_type&)>&);                    \
+  template int64_t RowGroupSelectionReader::ReadColumn<DType>(                   \
+      int, int16_t*, DType::c_type*, int64_t*)
+
+INSTANTIATE_SELECTION_READER(BooleanType);
+INSTANTIATE_SELECTION_READER(Int32Type);
+INSTANTIATE_SELECTION_READER(Int64Type);
+INSTANTIATE_SELECTION_READER(Int96Type);
+INSTANTIATE_SELECTION_READER(FloatType);
+INSTANTIATE_SELECTION_READER(DoubleType);
+INSTANTIATE_SELECTION_READER(ByteArrayType);
+INSTANTIATE_SELECTION_READER(FLBAType);
+
+#undef INSTANTIATE_SELECTION_READER
+
+}  // namespace parquet
@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_FILE_SELECTION_READER_H
+#define PARQUET_FILE_SELECTION_READER_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "parquet/column/reader.h"
+#include "parquet/file/reader.h"
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+static constexpr int64_t DEFAULT_SELECTION_BATCH_SIZE = 4096;
+
+class SelectionFilter;
+
+// Reads the rows of a row group that satisfy predicates on some of its
+// columns, materializing the values of the projected columns only for those
+// rows ("late materialization").
+//
+// Each batch of rows is first evaluated against the filter columns: the first
+// filter yields a selection vector (on dictionary encoded pages, without
+// decoding values), and each further filter only decodes and tests the rows
+// still selected. Projected columns are then read for the selected rows only,
+// skipping the rows in between, so data pages without a selected row are not
+// decompressed at all.
+//
+// Filter and projected columns must not be repeated. A filter column may also
+// be projected; it is then read a second time through a separate reader.
+class PARQUET_EXPORT RowGroupSelectionReader {
+ public:
+  explicit RowGroupSelectionReader(std::shared_ptr<RowGroupReader> row_group,
+      int64_t batch_size = DEFAULT_SELECTION_BATCH_SIZE);
+  ~RowGroupSelectionReader();
+
+  // Select only rows whose value of column i satisfies predicate, in addition
+  // to the filters added before. Null values never satisfy a predicate. Filters
+  // must be added before the first batch is read.
+  template <typename DType>
+  void AddFilter(
+      int i, const std::function<bool(const typename DType::c_type&)>& predicate);
+
+  // Evaluate the filters on the next batch of up to batch_size rows.
+  //
+  // @returns: the number of rows in the batch, 0 at the end of the row group
+  int64_t NextBatch();
+
+  // The positions of the selected rows within the current batch, in increasing
+  // order
+  const int32_t* selection() const { return selection_.data(); }
+  int64_t num_selected() const { return num_selected_; }
+
+  // Read the values of column i for the selected rows of the current batch.
+  // def_levels receives one definition level per selected row and may be
+  // nullptr for required columns; values receives the values that are not
+  // null. Both must have room for num_selected() entries. A column that is not
+  // read for some batches skips their rows when it is next read. BYTE_ARRAY and
+  // FIXED_LEN_BYTE_ARRAY values are valid until column i is read again.
+  //
+  // @returns: the number of selected rows read
+  template <typename DType>
+  int64_t ReadColumn(int i, int16_t* def_levels, typename DType::c_type* values,
+      int64_t* values_read);
+
+ private:
+  struct ProjectedColumn {
+    std::shared_ptr<ColumnReader> reader;
+    // Index of the next row to be read
+    int64_t position;
+  };
+
+  // Construct a reader for column i, which must be of the given physical type
+  // and not repeated
+  std::shared_ptr<ColumnReader> MakeReader(int i, Type::type type);
+
+  std::shared_ptr<RowGroupReader> row_group_;
+  int64_t batch_size_;
+  std::vector<std::unique_ptr<SelectionFilter>> filters_;
+  std::unordered_map<int, ProjectedColumn> columns_;
+
+  int64_t batch_start_;
+  int64_t batch_rows_;
+  std::vector<int32_t> selection_;
+  int64_t num_selected_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_FILE_SELECTION_READER_H
@@ -21,11 +21,14 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "parquet/file/reader.h"
 #include "parquet/file/reader-internal.h"
 #include "parquet/column/reader.h"
+#include "parquet/column/scan-all.h"
 #include "parquet/column/scanner.h"
 #include "parquet/util/input.h"
 #include "parquet/util/mem-allocator.h"
@@ -89,6 +92,75 @@ TEST_F(TestAllTypesPlain, TestBatchRead) {
   ASSERT_FALSE(col->HasNext());
 }
 
+TEST_F(TestAllTypesPlain, TestPrefetchColumns) {
+  std::shared_ptr<RowGroupReader> group = reader_->RowGroup(0);
+  std::shared_ptr<RowGroupReader> prefetched_group = reader_->RowGroup(0);
+
+  // Holes between the projected columns are small enough to be coalesced
+  prefetched_group->Prefetch({0, 2, 3});
+
+  for (int i : {0, 2, 3}) {
+    std::shared_ptr<Int32Reader> col =
+        std::dynamic_pointer_cast<Int32Reader>(group->Column(i));
+    std::shared_ptr<Int32Reader> prefetched_col =
+        std::dynamic_pointer_cast<Int32Reader>(prefetched_group->Column(i));
+
+    int32_t values[8];
+    int32_t prefetched_values[8];
+    int64_t values_read;
+    int64_t prefetched_values_read;
+    col->ReadBatch(8, nullptr, nullptr, values, &values_read);
+    prefetched_col->ReadBatch(
+        8, nullptr, nullptr, prefetched_values, &prefetched_values_read);
+    ASSERT_EQ(values_read, prefetched_values_read);
+    ASSERT_EQ(0, memcmp(values, prefetched_values, values_read * sizeof(int32_t)));
+  }
+
+  ASSERT_THROW(prefetched_group->Prefetch({100}), ParquetException);
+}
+
+static int64_t ScanColumn(ColumnReader* col) {
+  int16_t def_levels[16];
+  std::vector<uint8_t> values(16 * GetTypeByteSize(col->descr()->physical_type()));
+  int64_t values_read;
+  int64_t levels_read = 0;
+  while (col->HasNext()) {
+    levels_read += ScanAllValues(
+        16, def_levels, nullptr, values.data(), &values_read, col);
+  }
+  return levels_read;
+}
+
+TEST_F(TestAllTypesPlain, TestParallelScan) {
+  int num_columns = reader_->metadata()->num_columns();
+  std::vector<int64_t> serial_levels(num_columns, 0);
+  std::vector<int64_t> parallel_levels(num_columns, 0);
+
+  std::shared_ptr<RowGroupReader> group = reader_->RowGroup(0);
+  for (int i = 0; i < num_columns; ++i) {
+    serial_levels[i] = ScanColumn(group->Column(i).get());
+  }
+
+  std::mutex mutex;
+  int num_visited = 0;
+  reader_->ParallelScan({}, 4, [&](int row_group, int column, ColumnReader* col) {
+    int64_t levels_read = ScanColumn(col);
+    std::lock_guard<std::mutex> lock(mutex);
+    parallel_levels[column] += levels_read;
+    num_visited++;
+  });
+
+  ASSERT_EQ(num_columns, num_visited);
+  ASSERT_EQ(serial_levels, parallel_levels);
+
+  // Errors raised on a worker thread surface in the caller
+  ASSERT_THROW(reader_->ParallelScan({0, 1}, 2,
+                   [](int, int, ColumnReader*) { throw ParquetException("error"); }),
+      ParquetException);
+  ASSERT_THROW(reader_->ParallelScan({100}, 2, [](int, int, ColumnReader*) {}),
+      ParquetException);
+}
+
 TEST_F(TestAllTypesPlain, TestFlatScannerInt32) {
   std::shared_ptr<RowGroupReader> group = reader_->RowGroup(0);
 
@@ -72,6 +72,10 @@ class BitWriter {
   // Writes an int zigzag encoded.
   bool PutZigZagVlqInt(int32_t v);
 
+  /// 64-bit versions of PutVlqInt and PutZigZagVlqInt
+  bool PutVlqInt64(uint64_t v);
+  bool PutZigZagVlqInt64(int64_t v);
+
   /// Get a pointer to the next aligned byte and advance the underlying buffer
   /// by num_bytes.
   /// Returns NULL if there was not enough space.
@@ -126,6 +130,11 @@ class BitReader {
   template <typename T>
   int GetBatch(int num_bits, T* v, int batch_size);
 
+  /// Like GetBatch, but the values read are indices which are decoded into their
+  /// entries of 'dictionary'. The indices are not checked.
+  template <typename T>
+  int GetBatchWithDict(int num_bits, const T* dictionary, T* v, int batch_size);
+
   /// Reads a 'num_bytes'-sized value from the buffer and stores it in 'v'. T
   /// needs to be a little-endian native type and big enough to store
   /// 'num_bytes'. The value is assumed to be byte-aligned so the stream will
@@ -142,6 +151,15 @@ class BitReader {
   // Reads a zigzag encoded int `into` v.
   bool GetZigZagVlqInt(int32_t* v);
 
+  /// 64-bit versions of GetVlqInt and GetZigZagVlqInt. They also return false
+  /// if the encoded int is longer than MAX_VLQ64_BYTE_LEN bytes.
+  bool GetVlqInt64(uint64_t* v);
+  bool GetZigZagVlqInt64(int64_t* v);
+
+  /// Advances the stream by 'num_bits' bits without reading them. Returns false,
+  /// leaving the position unchanged, if there are not enough bits left.
+  bool Advance(int64_t num_bits);
+
   /// Returns the number of bytes left in the stream, not including the current
   /// byte (i.e., there may be an additional fraction of a byte).
   int bytes_left() { return max_bytes_ - (byte_offset_ + BitUtil::Ceil(bit_offset_, 8)); }
@@ -149,6 +167,9 @@ class BitReader {
   /// Maximum byte length of a vlq encoded int
   static const int MAX_VLQ_BYTE_LEN = 5;
 
+  /// Maximum byte length of a 64-bit vlq encoded int
+  static const int MAX_VLQ64_BYTE_LEN = 10;
+
  private:
   const uint8_t* buffer_;
   int max_bytes_;
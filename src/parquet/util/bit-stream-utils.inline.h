@@ -23,7 +23,7 @@
 #include <algorithm>
 
 #include "parquet/util/bit-stream-utils.h"
-#include "parquet/util/bpacking.h"
+#include "parquet/util/bpacking-simd.h"
 
 namespace parquet {
 
@@ -143,17 +143,25 @@ inline int BitReader::GetBatch(int num_bits, T* v, int batch_size) {
   }
 
   if (sizeof(T) == 4) {
-    int num_unpacked = unpack32(reinterpret_cast<const uint32_t*>(buffer + byte_offset),
-        reinterpret_cast<uint32_t*>(v + i), batch_size - i, num_bits);
+    int num_unpacked =
+        UnpackBits32(reinterpret_cast<const uint32_t*>(buffer + byte_offset),
+            reinterpret_cast<uint32_t*>(v + i), batch_size - i, num_bits);
+    i += num_unpacked;
+    byte_offset += num_unpacked * num_bits / 8;
+  } else if (sizeof(T) == 8) {
+    int num_unpacked =
+        UnpackBits64(reinterpret_cast<const uint32_t*>(buffer + byte_offset),
+            reinterpret_cast<uint64_t*>(v + i), batch_size - i, num_bits);
     i += num_unpacked;
     byte_offset += num_unpacked * num_bits / 8;
   } else {
     const int buffer_size = 1024;
-    static uint32_t unpack_buffer[buffer_size];
+    uint32_t unpack_buffer[buffer_size];
     while (i < batch_size) {
       int unpack_size = std::min(buffer_size, batch_size - i);
-      int num_unpacked = unpack32(reinterpret_cast<const uint32_t*>(buffer + byte_offset),
-          unpack_buffer, unpack_size, num_bits);
+      int num_unpacked =
+          UnpackBits32(reinterpret_cast<const uint32_t*>(buffer + byte_offset),
+              unpack_buffer, unpack_size, num_bits);
       if (num_unpacked == 0) { break; }
       for (int k = 0; k < num_unpacked; ++k) {
         v[i + k] = unpack_buffer[k];
@@ -182,6 +190,81 @@ inline int BitReader::GetBatch(int num_bits, T* v, int batch_size) {
   return batch_size;
 }
 
+template <typename T>
+inline int BitReader::GetBatchWithDict(
+    int num_bits, const T* dictionary, T* v, int batch_size) {
+  DCHECK(buffer_ != NULL);
+  DCHECK_LE(num_bits, 32);
+
+  int bit_offset = bit_offset_;
+  int byte_offset = byte_offset_;
+  uint64_t buffered_values = buffered_values_;
+  int max_bytes = max_bytes_;
+  const uint8_t* buffer = buffer_;
+
+  uint64_t needed_bits = num_bits * batch_size;
+  uint64_t remaining_bits = (max_bytes - byte_offset) * 8 - bit_offset;
+  if (remaining_bits < needed_bits) { batch_size = remaining_bits / num_bits; }
+
+  uint32_t index;
+  int i = 0;
+  if (UNLIKELY(bit_offset != 0)) {
+    for (; i < batch_size && bit_offset != 0; ++i) {
+      GetValue_(num_bits, &index, max_bytes, buffer, &bit_offset, &byte_offset,
+          &buffered_values);
+      v[i] = dictionary[index];
+    }
+  }
+
+  // Dictionary entries of 4 and 8 bytes are gathered as they are unpacked
+  const uint32_t* in = reinterpret_cast<const uint32_t*>(buffer + byte_offset);
+  if (sizeof(T) == 4) {
+    int num_unpacked = UnpackDict32(in, reinterpret_cast<const uint32_t*>(dictionary),
+        reinterpret_cast<uint32_t*>(v + i), batch_size - i, num_bits);
+    i += num_unpacked;
+    byte_offset += num_unpacked * num_bits / 8;
+  } else if (sizeof(T) == 8) {
+    int num_unpacked = UnpackDict64(in, reinterpret_cast<const uint64_t*>(dictionary),
+        reinterpret_cast<uint64_t*>(v + i), batch_size - i, num_bits);
+    i += num_unpacked;
+    byte_offset += num_unpacked * num_bits / 8;
+  } else {
+    const int buffer_size = 1024;
+    uint32_t indices[buffer_size];
+    while (i < batch_size) {
+      int unpack_size = std::min(buffer_size, batch_size - i);
+      int num_unpacked =
+          UnpackBits32(reinterpret_cast<const uint32_t*>(buffer + byte_offset), indices,
+              unpack_size, num_bits);
+      if (num_unpacked == 0) { break; }
+      for (int k = 0; k < num_unpacked; ++k) {
+        v[i + k] = dictionary[indices[k]];
+      }
+      i += num_unpacked;
+      byte_offset += num_unpacked * num_bits / 8;
+    }
+  }
+
+  int bytes_remaining = max_bytes - byte_offset;
+  if (bytes_remaining >= 8) {
+    memcpy(&buffered_values, buffer + byte_offset, 8);
+  } else {
+    memcpy(&buffered_values, buffer + byte_offset, bytes_remaining);
+  }
+
+  for (; i < batch_size; ++i) {
+    GetValue_(
+        num_bits, &index, max_bytes, buffer, &bit_offset, &byte_offset, &buffered_values);
+    v[i] = dictionary[index];
+  }
+
+  bit_offset_ = bit_offset;
+  byte_offset_ = byte_offset;
+  buffered_values_ = buffered_values;
+
+  return batch_size;
+}
+
 template <typename T>
 inline bool BitReader::GetAligned(int num_bytes, T* v) {
   DCHECK_LE(num_bytes, static_cast<int>(sizeof(T)));
@@ -204,6 +287,24 @@ inline bool BitReader::GetAligned(int num_bytes, T* v) {
   return true;
 }
 
+inline bool BitReader::Advance(int64_t num_bits) {
+  int64_t bits_required = bit_offset_ + num_bits;
+  int64_t bytes_required = BitUtil::Ceil(bits_required, 8);
+  if (UNLIKELY(bytes_required > max_bytes_ - byte_offset_)) return false;
+
+  byte_offset_ += static_cast<int>(bits_required >> 3);
+  bit_offset_ = static_cast<int>(bits_required & 7);
+
+  // Reset buffered_values_
+  int bytes_remaining = max_bytes_ - byte_offset_;
+  if (LIKELY(bytes_remaining >= 8)) {
+    memcpy(&buffered_values_, buffer_ + byte_offset_, 8);
+  } else {
+    memcpy(&buffered_values_, buffer_ + byte_offset_, bytes_remaining);
+  }
+  return true;
+}
+
 inline bool BitReader::GetVlqInt(int32_t* v) {
   *v = 0;
   int shift = 0;
@@ -231,6 +332,41 @@ inline bool BitReader::GetZigZagVlqInt(int32_t* v) {
   return true;
 }
 
+inline bool BitWriter::PutVlqInt64(uint64_t v) {
+  bool result = true;
+  while ((v & 0xFFFFFFFFFFFFFF80ULL) != 0) {
+    result &= PutAligned<uint8_t>((v & 0x7F) | 0x80, 1);
+    v >>= 7;
+  }
+  result &= PutAligned<uint8_t>(v & 0x7F, 1);
+  return result;
+}
+
+inline bool BitWriter::PutZigZagVlqInt64(int64_t v) {
+  uint64_t u = (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+  return PutVlqInt64(u);
+}
+
+inline bool BitReader::GetVlqInt64(uint64_t* v) {
+  *v = 0;
+  int shift = 0;
+  uint8_t byte = 0;
+  do {
+    if (shift >= 7 * MAX_VLQ64_BYTE_LEN) return false;
+    if (!GetAligned<uint8_t>(1, &byte)) return false;
+    *v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    shift += 7;
+  } while ((byte & 0x80) != 0);
+  return true;
+}
+
+inline bool BitReader::GetZigZagVlqInt64(int64_t* v) {
+  uint64_t u = 0;
+  if (!GetVlqInt64(&u)) return false;
+  *reinterpret_cast<uint64_t*>(v) = (u >> 1) ^ -(u & 1);
+  return true;
+}
+
 }  // namespace parquet
 
 #endif  // PARQUET_UTIL_BIT_STREAM_UTILS_INLINE_H
@@ -19,6 +19,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <limits.h>
 #include <gtest/gtest.h>
 
@@ -74,6 +75,33 @@ TEST(BitUtil, RoundDown) {
   EXPECT_EQ(BitUtil::RoundDown(100000000000, 10000000000), 100000000000);
 }
 
+TEST(BitUtil, SetArrayBits) {
+  for (bool is_set : {true, false}) {
+    for (int offset : {0, 1, 7, 8, 13}) {
+      for (int length : {0, 1, 6, 7, 8, 9, 30, 64}) {
+        uint8_t bits[12];
+        memset(bits, is_set ? 0 : 0xFF, sizeof(bits));
+        BitUtil::SetArrayBits(bits, offset, length, is_set);
+        for (int i = 0; i < 96; ++i) {
+          bool in_range = i >= offset && i < offset + length;
+          EXPECT_EQ(in_range == is_set, BitUtil::GetArrayBit(bits, i))
+              << offset << " " << length << " " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(BitUtil, SetOrClearArrayBit) {
+  uint8_t bits[2] = {0x0F, 0xF0};
+  BitUtil::SetOrClearArrayBit(bits, 1, false);
+  BitUtil::SetOrClearArrayBit(bits, 4, true);
+  BitUtil::SetOrClearArrayBit(bits, 12, false);
+  BitUtil::SetOrClearArrayBit(bits, 13, true);
+  EXPECT_EQ(0x1D, bits[0]);
+  EXPECT_EQ(0xE0, bits[1]);
+}
+
 TEST(BitUtil, Popcount) {
   ensure_cpu_info_initialized();
 
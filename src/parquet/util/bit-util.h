@@ -27,6 +27,7 @@
 #endif
 
 #include <cstdint>
+#include <cstring>
 
 #include "parquet/util/compiler-util.h"
 #include "parquet/util/cpu-info.h"
@@ -285,7 +286,7 @@ class BitUtil {
     return v | (static_cast<T>(0x1) << bitpos);
   }
 
-  static inline bool GetArrayBit(const uint8_t* bits, int i) {
+  static inline bool GetArrayBit(const uint8_t* bits, int64_t i) {
     return bits[i / 8] & (1 << (i % 8));
   }
 
@@ -293,6 +294,33 @@ class BitUtil {
     bits[i / 8] |= (1 << (i % 8)) * is_set;
   }
 
+  // Unlike SetArrayBit, also clears the bit if is_set is false
+  static inline void SetOrClearArrayBit(uint8_t* bits, int64_t i, bool is_set) {
+    bits[i / 8] = static_cast<uint8_t>(
+        (bits[i / 8] & ~(1 << (i % 8))) | (static_cast<int>(is_set) << (i % 8)));
+  }
+
+  // Sets (is_set) or clears the bits [offset, offset + length) of a bitmap, one
+  // byte at a time apart from the partial bytes at either end
+  static inline void SetArrayBits(
+      uint8_t* bits, int64_t offset, int64_t length, bool is_set) {
+    if (length <= 0) { return; }
+    int64_t end = offset + length;
+    int64_t first_byte = offset / 8;
+    int64_t last_byte = (end - 1) / 8;
+    uint8_t first_mask = static_cast<uint8_t>(0xFF << (offset % 8));
+    uint8_t last_mask = static_cast<uint8_t>(0xFF >> (7 - (end - 1) % 8));
+    if (first_byte == last_byte) { first_mask &= last_mask; }
+    bits[first_byte] = is_set ? (bits[first_byte] | first_mask)
+                              : (bits[first_byte] & ~first_mask);
+    if (first_byte == last_byte) { return; }
+    if (last_byte > first_byte + 1) {
+      memset(bits + first_byte + 1, is_set ? 0xFF : 0, last_byte - first_byte - 1);
+    }
+    bits[last_byte] =
+        is_set ? (bits[last_byte] | last_mask) : (bits[last_byte] & ~last_mask);
+  }
+
   // Set a specific bit to 0
   // Behavior when bitpos is negative is undefined
   template <typename T>
@@ -0,0 +1,318 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/bpacking-simd.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "parquet/util/bpacking.h"
+#include "parquet/util/cpu-info.h"
+
+// The vector kernels are compiled for their instruction set with function
+// attributes, independently of the flags of the build, and only run on CPUs
+// which support it
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARQUET_UNPACK_SIMD
+#include <immintrin.h>
+#endif
+
+namespace parquet {
+
+static int UnpackScalar(const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
+  return unpack32(in, out, batch_size, num_bits);
+}
+
+static int UnpackScalar(const uint32_t* in, uint64_t* out, int batch_size, int num_bits) {
+  batch_size = batch_size / 32 * 32;
+  uint32_t buffer[32];
+  for (int i = 0; i < batch_size; i += 32) {
+    unpack32(in, buffer, 32, num_bits);
+    std::copy(buffer, buffer + 32, out + i);
+    in += num_bits;
+  }
+  return batch_size;
+}
+
+// Looks the unpacked values up in dictionary unless it is nullptr
+template <typename OutType>
+static int UnpackScalar(const uint32_t* in, const OutType* dictionary, OutType* out,
+    int batch_size, int num_bits) {
+  if (dictionary == nullptr) { return UnpackScalar(in, out, batch_size, num_bits); }
+  batch_size = batch_size / 32 * 32;
+  uint32_t indices[32];
+  for (int i = 0; i < batch_size; i += 32) {
+    unpack32(in, indices, 32, num_bits);
+    for (int k = 0; k < 32; ++k) {
+      out[i + k] = dictionary[indices[k]];
+    }
+    in += num_bits;
+  }
+  return batch_size;
+}
+
+#ifdef PARQUET_UNPACK_SIMD
+
+// The vector kernels unpack groups of as many values as they have 32-bit lanes.
+// A group of N values of num_bits bits is N * num_bits / 8 bytes long, so each
+// group begins on a byte boundary and lane j takes bits j * num_bits onwards of
+// a vector loaded from there. They are spread over the word holding the first
+// bit (shifted right) and the next one (shifted left; shifts of 32 bits or more
+// yield 0), and found with a permutation of the loaded words.
+template <int N>
+struct LaneOffsets {
+  explicit LaneOffsets(int num_bits) {
+    for (int j = 0; j < N; ++j) {
+      int bit = j * num_bits;
+      lo_index[j] = bit / 32;
+      hi_index[j] = std::min(bit / 32 + 1, N - 1);
+      right_shift[j] = bit % 32;
+      left_shift[j] = 32 - bit % 32;
+    }
+  }
+
+  int32_t lo_index[N];
+  int32_t hi_index[N];
+  int32_t right_shift[N];
+  int32_t left_shift[N];
+};
+
+static uint32_t ValueMask(int num_bits) {
+  return num_bits == 32 ? 0xFFFFFFFFU : (1U << num_bits) - 1;
+}
+
+__attribute__((target("avx2"))) static inline void StoreAvx2(
+    __m256i values, uint32_t* out) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), values);
+}
+
+__attribute__((target("avx2"))) static inline void StoreAvx2(
+    __m256i values, uint64_t* out) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+      _mm256_cvtepu32_epi64(_mm256_castsi256_si128(values)));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4),
+      _mm256_cvtepu32_epi64(_mm256_extracti128_si256(values, 1)));
+}
+
+// Writes the dictionary entries of the indices to out
+__attribute__((target("avx2"))) static inline void GatherAvx2(
+    __m256i indices, const uint32_t* dictionary, uint32_t* out) {
+  StoreAvx2(
+      _mm256_i32gather_epi32(reinterpret_cast<const int*>(dictionary), indices, 4), out);
+}
+
+__attribute__((target("avx2"))) static inline void GatherAvx2(
+    __m256i indices, const uint64_t* dictionary, uint64_t* out) {
+  const long long* base = reinterpret_cast<const long long*>(dictionary);  // NOLINT
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+      _mm256_i32gather_epi64(base, _mm256_castsi256_si128(indices), 8));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4),
+      _mm256_i32gather_epi64(base, _mm256_extracti128_si256(indices, 1), 8));
+}
+
+template <typename OutType>
+__attribute__((target("avx2"))) static int UnpackAvx2(const uint32_t* in,
+    const OutType* dictionary, OutType* out, int batch_size, int num_bits) {
+  if (num_bits == 0) {
+    return UnpackScalar(in, dictionary, out, batch_size, num_bits);
+  }
+  int num_blocks = batch_size / 32;
+  LaneOffsets<8> offsets(num_bits);
+  const __m256i lo_index =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets.lo_index));
+  const __m256i hi_index =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets.hi_index));
+  const __m256i right_shift =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets.right_shift));
+  const __m256i left_shift =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets.left_shift));
+  const __m256i mask = _mm256_set1_epi32(static_cast<int>(ValueMask(num_bits)));
+
+  // A block of 32 values takes up 4 * num_bits bytes. The loads of its last
+  // group reach 32 bytes past the group's start, so the blocks at the end of
+  // the input for which that is beyond it are unpacked by the scalar kernel.
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(in);
+  const int64_t num_bytes = static_cast<int64_t>(num_blocks) * 4 * num_bits;
+  int block = 0;
+  for (; block < num_blocks; ++block) {
+    int64_t block_start = static_cast<int64_t>(block) * 4 * num_bits;
+    if (block_start + 3 * num_bits + 32 > num_bytes) { break; }
+    for (int group = 0; group < 4; ++group) {
+      __m256i words = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(bytes + block_start + group * num_bits));
+      __m256i lo = _mm256_permutevar8x32_epi32(words, lo_index);
+      __m256i hi = _mm256_permutevar8x32_epi32(words, hi_index);
+      __m256i values = _mm256_or_si256(
+          _mm256_srlv_epi32(lo, right_shift), _mm256_sllv_epi32(hi, left_shift));
+      values = _mm256_and_si256(values, mask);
+      if (dictionary == nullptr) {
+        StoreAvx2(values, out + block * 32 + group * 8);
+      } else {
+        GatherAvx2(values, dictionary, out + block * 32 + group * 8);
+      }
+    }
+  }
+  UnpackScalar(in + block * num_bits, dictionary, out + block * 32,
+      (num_blocks - block) * 32, num_bits);
+  return num_blocks * 32;
+}
+
+// GCC 12 reports the undefined upper lanes the AVX-512 intrinsics start from
+// as maybe uninitialized
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) static inline void StoreAvx512(
+    __m512i values, uint32_t* out) {
+  _mm512_storeu_si512(out, values);
+}
+
+__attribute__((target("avx512f"))) static inline void StoreAvx512(
+    __m512i values, uint64_t* out) {
+  _mm512_storeu_si512(out, _mm512_cvtepu32_epi64(_mm512_castsi512_si256(values)));
+  _mm512_storeu_si512(
+      out + 8, _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(values, 1)));
+}
+
+__attribute__((target("avx512f"))) static inline void GatherAvx512(
+    __m512i indices, const uint32_t* dictionary, uint32_t* out) {
+  StoreAvx512(_mm512_i32gather_epi32(indices, dictionary, 4), out);
+}
+
+__attribute__((target("avx512f"))) static inline void GatherAvx512(
+    __m512i indices, const uint64_t* dictionary, uint64_t* out) {
+  _mm512_storeu_si512(
+      out, _mm512_i32gather_epi64(_mm512_castsi512_si256(indices), dictionary, 8));
+  _mm512_storeu_si512(out + 8,
+      _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(indices, 1), dictionary, 8));
+}
+
+template <typename OutType>
+__attribute__((target("avx512f"))) static int UnpackAvx512(const uint32_t* in,
+    const OutType* dictionary, OutType* out, int batch_size, int num_bits) {
+  if (num_bits == 0) {
+    return UnpackScalar(in, dictionary, out, batch_size, num_bits);
+  }
+  int num_blocks = batch_size / 32;
+  LaneOffsets<16> offsets(num_bits);
+  const __m512i lo_index = _mm512_loadu_si512(offsets.lo_index);
+  const __m512i hi_index = _mm512_loadu_si512(offsets.hi_index);
+  const __m512i right_shift = _mm512_loadu_si512(offsets.right_shift);
+  const __m512i left_shift = _mm512_loadu_si512(offsets.left_shift);
+  const __m512i mask = _mm512_set1_epi32(static_cast<int>(ValueMask(num_bits)));
+
+  // As for AVX2, with two groups of 16 values per block and 64 byte loads
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(in);
+  const int64_t num_bytes = static_cast<int64_t>(num_blocks) * 4 * num_bits;
+  int block = 0;
+  for (; block < num_blocks; ++block) {
+    int64_t block_start = static_cast<int64_t>(block) * 4 * num_bits;
+    if (block_start + 2 * num_bits + 64 > num_bytes) { break; }
+    for (int group = 0; group < 2; ++group) {
+      __m512i words = _mm512_loadu_si512(bytes + block_start + group * 2 * num_bits);
+      __m512i lo = _mm512_permutexvar_epi32(lo_index, words);
+      __m512i hi = _mm512_permutexvar_epi32(hi_index, words);
+      __m512i values = _mm512_or_si512(
+          _mm512_srlv_epi32(lo, right_shift), _mm512_sllv_epi32(hi, left_shift));
+      values = _mm512_and_si512(values, mask);
+      if (dictionary == nullptr) {
+        StoreAvx512(values, out + block * 32 + group * 16);
+      } else {
+        GatherAvx512(values, dictionary, out + block * 32 + group * 16);
+      }
+    }
+  }
+  UnpackScalar(in + block * num_bits, dictionary, out + block * 32,
+      (num_blocks - block) * 32, num_bits);
+  return num_blocks * 32;
+}
+
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // PARQUET_UNPACK_SIMD
+
+template <typename OutType>
+static int Unpack(UnpackKernel::type kernel, const uint32_t* in,
+    const OutType* dictionary, OutType* out, int batch_size, int num_bits) {
+  switch (kernel) {
+#ifdef PARQUET_UNPACK_SIMD
+    case UnpackKernel::AVX512:
+      return UnpackAvx512(in, dictionary, out, batch_size, num_bits);
+    case UnpackKernel::AVX2:
+      return UnpackAvx2(in, dictionary, out, batch_size, num_bits);
+#endif
+    default:
+      return UnpackScalar(in, dictionary, out, batch_size, num_bits);
+  }
+}
+
+UnpackKernel::type BestUnpackKernel() {
+#ifdef PARQUET_UNPACK_SIMD
+  if (!CpuInfo::initialized()) { CpuInfo::Init(); }
+  if (CpuInfo::IsSupported(CpuInfo::AVX512)) { return UnpackKernel::AVX512; }
+  if (CpuInfo::IsSupported(CpuInfo::AVX2)) { return UnpackKernel::AVX2; }
+#endif
+  return UnpackKernel::SCALAR;
+}
+
+int UnpackBits32(const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
+  static const UnpackKernel::type kernel = BestUnpackKernel();
+  return Unpack<uint32_t>(kernel, in, nullptr, out, batch_size, num_bits);
+}
+
+int UnpackBits64(const uint32_t* in, uint64_t* out, int batch_size, int num_bits) {
+  static const UnpackKernel::type kernel = BestUnpackKernel();
+  return Unpack<uint64_t>(kernel, in, nullptr, out, batch_size, num_bits);
+}
+
+int UnpackBits32(UnpackKernel::type kernel, const uint32_t* in, uint32_t* out,
+    int batch_size, int num_bits) {
+  return Unpack<uint32_t>(kernel, in, nullptr, out, batch_size, num_bits);
+}
+
+int UnpackBits64(UnpackKernel::type kernel, const uint32_t* in, uint64_t* out,
+    int batch_size, int num_bits) {
+  return Unpack<uint64_t>(kernel, in, nullptr, out, batch_size, num_bits);
+}
+
+int UnpackDict32(const uint32_t* in, const uint32_t* dictionary, uint32_t* out,
+    int batch_size, int num_bits) {
+  static const UnpackKernel::type kernel = BestUnpackKernel();
+  return Unpack(kernel, in, dictionary, out, batch_size, num_bits);
+}
+
+int UnpackDict64(const uint32_t* in, const uint64_t* dictionary, uint64_t* out,
+    int batch_size, int num_bits) {
+  static const UnpackKernel::type kernel = BestUnpackKernel();
+  return Unpack(kernel, in, dictionary, out, batch_size, num_bits);
+}
+
+int UnpackDict32(UnpackKernel::type kernel, const uint32_t* in,
+    const uint32_t* dictionary, uint32_t* out, int batch_size, int num_bits) {
+  return Unpack(kernel, in, dictionary, out, batch_size, num_bits);
+}
+
+int UnpackDict64(UnpackKernel::type kernel, const uint32_t* in,
+    const uint64_t* dictionary, uint64_t* out, int batch_size, int num_bits) {
+  return Unpack(kernel, in, dictionary, out, batch_size, num_bits);
+}
+
+}  // namespace parquet
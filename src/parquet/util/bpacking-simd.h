@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Bit unpacking kernels for the layout of bpacking.h, selected at runtime by
+// the instruction sets the CPU supports
+
+#ifndef PARQUET_UTIL_BPACKING_SIMD_H
+#define PARQUET_UTIL_BPACKING_SIMD_H
+
+#include <cstdint>
+
+namespace parquet {
+
+struct UnpackKernel {
+  // From narrowest to widest; SCALAR is unpack32 of bpacking.h
+  enum type { SCALAR, AVX2, AVX512 };
+};
+
+// Returns the widest kernel that the compiler can build and CpuInfo reports the
+// CPU supports
+UnpackKernel::type BestUnpackKernel();
+
+// Unpacks batch_size / 32 * 32 values of num_bits bits (0 to 32), packed LSB
+// first, from in to out with BestUnpackKernel(). Returns the number of values
+// unpacked; the input they took up is num_bits words per 32 values.
+int UnpackBits32(const uint32_t* in, uint32_t* out, int batch_size, int num_bits);
+
+// Like UnpackBits32, but widens the values to 64 bits
+int UnpackBits64(const uint32_t* in, uint64_t* out, int batch_size, int num_bits);
+
+// Like the above with the given kernel, which must be supported
+int UnpackBits32(UnpackKernel::type kernel, const uint32_t* in, uint32_t* out,
+    int batch_size, int num_bits);
+int UnpackBits64(UnpackKernel::type kernel, const uint32_t* in, uint64_t* out,
+    int batch_size, int num_bits);
+
+// Like UnpackBits32 and UnpackBits64, but the values are indices which are
+// decoded into their entries of dictionary. The vector kernels gather the
+// entries straight from the unpacked indices, which must all be valid.
+int UnpackDict32(const uint32_t* in, const uint32_t* dictionary, uint32_t* out,
+    int batch_size, int num_bits);
+int UnpackDict64(const uint32_t* in, const uint64_t* dictionary, uint64_t* out,
+    int batch_size, int num_bits);
+
+int UnpackDict32(UnpackKernel::type kernel, const uint32_t* in,
+    const uint32_t* dictionary, uint32_t* out, int batch_size, int num_bits);
+int UnpackDict64(UnpackKernel::type kernel, const uint32_t* in,
+    const uint64_t* dictionary, uint64_t* out, int batch_size, int num_bits);
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_BPACKING_SIMD_H
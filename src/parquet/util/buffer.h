@@ -100,6 +100,8 @@ class PARQUET_EXPORT ResizableBuffer : public MutableBuffer {
  public:
   virtual void Resize(int64_t new_size) = 0;
 
+  int64_t capacity() const { return capacity_; }
+
  protected:
   ResizableBuffer(uint8_t* data, int64_t size)
       : MutableBuffer(data, size), capacity_(size) {}
@@ -134,6 +136,8 @@ class Vector {
   void Assign(int64_t size, const T val);
   void Swap(Vector<T>& v);
   inline T& operator[](int64_t i) const { return data_[i]; }
+  int64_t size() const { return size_; }
+  const T* data() const { return data_; }
 
  private:
   std::unique_ptr<OwnedMutableBuffer> buffer_;
@@ -38,6 +38,9 @@ class CpuInfo {
   static const int64_t SSE4_1 = (1 << 2);
   static const int64_t SSE4_2 = (1 << 3);
   static const int64_t POPCNT = (1 << 4);
+  static const int64_t AVX2 = (1 << 5);
+  // AVX-512 Foundation
+  static const int64_t AVX512 = (1 << 6);
 
   /// Cache enums for L1 (data), L2 and L3
   enum CacheLevel {
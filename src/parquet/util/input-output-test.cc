@@ -23,6 +23,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "parquet/exception.h"
@@ -95,6 +96,63 @@ TEST(TestBufferedInputStream, Basics) {
   }
 }
 
+TEST(TestInMemoryInputStream, ReadBuffer) {
+  auto buf = std::make_shared<OwnedMutableBuffer>(100);
+  for (int i = 0; i < 100; i++) {
+    buf->mutable_data()[i] = i;
+  }
+
+  std::shared_ptr<Buffer> slice;
+  {
+    InMemoryInputStream stream(buf);
+    stream.Advance(10);
+    slice = stream.ReadBuffer(20);
+
+    // The stream position advances past the slice
+    int64_t bytes_read;
+    const uint8_t* output = stream.Read(1, &bytes_read);
+    ASSERT_EQ(30, output[0]);
+
+    // Reading past the end truncates
+    ASSERT_EQ(69, stream.ReadBuffer(100)->size());
+  }
+  buf.reset();
+
+  // The slice keeps the stream's memory alive
+  ASSERT_TRUE(slice->is_shared());
+  ASSERT_EQ(20, slice->size());
+  for (int i = 0; i < 20; i++) {
+    ASSERT_EQ(10 + i, slice->data()[i]) << i;
+  }
+}
+
+TEST(TestCoalesceReadRanges, Basics) {
+  auto check = [](const std::vector<ReadRange>& expected,
+      const std::vector<ReadRange>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].offset, actual[i].offset) << i;
+      ASSERT_EQ(expected[i].length, actual[i].length) << i;
+    }
+  };
+
+  check({}, CoalesceReadRanges({}, 10, 100));
+
+  // Unsorted input, two holes within the limit and one too large
+  check({{0, 40}, {100, 10}},
+      CoalesceReadRanges({{30, 10}, {0, 10}, {100, 10}, {15, 10}}, 10, 1000));
+
+  // Adjacent ranges are merged even with a zero hole size limit
+  check({{0, 20}, {30, 5}}, CoalesceReadRanges({{0, 10}, {10, 10}, {30, 5}}, 0, 1000));
+
+  // Merging stops at the range size limit, but a single large range is kept
+  check({{0, 20}, {20, 10}, {30, 500}},
+      CoalesceReadRanges({{0, 10}, {10, 10}, {20, 10}, {30, 500}}, 0, 20));
+
+  // Overlapping and nested ranges always collapse
+  check({{0, 50}}, CoalesceReadRanges({{0, 50}, {10, 5}, {40, 10}}, 0, 10));
+}
+
 TEST(TestInMemoryOutputStream, Basics) {
   std::unique_ptr<InMemoryOutputStream> stream(new InMemoryOutputStream(8));
 
@@ -142,6 +200,84 @@ TEST(TestBufferedReader, Basics) {
   reader.Close();
 }
 
+TEST(TestBufferedReader, ReadAt) {
+  std::vector<uint8_t> data = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  auto buffer = std::make_shared<Buffer>(data.data(), data.size());
+  BufferReader reader(buffer);
+
+  uint8_t out[4];
+  ASSERT_EQ(4, reader.ReadAt(6, 4, out));
+  ASSERT_EQ(6, out[0]);
+  ASSERT_EQ(9, out[3]);
+
+  // The current position is not used or moved by positional reads
+  ASSERT_EQ(0, reader.Tell());
+
+  auto out_buffer = reader.ReadAt(10, 5);
+  ASSERT_EQ(3, out_buffer->size());
+  ASSERT_EQ(10, out_buffer->data()[0]);
+  ASSERT_EQ(0, reader.Tell());
+
+  ASSERT_THROW(reader.ReadAt(13, 1), ParquetException);
+  ASSERT_THROW(reader.ReadAt(-1, 1, out), ParquetException);
+}
+
+// A source which only implements Seek and Read, so positional reads take the
+// RandomAccessSource fallback
+class SeekingReader : public RandomAccessSource {
+ public:
+  explicit SeekingReader(const std::shared_ptr<Buffer>& buffer) : reader_(buffer) {
+    size_ = buffer->size();
+  }
+
+  void Close() override {}
+  int64_t Tell() const override { return reader_.Tell(); }
+  void Seek(int64_t pos) override { reader_.Seek(pos); }
+
+  int64_t Read(int64_t nbytes, uint8_t* out) override {
+    // Widen the window between the seek and the read
+    std::this_thread::yield();
+    return reader_.Read(nbytes, out);
+  }
+
+  std::shared_ptr<Buffer> Read(int64_t nbytes) override {
+    std::this_thread::yield();
+    return reader_.Read(nbytes);
+  }
+
+ private:
+  BufferReader reader_;
+};
+
+TEST(TestRandomAccessSource, ConcurrentReadAtFallback) {
+  std::vector<uint8_t> data(4096);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i / 16);
+  }
+  SeekingReader reader(std::make_shared<Buffer>(data.data(), data.size()));
+
+  const int num_threads = 8;
+  std::vector<int> mismatches(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&reader, &mismatches, t]() {
+      uint8_t out[16];
+      for (int i = 0; i < 1000; ++i) {
+        int64_t block = (t * 1000 + i) % 256;
+        if (reader.ReadAt(block * 16, 16, out) != 16 || out[0] != block ||
+            out[15] != block) {
+          ++mismatches[t];
+        }
+        if (reader.ReadAt(block * 16, 16)->data()[8] != block) { ++mismatches[t]; }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(std::vector<int>(num_threads, 0), mismatches);
+}
+
 static bool file_exists(const std::string& path) {
   return std::ifstream(path.c_str()).good();
 }
@@ -196,6 +332,24 @@ TYPED_TEST(TestFileReaders, Read) {
   ASSERT_EQ(0, memcmp(this->test_data_.c_str() + 4, buffer->data(), 7));
 }
 
+TYPED_TEST(TestFileReaders, ReadAt) {
+  this->source.Open(this->test_path_);
+
+  uint8_t out[4];
+  ASSERT_EQ(4, this->source.ReadAt(3, 4, out));
+  ASSERT_EQ(0, memcmp(this->test_data_.c_str() + 3, out, 4));
+
+  // Read past EOF
+  std::shared_ptr<Buffer> buffer = this->source.ReadAt(7, 10);
+  ASSERT_EQ(4, buffer->size());
+  ASSERT_EQ(0, memcmp(this->test_data_.c_str() + 7, buffer->data(), 4));
+
+  // The current position is not used or moved by positional reads
+  ASSERT_EQ(0, this->source.Tell());
+
+  ASSERT_THROW(this->source.ReadAt(this->filesize_ + 1, 1), ParquetException);
+}
+
 TYPED_TEST(TestFileReaders, FileDisappeared) {
   this->source.Open(this->test_path_);
   this->source.Seek(4);
@@ -18,7 +18,9 @@
 #include "parquet/util/input.h"
 
 #include <sys/mman.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cerrno>
 #include <sstream>
 #include <string>
 
@@ -28,14 +30,61 @@
 
 namespace parquet {
 
+// ----------------------------------------------------------------------
+// Read planning
+
+std::vector<ReadRange> CoalesceReadRanges(
+    std::vector<ReadRange> ranges, int64_t hole_size_limit, int64_t range_size_limit) {
+  std::vector<ReadRange> result;
+  if (ranges.empty()) { return result; }
+
+  std::sort(ranges.begin(), ranges.end(),
+      [](const ReadRange& a, const ReadRange& b) { return a.offset < b.offset; });
+
+  ReadRange current = ranges[0];
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    const ReadRange& next = ranges[i];
+    int64_t current_end = current.offset + current.length;
+    int64_t merged_end = std::max(current_end, next.offset + next.length);
+    // Overlapping ranges must always be merged so that each input range is
+    // contained in exactly one output range
+    bool overlaps = next.offset < current_end;
+    bool small_hole = next.offset - current_end <= hole_size_limit;
+    bool fits = merged_end - current.offset <= range_size_limit;
+    if (overlaps || (small_hole && fits)) {
+      current.length = merged_end - current.offset;
+    } else {
+      result.push_back(current);
+      current = next;
+    }
+  }
+  result.push_back(current);
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // RandomAccessSource
 
+int64_t RandomAccessSource::ReadAt(int64_t pos, int64_t nbytes, uint8_t* out) {
+  std::lock_guard<std::mutex> lock(read_at_mutex_);
+  Seek(pos);
+  return Read(nbytes, out);
+}
+
 std::shared_ptr<Buffer> RandomAccessSource::ReadAt(int64_t pos, int64_t nbytes) {
+  std::lock_guard<std::mutex> lock(read_at_mutex_);
   Seek(pos);
   return Read(nbytes);
 }
 
+static void CheckReadPosition(int64_t pos, int64_t size) {
+  if (pos < 0 || pos >= size) {
+    std::stringstream ss;
+    ss << "Position " << pos << " is not in range.";
+    throw ParquetException(ss.str());
+  }
+}
+
 int64_t RandomAccessSource::Size() const {
   return size_;
 }
@@ -113,6 +162,36 @@ std::shared_ptr<Buffer> LocalFileSource::Read(int64_t nbytes) {
   if (bytes_read < nbytes) { result->Resize(bytes_read); }
   return result;
 }
+
+int64_t LocalFileSource::ReadAt(int64_t pos, int64_t nbytes, uint8_t* out) {
+  CheckReadPosition(pos, size_);
+  int fd = file_descriptor();
+  int64_t total_bytes_read = 0;
+  // pread may return fewer bytes than requested, so loop until EOF
+  while (total_bytes_read < nbytes) {
+    ssize_t ret = pread(fd, out + total_bytes_read,
+        static_cast<size_t>(nbytes - total_bytes_read), pos + total_bytes_read);
+    if (ret == -1) {
+      if (errno == EINTR) { continue; }
+      std::stringstream ss;
+      ss << "File read at position " << pos + total_bytes_read << " failed.";
+      throw ParquetException(ss.str());
+    }
+    if (ret == 0) { break; }
+    total_bytes_read += ret;
+  }
+  return total_bytes_read;
+}
+
+std::shared_ptr<Buffer> LocalFileSource::ReadAt(int64_t pos, int64_t nbytes) {
+  auto result = std::make_shared<OwnedMutableBuffer>(0, allocator_);
+  result->Resize(nbytes);
+
+  int64_t bytes_read = ReadAt(pos, nbytes, result->mutable_data());
+  if (bytes_read < nbytes) { result->Resize(bytes_read); }
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // MemoryMapSource methods
 
@@ -167,6 +246,19 @@ std::shared_ptr<Buffer> MemoryMapSource::Read(int64_t nbytes) {
   return result;
 }
 
+int64_t MemoryMapSource::ReadAt(int64_t pos, int64_t nbytes, uint8_t* out) {
+  CheckReadPosition(pos, size_);
+  int64_t bytes_available = std::min(nbytes, size_ - pos);
+  memcpy(out, data_ + pos, bytes_available);
+  return bytes_available;
+}
+
+std::shared_ptr<Buffer> MemoryMapSource::ReadAt(int64_t pos, int64_t nbytes) {
+  CheckReadPosition(pos, size_);
+  int64_t bytes_available = std::min(nbytes, size_ - pos);
+  return std::make_shared<Buffer>(data_ + pos, bytes_available);
+}
+
 // ----------------------------------------------------------------------
 // BufferReader
 
@@ -202,6 +294,29 @@ std::shared_ptr<Buffer> BufferReader::Read(int64_t nbytes) {
   return result;
 }
 
+int64_t BufferReader::ReadAt(int64_t pos, int64_t nbytes, uint8_t* out) {
+  CheckReadPosition(pos, size_);
+  int64_t bytes_available = std::min(nbytes, size_ - pos);
+  memcpy(out, data_ + pos, bytes_available);
+  return bytes_available;
+}
+
+std::shared_ptr<Buffer> BufferReader::ReadAt(int64_t pos, int64_t nbytes) {
+  CheckReadPosition(pos, size_);
+  int64_t bytes_available = std::min(nbytes, size_ - pos);
+  // Keep the parent buffer alive for as long as the slice is referenced
+  return std::make_shared<Buffer>(buffer_, pos, bytes_available);
+}
+
+// ----------------------------------------------------------------------
+// InputStream
+
+std::shared_ptr<Buffer> InputStream::ReadBuffer(int64_t num_to_read) {
+  int64_t num_bytes = 0;
+  const uint8_t* data = Read(num_to_read, &num_bytes);
+  return std::make_shared<Buffer>(data, num_bytes);
+}
+
 // ----------------------------------------------------------------------
 // InMemoryInputStream
 
@@ -235,6 +350,13 @@ void InMemoryInputStream::Advance(int64_t num_bytes) {
   offset_ += num_bytes;
 }
 
+std::shared_ptr<Buffer> InMemoryInputStream::ReadBuffer(int64_t num_to_read) {
+  int64_t num_bytes = std::min(num_to_read, len_ - offset_);
+  auto result = std::make_shared<Buffer>(buffer_, offset_, num_bytes);
+  offset_ += num_bytes;
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // BufferedInputStream
 BufferedInputStream::BufferedInputStream(MemoryAllocator* pool, int64_t buffer_size,
@@ -256,9 +378,9 @@ const uint8_t* BufferedInputStream::Peek(int64_t num_to_peek, int64_t* num_bytes
   }
   // Read more data when buffer has insufficient left or when resized
   if (*num_bytes > (buffer_size_ - buffer_offset_)) {
-    source_->Seek(stream_offset_);
     buffer_size_ = std::min(buffer_size_, stream_end_ - stream_offset_);
-    int64_t bytes_read = source_->Read(buffer_size_, buffer_->mutable_data());
+    int64_t bytes_read =
+        source_->ReadAt(stream_offset_, buffer_size_, buffer_->mutable_data());
     if (bytes_read < *num_bytes) {
       throw ParquetException("Failed reading column data from source");
     }
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,23 @@ namespace parquet {
 class Buffer;
 class OwnedMutableBuffer;
 
+// ----------------------------------------------------------------------
+// Read planning
+
+// A contiguous byte range [offset, offset + length) within a RandomAccessSource
+struct ReadRange {
+  int64_t offset;
+  int64_t length;
+};
+
+// Merge ranges separated by at most hole_size_limit bytes into larger ranges,
+// so that many small reads can be issued as a few large ones. A range is not
+// grown past range_size_limit bytes by merging (a single input range larger
+// than the limit is left intact). The input need not be sorted; the output is
+// sorted by offset and every input range is fully contained in one output range.
+PARQUET_EXPORT std::vector<ReadRange> CoalesceReadRanges(
+    std::vector<ReadRange> ranges, int64_t hole_size_limit, int64_t range_size_limit);
+
 // ----------------------------------------------------------------------
 // Random access input (e.g. file-like)
 
@@ -49,10 +67,23 @@ class PARQUET_EXPORT RandomAccessSource {
   virtual int64_t Read(int64_t nbytes, uint8_t* out) = 0;
 
   virtual std::shared_ptr<Buffer> Read(int64_t nbytes) = 0;
-  std::shared_ptr<Buffer> ReadAt(int64_t pos, int64_t nbytes);
+
+  // Positional reads, which may be called from several threads at once (the
+  // parallel scans of ParquetFileReader rely on this). The default
+  // implementations fall back on Seek followed by Read under a lock, so they
+  // move the current position and concurrent calls are serialized. Sources
+  // which can read without shared state should override both.
+  //
+  // Returns actual number of bytes read
+  virtual int64_t ReadAt(int64_t pos, int64_t nbytes, uint8_t* out);
+
+  virtual std::shared_ptr<Buffer> ReadAt(int64_t pos, int64_t nbytes);
 
  protected:
   int64_t size_;
+
+ private:
+  std::mutex read_at_mutex_;
 };
 
 class PARQUET_EXPORT LocalFileSource : public RandomAccessSource {
@@ -73,6 +104,11 @@ class PARQUET_EXPORT LocalFileSource : public RandomAccessSource {
 
   virtual std::shared_ptr<Buffer> Read(int64_t nbytes);
 
+  // Thread-safe positional reads using pread
+  virtual int64_t ReadAt(int64_t pos, int64_t nbytes, uint8_t* out);
+
+  virtual std::shared_ptr<Buffer> ReadAt(int64_t pos, int64_t nbytes);
+
   bool is_open() const { return is_open_; }
   const std::string& path() const { return path_; }
 
@@ -109,6 +145,11 @@ class PARQUET_EXPORT MemoryMapSource : public LocalFileSource {
   // Return a buffer referencing memory-map (no copy)
   virtual std::shared_ptr<Buffer> Read(int64_t nbytes);
 
+  // Thread-safe positional reads from the memory map
+  virtual int64_t ReadAt(int64_t pos, int64_t nbytes, uint8_t* out);
+
+  virtual std::shared_ptr<Buffer> ReadAt(int64_t pos, int64_t nbytes);
+
  private:
   void CloseFile();
 
@@ -130,6 +171,11 @@ class PARQUET_EXPORT BufferReader : public RandomAccessSource {
 
   virtual std::shared_ptr<Buffer> Read(int64_t nbytes);
 
+  // Thread-safe positional reads from the buffer
+  virtual int64_t ReadAt(int64_t pos, int64_t nbytes, uint8_t* out);
+
+  virtual std::shared_ptr<Buffer> ReadAt(int64_t pos, int64_t nbytes);
+
  protected:
   const uint8_t* Head() { return data_ + pos_; }
 
@@ -161,6 +207,12 @@ class InputStream {
   // Advance the stream without reading
   virtual void Advance(int64_t num_bytes) = 0;
 
+  // Identical to Read(), but returns the bytes as a Buffer. By default the Buffer
+  // does not own its data and is only valid until the next call to Peek() or
+  // Read(). Streams whose memory outlives them return a slice which keeps that
+  // memory alive (Buffer::is_shared() is true).
+  virtual std::shared_ptr<Buffer> ReadBuffer(int64_t num_to_read);
+
   virtual ~InputStream() {}
 
  protected:
@@ -177,6 +229,8 @@ class InMemoryInputStream : public InputStream {
 
   virtual void Advance(int64_t num_bytes);
 
+  virtual std::shared_ptr<Buffer> ReadBuffer(int64_t num_to_read);
+
  private:
   std::shared_ptr<Buffer> buffer_;
   int64_t len_;
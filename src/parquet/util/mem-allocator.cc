@@ -30,8 +30,10 @@ uint8_t* TrackingAllocator::Malloc(int64_t size) {
 
   uint8_t* p = static_cast<uint8_t*>(std::malloc(size));
   if (!p) { throw ParquetException("OOM: memory allocation failed"); }
-  total_memory_ += size;
-  if (total_memory_ > max_memory_) { max_memory_ = total_memory_; }
+  int64_t total_memory = total_memory_ += size;
+  int64_t max_memory = max_memory_;
+  while (total_memory > max_memory &&
+         !max_memory_.compare_exchange_weak(max_memory, total_memory)) {}
   return p;
 }
 
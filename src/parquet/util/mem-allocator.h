@@ -18,6 +18,7 @@
 #ifndef PARQUET_UTIL_MEMORY_POOL_H
 #define PARQUET_UTIL_MEMORY_POOL_H
 
+#include <atomic>
 #include <cstdint>
 
 #include "parquet/util/visibility.h"
@@ -35,6 +36,7 @@ class PARQUET_EXPORT MemoryAllocator {
 
 PARQUET_EXPORT MemoryAllocator* default_allocator();
 
+// Safe to share between threads
 class PARQUET_EXPORT TrackingAllocator : public MemoryAllocator {
  public:
   TrackingAllocator() : total_memory_(0), max_memory_(0) {}
@@ -48,8 +50,8 @@ class PARQUET_EXPORT TrackingAllocator : public MemoryAllocator {
   int64_t MaxMemory() { return max_memory_; }
 
  private:
-  int64_t total_memory_;
-  int64_t max_memory_;
+  std::atomic<int64_t> total_memory_;
+  std::atomic<int64_t> max_memory_;
 };
 
 }  // namespace parquet
@@ -22,6 +22,11 @@
 
 #include <math.h>
 #include <algorithm>
+#include <cstring>
+
+#ifdef PARQUET_USE_SSE
+#include <emmintrin.h>
+#endif
 
 #include "parquet/util/compiler-util.h"
 #include "parquet/util/bit-stream-utils.inline.h"
@@ -80,6 +85,71 @@ namespace parquet {
 /// (total 26 bytes, 1 byte overhead)
 //
 
+/// Returns the number of the first num_values entries of values equal to value.
+template <typename T>
+inline int64_t CountEqual(const T* values, int num_values, T value) {
+  int64_t count = 0;
+  for (int i = 0; i < num_values; ++i) {
+    count += values[i] == value;
+  }
+  return count;
+}
+
+/// int16_t version used for levels; compares 8 values at a time with SSE2.
+inline int64_t CountEqual(const int16_t* values, int num_values, int16_t value) {
+  int64_t count = 0;
+  int i = 0;
+#ifdef PARQUET_USE_SSE
+  const __m128i needle = _mm_set1_epi16(value);
+  while (num_values - i >= 8) {
+    // Each lane subtracts the all-ones compare mask, i.e. adds one per match. Lanes
+    // are summed after at most 4096 steps so they cannot overflow.
+    int block_end = i + std::min((num_values - i) / 8, 4096) * 8;
+    __m128i counts = _mm_setzero_si128();
+    for (; i < block_end; i += 8) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+      counts = _mm_sub_epi16(counts, _mm_cmpeq_epi16(v, needle));
+    }
+    uint16_t lanes[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+    for (int k = 0; k < 8; ++k) {
+      count += lanes[k];
+    }
+  }
+#endif
+  for (; i < num_values; ++i) {
+    count += values[i] == value;
+  }
+  return count;
+}
+
+/// Sets the first num_values entries of values to value. Values of 4 and 8 bytes
+/// are broadcast to 32 bytes at a time with SSE2.
+template <typename T>
+inline void FillValues(T* values, int num_values, const T& value) {
+  int i = 0;
+#ifdef PARQUET_USE_SSE
+  if (sizeof(T) == 4 || sizeof(T) == 8) {
+    __m128i v;
+    if (sizeof(T) == 4) {
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      v = _mm_set1_epi32(static_cast<int>(bits));
+    } else {
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      v = _mm_set1_epi64x(static_cast<int64_t>(bits));
+    }
+    const int per_store = 16 / sizeof(T);
+    for (; num_values - i >= 2 * per_store; i += 2 * per_store) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), v);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i + per_store), v);
+    }
+  }
+#endif
+  std::fill(values + i, values + num_values, value);
+}
+
 /// Decoder class for RLE encoded data.
 class RleDecoder {
  public:
@@ -115,6 +185,38 @@ class RleDecoder {
   template <typename T>
   int GetBatch(T* values, int batch_size);
 
+  /// Like GetBatch, but also adds the number of decoded values equal to 'value' to
+  /// *num_equal. Repeated runs are counted without looking at the decoded values.
+  template <typename T>
+  int GetBatchAndCount(T* values, int batch_size, T value, int64_t* num_equal);
+
+  /// Skips over up to 'num_values' values and returns the number skipped. Repeated
+  /// runs are skipped in constant time and literal runs by advancing the bit
+  /// position, without decoding any values.
+  int Skip(int num_values);
+
+  /// Like Skip, but also adds the number of skipped values equal to 'value' to
+  /// *num_equal. Literal runs have to be decoded for counting.
+  template <typename T>
+  int SkipAndCount(int num_values, T value, int64_t* num_equal);
+
+  /// Decodes up to 'batch_size' values, setting bit valid_bits_offset + i of
+  /// 'valid_bits' if the i-th one is equal to 'value' and clearing it otherwise,
+  /// instead of storing the values. Adds the number of set bits to *num_equal.
+  /// Repeated runs are written a byte at a time. Returns the number of decoded
+  /// values.
+  template <typename T>
+  int GetValidBits(int batch_size, T value, uint8_t* valid_bits,
+      int64_t valid_bits_offset, int64_t* num_equal);
+
+  /// Decodes up to 'batch_size' values, which are indices into 'mask' of
+  /// 'mask_size' entries, and appends the position first_position + i of every
+  /// i-th value whose mask entry is non-zero to selection[*num_selected],
+  /// incrementing *num_selected. Values outside of the mask are not selected.
+  /// Repeated runs are tested once. Returns the number of decoded values.
+  int GetSelection(int batch_size, const uint8_t* mask, int64_t mask_size,
+      int32_t first_position, int32_t* selection, int64_t* num_selected);
+
   /// Like GetBatch but the values are then decoded using the provided dictionary
   template <typename T>
   int GetBatchWithDict(const Vector<T>& dictionary, T* values, int batch_size);
@@ -302,8 +404,8 @@ inline int RleDecoder::GetBatch(T* values, int batch_size) {
 }
 
 template <typename T>
-inline int RleDecoder::GetBatchWithDict(
-    const Vector<T>& dictionary, T* values, int batch_size) {
+inline int RleDecoder::GetBatchAndCount(
+    T* values, int batch_size, T value, int64_t* num_equal) {
   DCHECK_GE(bit_width_, 0);
   int values_read = 0;
 
@@ -311,21 +413,111 @@ inline int RleDecoder::GetBatchWithDict(
     if (repeat_count_ > 0) {
       int repeat_batch =
           std::min(batch_size - values_read, static_cast<int>(repeat_count_));
-      std::fill(values + values_read, values + values_read + repeat_batch,
-          dictionary[current_value_]);
+      std::fill(
+          values + values_read, values + values_read + repeat_batch, current_value_);
+      if (static_cast<T>(current_value_) == value) { *num_equal += repeat_batch; }
       repeat_count_ -= repeat_batch;
       values_read += repeat_batch;
     } else if (literal_count_ > 0) {
       int literal_batch =
           std::min(batch_size - values_read, static_cast<int>(literal_count_));
+      int actual_read =
+          bit_reader_.GetBatch(bit_width_, values + values_read, literal_batch);
+      DCHECK_EQ(actual_read, literal_batch);
+      *num_equal += CountEqual(values + values_read, literal_batch, value);
+      literal_count_ -= literal_batch;
+      values_read += literal_batch;
+    } else {
+      if (!NextCounts<T>()) return values_read;
+    }
+  }
+
+  return values_read;
+}
 
-      const int buffer_size = 1024;
-      static int indices[buffer_size];
-      literal_batch = std::min(literal_batch, buffer_size);
-      int actual_read = bit_reader_.GetBatch(bit_width_, &indices[0], literal_batch);
+inline int RleDecoder::Skip(int num_values) {
+  DCHECK_GE(bit_width_, 0);
+  int values_skipped = 0;
+
+  while (values_skipped < num_values) {
+    if (repeat_count_ > 0) {
+      int repeat_batch =
+          std::min(num_values - values_skipped, static_cast<int>(repeat_count_));
+      repeat_count_ -= repeat_batch;
+      values_skipped += repeat_batch;
+    } else if (literal_count_ > 0) {
+      int literal_batch =
+          std::min(num_values - values_skipped, static_cast<int>(literal_count_));
+      bool result = bit_reader_.Advance(static_cast<int64_t>(literal_batch) * bit_width_);
+      DCHECK(result);
+      literal_count_ -= literal_batch;
+      values_skipped += literal_batch;
+    } else {
+      if (!NextCounts<uint64_t>()) return values_skipped;
+    }
+  }
+
+  return values_skipped;
+}
+
+template <typename T>
+inline int RleDecoder::SkipAndCount(int num_values, T value, int64_t* num_equal) {
+  DCHECK_GE(bit_width_, 0);
+  const int buffer_size = 1024;
+  T literal_buffer[buffer_size];
+  int values_skipped = 0;
+
+  while (values_skipped < num_values) {
+    if (repeat_count_ > 0) {
+      int repeat_batch =
+          std::min(num_values - values_skipped, static_cast<int>(repeat_count_));
+      if (static_cast<T>(current_value_) == value) { *num_equal += repeat_batch; }
+      repeat_count_ -= repeat_batch;
+      values_skipped += repeat_batch;
+    } else if (literal_count_ > 0) {
+      int literal_batch = std::min(std::min(num_values - values_skipped, buffer_size),
+          static_cast<int>(literal_count_));
+      int actual_read = bit_reader_.GetBatch(bit_width_, literal_buffer, literal_batch);
       DCHECK_EQ(actual_read, literal_batch);
+      *num_equal += CountEqual(literal_buffer, literal_batch, value);
+      literal_count_ -= literal_batch;
+      values_skipped += literal_batch;
+    } else {
+      if (!NextCounts<T>()) return values_skipped;
+    }
+  }
+
+  return values_skipped;
+}
+
+template <typename T>
+inline int RleDecoder::GetValidBits(int batch_size, T value, uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t* num_equal) {
+  DCHECK_GE(bit_width_, 0);
+  const int buffer_size = 1024;
+  T literal_buffer[buffer_size];
+  int values_read = 0;
+
+  while (values_read < batch_size) {
+    if (repeat_count_ > 0) {
+      int repeat_batch =
+          std::min(batch_size - values_read, static_cast<int>(repeat_count_));
+      bool is_equal = static_cast<T>(current_value_) == value;
+      BitUtil::SetArrayBits(
+          valid_bits, valid_bits_offset + values_read, repeat_batch, is_equal);
+      if (is_equal) { *num_equal += repeat_batch; }
+      repeat_count_ -= repeat_batch;
+      values_read += repeat_batch;
+    } else if (literal_count_ > 0) {
+      int literal_batch = std::min(std::min(batch_size - values_read, buffer_size),
+          static_cast<int>(literal_count_));
+      int actual_read = bit_reader_.GetBatch(bit_width_, literal_buffer, literal_batch);
+      DCHECK_EQ(actual_read, literal_batch);
+      int64_t offset = valid_bits_offset + values_read;
       for (int i = 0; i < literal_batch; ++i) {
-        values[values_read + i] = dictionary[indices[i]];
+        bool is_equal = literal_buffer[i] == value;
+        BitUtil::SetOrClearArrayBit(valid_bits, offset + i, is_equal);
+        *num_equal += is_equal;
       }
       literal_count_ -= literal_batch;
       values_read += literal_batch;
@@ -337,6 +529,78 @@ inline int RleDecoder::GetBatchWithDict(
   return values_read;
 }
 
+inline int RleDecoder::GetSelection(int batch_size, const uint8_t* mask,
+    int64_t mask_size, int32_t first_position, int32_t* selection,
+    int64_t* num_selected) {
+  DCHECK_GE(bit_width_, 0);
+  const int buffer_size = 1024;
+  uint32_t indices[buffer_size];
+  int64_t selected = *num_selected;
+  int values_read = 0;
+
+  while (values_read < batch_size) {
+    if (repeat_count_ > 0) {
+      int repeat_batch =
+          std::min(batch_size - values_read, static_cast<int>(repeat_count_));
+      if (current_value_ < static_cast<uint64_t>(mask_size) && mask[current_value_]) {
+        int32_t position = first_position + values_read;
+        for (int i = 0; i < repeat_batch; ++i) {
+          selection[selected++] = position + i;
+        }
+      }
+      repeat_count_ -= repeat_batch;
+      values_read += repeat_batch;
+    } else if (literal_count_ > 0) {
+      int literal_batch = std::min(std::min(batch_size - values_read, buffer_size),
+          static_cast<int>(literal_count_));
+      int actual_read = bit_reader_.GetBatch(bit_width_, indices, literal_batch);
+      DCHECK_EQ(actual_read, literal_batch);
+      int32_t position = first_position + values_read;
+      for (int i = 0; i < literal_batch; ++i) {
+        // Branch-free: the position is always written but only kept if selected
+        selection[selected] = position + i;
+        selected += indices[i] < mask_size && mask[indices[i]];
+      }
+      literal_count_ -= literal_batch;
+      values_read += literal_batch;
+    } else {
+      if (!NextCounts<uint32_t>()) break;
+    }
+  }
+
+  *num_selected = selected;
+  return values_read;
+}
+
+template <typename T>
+inline int RleDecoder::GetBatchWithDict(
+    const Vector<T>& dictionary, T* values, int batch_size) {
+  DCHECK_GE(bit_width_, 0);
+  int values_read = 0;
+
+  while (values_read < batch_size) {
+    if (repeat_count_ > 0) {
+      int repeat_batch =
+          std::min(batch_size - values_read, static_cast<int>(repeat_count_));
+      FillValues(values + values_read, repeat_batch, dictionary[current_value_]);
+      repeat_count_ -= repeat_batch;
+      values_read += repeat_batch;
+    } else if (literal_count_ > 0) {
+      int literal_batch =
+          std::min(batch_size - values_read, static_cast<int>(literal_count_));
+      int actual_read = bit_reader_.GetBatchWithDict(
+          bit_width_, dictionary.data(), values + values_read, literal_batch);
+      DCHECK_EQ(actual_read, literal_batch);
+      literal_count_ -= literal_batch;
+      values_read += literal_batch;
+    } else {
+      if (!NextCounts<T>()) return values_read;
+    }
+  }
+
+  return values_read;
+}
+
 template <typename T>
 bool RleDecoder::NextCounts() {
   // Read the next run's indicator int, it could be a literal or repeated run.
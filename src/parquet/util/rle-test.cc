@@ -31,6 +31,7 @@
 
 #include "parquet/util/rle-encoding.h"
 #include "parquet/util/bit-stream-utils.inline.h"
+#include "parquet/util/bpacking-simd.h"
 
 using std::vector;
 
@@ -135,6 +136,33 @@ TEST(BitArray, TestValues) {
   }
 }
 
+TEST(BitArray, TestAdvance) {
+  const int len = 64;
+  uint8_t buffer[len];
+  for (int width = 1; width <= 8; ++width) {
+    const int num_values = len * 8 / width;
+    BitWriter writer(buffer, len);
+    for (int i = 0; i < num_values; ++i) {
+      EXPECT_TRUE(writer.PutValue(i % (1 << width), width));
+    }
+    writer.Flush();
+
+    BitReader reader(buffer, len);
+    int i = 0;
+    int skip = 1;
+    while (i + skip < num_values) {
+      EXPECT_TRUE(reader.Advance(skip * width));
+      i += skip;
+      int val = 0;
+      EXPECT_TRUE(reader.GetValue(width, &val));
+      EXPECT_EQ(i % (1 << width), val) << width << " " << i;
+      ++i;
+      skip = skip * 3 % 67;
+    }
+    EXPECT_FALSE(reader.Advance(len * 8));
+  }
+}
+
 // Test some mixed values
 TEST(BitArray, TestMixed) {
   const int len = 1024;
@@ -172,6 +200,111 @@ TEST(BitArray, TestMixed) {
   }
 }
 
+// Checks every unpacking kernel the CPU supports against the scalar one, with
+// input sized exactly so that reads past its end are caught by ASAN
+TEST(BitArray, UnpackKernels) {
+  std::default_random_engine gen(42);
+  std::uniform_int_distribution<uint32_t> dist;
+  for (int num_bits = 0; num_bits <= MAX_WIDTH; ++num_bits) {
+    for (int num_values : {0, 31, 32, 64, 96, 1000, 1024}) {
+      int num_blocks = num_values / 32;
+      vector<uint32_t> in(num_blocks * num_bits);
+      for (uint32_t& word : in) {
+        word = dist(gen);
+      }
+
+      vector<uint32_t> expected32(num_values);
+      vector<uint64_t> expected64(num_values);
+      ASSERT_EQ(num_blocks * 32, UnpackBits32(UnpackKernel::SCALAR, in.data(),
+                                     expected32.data(), num_values, num_bits));
+      ASSERT_EQ(num_blocks * 32, UnpackBits64(UnpackKernel::SCALAR, in.data(),
+                                     expected64.data(), num_values, num_bits));
+      for (int i = 0; i < num_values; ++i) {
+        ASSERT_EQ(expected32[i], expected64[i]);
+      }
+
+      for (int kernel = UnpackKernel::SCALAR; kernel <= BestUnpackKernel(); ++kernel) {
+        UnpackKernel::type type = static_cast<UnpackKernel::type>(kernel);
+        vector<uint32_t> out32(num_values);
+        vector<uint64_t> out64(num_values);
+        ASSERT_EQ(num_blocks * 32,
+            UnpackBits32(type, in.data(), out32.data(), num_values, num_bits));
+        ASSERT_EQ(num_blocks * 32,
+            UnpackBits64(type, in.data(), out64.data(), num_values, num_bits));
+        ASSERT_EQ(expected32, out32) << "kernel " << kernel << " bits " << num_bits;
+        ASSERT_EQ(expected64, out64) << "kernel " << kernel << " bits " << num_bits;
+      }
+    }
+  }
+}
+
+// Checks the dictionary lookups of every kernel against unpacked indices
+TEST(BitArray, UnpackDictKernels) {
+  const int num_values = 1000;
+  std::default_random_engine gen(42);
+  std::uniform_int_distribution<uint32_t> dist;
+  for (int num_bits = 0; num_bits <= 16; ++num_bits) {
+    int num_blocks = num_values / 32;
+    vector<uint32_t> in(num_blocks * num_bits);
+    for (uint32_t& word : in) {
+      word = dist(gen);
+    }
+    vector<uint32_t> dict32(1 << num_bits);
+    vector<uint64_t> dict64(1 << num_bits);
+    for (size_t i = 0; i < dict32.size(); ++i) {
+      dict32[i] = dist(gen);
+      dict64[i] = (static_cast<uint64_t>(dist(gen)) << 32) | dist(gen);
+    }
+
+    vector<uint32_t> indices(num_values);
+    UnpackBits32(UnpackKernel::SCALAR, in.data(), indices.data(), num_values, num_bits);
+    vector<uint32_t> expected32(num_values);
+    vector<uint64_t> expected64(num_values);
+    for (int i = 0; i < num_blocks * 32; ++i) {
+      expected32[i] = dict32[indices[i]];
+      expected64[i] = dict64[indices[i]];
+    }
+
+    for (int kernel = UnpackKernel::SCALAR; kernel <= BestUnpackKernel(); ++kernel) {
+      UnpackKernel::type type = static_cast<UnpackKernel::type>(kernel);
+      vector<uint32_t> out32(num_values);
+      vector<uint64_t> out64(num_values);
+      ASSERT_EQ(num_blocks * 32, UnpackDict32(type, in.data(), dict32.data(),
+                                     out32.data(), num_values, num_bits));
+      ASSERT_EQ(num_blocks * 32, UnpackDict64(type, in.data(), dict64.data(),
+                                     out64.data(), num_values, num_bits));
+      ASSERT_EQ(expected32, out32) << "kernel " << kernel << " bits " << num_bits;
+      ASSERT_EQ(expected64, out64) << "kernel " << kernel << " bits " << num_bits;
+    }
+  }
+}
+
+// Round trips values of every width through a BitReader into 64-bit output
+TEST(BitArray, GetBatch64) {
+  const int num_values = 1000;
+  std::default_random_engine gen(42);
+  for (int num_bits = 1; num_bits <= MAX_WIDTH; ++num_bits) {
+    std::uniform_int_distribution<uint64_t> dist(0, (1ULL << num_bits) - 1);
+    vector<uint64_t> values(num_values);
+    vector<uint8_t> buffer(num_values * num_bits / 8 + 8);
+    BitWriter writer(buffer.data(), buffer.size());
+    // Start unaligned to cover the values read before the unpacked batch
+    ASSERT_TRUE(writer.PutValue(1, 3));
+    for (uint64_t& value : values) {
+      value = dist(gen);
+      ASSERT_TRUE(writer.PutValue(value, num_bits));
+    }
+    writer.Flush();
+
+    BitReader reader(buffer.data(), writer.bytes_written());
+    uint64_t first;
+    ASSERT_TRUE(reader.GetValue(3, &first));
+    vector<uint64_t> read(num_values);
+    ASSERT_EQ(num_values, reader.GetBatch(num_bits, read.data(), num_values));
+    ASSERT_EQ(values, read) << "bits " << num_bits;
+  }
+}
+
 // Validates encoding of values by encoding and decoding them.  If
 // expected_encoding != NULL, also validates that the encoded buffer is
 // exactly 'expected_encoding'.
@@ -419,6 +552,176 @@ TEST(BitRle, RepeatedPattern) {
   ValidateRle(values, 1, NULL, -1);
 }
 
+TEST(Rle, Skip) {
+  // Long repeated runs of 2 and literal runs of alternating values
+  const int bit_width = 3;
+  vector<int16_t> values;
+  for (int run = 0; run < 10; ++run) {
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(run % 2 == 0 ? 2 : i % 7);
+    }
+  }
+  const int len = 1024;
+  uint8_t buffer[len];
+  RleEncoder encoder(buffer, len, bit_width);
+  for (int16_t value : values) {
+    EXPECT_TRUE(encoder.Put(value));
+  }
+  int encoded_len = encoder.Flush();
+
+  for (bool count : {false, true}) {
+    RleDecoder decoder(buffer, encoded_len, bit_width);
+    int pos = 0;
+    int skip = 5;
+    while (pos < static_cast<int>(values.size())) {
+      // Literal runs are padded to a multiple of 8 values, so stay within the input
+      int to_skip = std::min(skip, static_cast<int>(values.size()) - pos);
+      int64_t num_equal = 0;
+      int num_skipped = count ? decoder.SkipAndCount(to_skip, static_cast<int16_t>(2),
+                                    &num_equal)
+                              : decoder.Skip(to_skip);
+      ASSERT_EQ(to_skip, num_skipped);
+      if (count) {
+        ASSERT_EQ(CountEqual(&values[pos], num_skipped, static_cast<int16_t>(2)),
+            num_equal);
+      }
+      pos += num_skipped;
+      int16_t value;
+      if (pos < static_cast<int>(values.size())) {
+        ASSERT_TRUE(decoder.Get(&value));
+        ASSERT_EQ(values[pos], value) << pos;
+        ++pos;
+      }
+      skip = skip * 7 % 251;
+    }
+  }
+}
+
+TEST(Rle, GetSelection) {
+  // Repeated runs of 2 and literal runs of 0..7, the 7's lying outside the mask
+  const int bit_width = 3;
+  vector<int> values;
+  for (int run = 0; run < 10; ++run) {
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(run % 2 == 0 ? 2 : i % 8);
+    }
+  }
+  const int len = 1024;
+  uint8_t buffer[len];
+  RleEncoder encoder(buffer, len, bit_width);
+  for (int value : values) {
+    EXPECT_TRUE(encoder.Put(value));
+  }
+  int encoded_len = encoder.Flush();
+
+  const uint8_t mask[] = {0, 1, 1, 0, 1, 0, 1};
+  for (int batch_size : {1, 13, 100, 1000}) {
+    RleDecoder decoder(buffer, encoded_len, bit_width);
+    vector<int32_t> selection(values.size());
+    int64_t num_selected = 0;
+    int pos = 0;
+    while (pos < static_cast<int>(values.size())) {
+      int to_read = std::min(batch_size, static_cast<int>(values.size()) - pos);
+      ASSERT_EQ(to_read, decoder.GetSelection(to_read, mask, 7, pos, selection.data(),
+                             &num_selected));
+      pos += to_read;
+    }
+    vector<int32_t> expected;
+    for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+      if (values[i] < 7 && mask[values[i]]) { expected.push_back(i); }
+    }
+    selection.resize(num_selected);
+    ASSERT_EQ(expected, selection) << batch_size;
+  }
+}
+
+TEST(Rle, CountEqual) {
+  // Long enough to need more than one block of vectorized counts
+  vector<int16_t> values;
+  for (int i = 0; i < 100003; ++i) {
+    values.push_back(i % 3 == 0 ? 2 : i % 5);
+  }
+  for (int n : {0, 7, 8, 9, 1000, 100003}) {
+    int64_t expected = 0;
+    for (int i = 0; i < n; ++i) {
+      expected += values[i] == 2;
+    }
+    EXPECT_EQ(expected, CountEqual(values.data(), n, static_cast<int16_t>(2))) << n;
+  }
+}
+
+// Fills all but the last of n + 1 values
+template <typename T>
+void CheckFillValues(int n, T value) {
+  vector<T> values(n + 1, 0);
+  FillValues(values.data(), n, value);
+  vector<T> expected(n, value);
+  expected.push_back(0);
+  ASSERT_EQ(expected, values) << n;
+}
+
+TEST(Rle, FillValues) {
+  for (int n : {0, 1, 7, 8, 9, 100}) {
+    CheckFillValues<int32_t>(n, -5);
+    CheckFillValues<int64_t>(n, 1LL << 40);
+    CheckFillValues<double>(n, 1.5);
+    CheckFillValues<int16_t>(n, 3);
+  }
+}
+
+// Decodes runs of dictionary indices in batches which start and end inside
+// literal and repeated runs
+template <typename T>
+void CheckGetBatchWithDict(int bit_width) {
+  const int num_values = 5000;
+  std::default_random_engine gen(bit_width);
+  std::uniform_int_distribution<int> index_dist(0, (1 << bit_width) - 1);
+  std::uniform_int_distribution<int> run_dist(1, 40);
+
+  Vector<T> dictionary(1 << bit_width, default_allocator());
+  for (int i = 0; i < (1 << bit_width); ++i) {
+    dictionary[i] = static_cast<T>(i * 3 + 1);
+  }
+  vector<int> indices;
+  while (static_cast<int>(indices.size()) < num_values) {
+    int index = index_dist(gen);
+    int run = index % 2 == 0 ? run_dist(gen) : 1;
+    for (int k = 0; k < run && static_cast<int>(indices.size()) < num_values; ++k) {
+      indices.push_back(index);
+    }
+  }
+
+  vector<uint8_t> buffer(RleEncoder::MaxBufferSize(bit_width, num_values));
+  RleEncoder encoder(buffer.data(), buffer.size(), bit_width);
+  for (int index : indices) {
+    ASSERT_TRUE(encoder.Put(index));
+  }
+  int encoded_len = encoder.Flush();
+
+  RleDecoder decoder(buffer.data(), encoded_len, bit_width);
+  vector<T> values(num_values);
+  int values_read = 0;
+  const int batch_sizes[] = {1, 7, 31, 33, 100, 1023, 1500};
+  for (int batch = 0; values_read < num_values; ++batch) {
+    int batch_size = std::min(batch_sizes[batch % 7], num_values - values_read);
+    ASSERT_EQ(batch_size,
+        decoder.GetBatchWithDict(dictionary, values.data() + values_read, batch_size));
+    values_read += batch_size;
+  }
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ(dictionary[indices[i]], values[i]) << "bit width " << bit_width;
+  }
+}
+
+TEST(Rle, GetBatchWithDict) {
+  for (int bit_width = 1; bit_width <= 16; bit_width += 3) {
+    CheckGetBatchWithDict<int32_t>(bit_width);
+    CheckGetBatchWithDict<int64_t>(bit_width);
+    CheckGetBatchWithDict<float>(bit_width);
+    CheckGetBatchWithDict<double>(bit_width);
+  }
+}
+
 TEST(BitRle, Overflow) {
   for (int bit_width = 1; bit_width < 32; bit_width += 3) {
     const int len = RleEncoder::MinBufferSize(bit_width);
@@ -15,16 +15,17 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include <ctime>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <list>
+#include <mutex>
 
 #include "parquet/api/reader.h"
 
 int main(int argc, char** argv) {
-  if (argc > 4 || argc < 1) {
-    std::cerr << "Usage: parquet-scan [--batch-size=] [--columns=...] <file>"
+  if (argc > 5 || argc < 1) {
+    std::cerr << "Usage: parquet-scan [--batch-size=] [--columns=...] [--threads=] <file>"
               << std::endl;
     return -1;
   }
@@ -35,6 +36,8 @@ int main(int argc, char** argv) {
   int batch_size = 256;
   const std::string COLUMNS_PREFIX = "--columns=";
   const std::string BATCH_SIZE_PREFIX = "--batch-size=";
+  const std::string THREADS_PREFIX = "--threads=";
+  int num_threads = 1;
   std::vector<int> columns;
   int num_columns = 0;
 
@@ -50,18 +53,21 @@ int main(int argc, char** argv) {
     } else if ((param = std::strstr(argv[i], BATCH_SIZE_PREFIX.c_str()))) {
       value = std::strtok(param + BATCH_SIZE_PREFIX.length(), " ");
       if (value) { batch_size = std::atoi(value); }
+    } else if ((param = std::strstr(argv[i], THREADS_PREFIX.c_str()))) {
+      value = std::strtok(param + THREADS_PREFIX.length(), " ");
+      if (value) { num_threads = std::atoi(value); }
     } else {
       filename = argv[i];
     }
   }
 
-  std::vector<int16_t> rep_levels(batch_size);
-  std::vector<int16_t> def_levels(batch_size);
   try {
-    double total_time;
-    std::clock_t start_time = std::clock();
+    auto start_time = std::chrono::steady_clock::now();
+    // Only the column chunk metadata of the scanned columns is decoded
+    parquet::ReaderProperties props;
+    props.enable_lazy_metadata();
     std::unique_ptr<parquet::ParquetFileReader> reader =
-        parquet::ParquetFileReader::OpenFile(filename);
+        parquet::ParquetFileReader::OpenFile(filename, true, props);
     // columns are not specified explicitly. Add all columns
     if (num_columns == 0) {
       num_columns = reader->metadata()->num_columns();
@@ -70,34 +76,73 @@ int main(int argc, char** argv) {
         columns[i] = i;
       }
     }
+    std::vector<bool> selected(reader->metadata()->num_columns(), false);
+    for (int column : columns) {
+      if (column < 0 || column >= reader->metadata()->num_columns()) {
+        throw parquet::ParquetException("Selected column is out of range");
+      }
+      if (selected[column]) {
+        throw parquet::ParquetException("Column selected more than once");
+      }
+      selected[column] = true;
+    }
+
+    std::vector<int64_t> total_rows(num_columns, 0);
+    int64_t total_bytes = 0;
+    std::mutex totals_mutex;
 
-    int64_t total_rows[num_columns];
+    // Drains one column chunk. Each call owns its buffers so that column chunks
+    // can be scanned concurrently
+    auto scan_column = [&](int row_group, int col, parquet::ColumnReader* col_reader) {
+      std::vector<int16_t> rep_levels(batch_size);
+      std::vector<int16_t> def_levels(batch_size);
+      size_t value_byte_size = GetTypeByteSize(col_reader->descr()->physical_type());
+      std::vector<uint8_t> values(batch_size * value_byte_size);
 
-    for (int r = 0; r < reader->metadata()->num_row_groups(); ++r) {
-      auto group_reader = reader->RowGroup(r);
-      int col = 0;
-      for (auto i : columns) {
-        total_rows[col] = 0;
-        std::shared_ptr<parquet::ColumnReader> col_reader = group_reader->Column(i);
-        size_t value_byte_size = GetTypeByteSize(col_reader->descr()->physical_type());
-        std::vector<uint8_t> values(batch_size * value_byte_size);
+      int64_t rows = 0;
+      int64_t values_read = 0;
+      while (col_reader->HasNext()) {
+        rows += ScanAllValues(batch_size, def_levels.data(), rep_levels.data(),
+            values.data(), &values_read, col_reader);
+      }
+
+      int64_t bytes = reader->metadata()
+                          ->RowGroup(row_group)
+                          ->ColumnChunk(columns[col])
+                          ->total_uncompressed_size();
+      std::lock_guard<std::mutex> lock(totals_mutex);
+      total_rows[col] += rows;
+      total_bytes += bytes;
+    };
 
-        int64_t values_read = 0;
-        while (col_reader->HasNext()) {
-          total_rows[col] += ScanAllValues(batch_size, def_levels.data(),
-              rep_levels.data(), values.data(), &values_read, col_reader.get());
+    if (num_threads <= 1) {
+      for (int r = 0; r < reader->metadata()->num_row_groups(); ++r) {
+        auto group_reader = reader->RowGroup(r);
+        group_reader->Prefetch(columns);
+        for (int col = 0; col < num_columns; ++col) {
+          scan_column(r, col, group_reader->Column(columns[col]).get());
         }
-        col++;
       }
+    } else {
+      std::vector<int> column_positions(reader->metadata()->num_columns());
+      for (int col = 0; col < num_columns; ++col) {
+        column_positions[columns[col]] = col;
+      }
+      reader->ParallelScan(columns, num_threads,
+          [&](int row_group, int column, parquet::ColumnReader* col_reader) {
+            scan_column(row_group, column_positions[column], col_reader);
+          });
     }
 
-    total_time = (std::clock() - start_time) / static_cast<double>(CLOCKS_PER_SEC);
+    double total_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time).count();
     for (int ct = 1; ct < num_columns; ++ct) {
       if (total_rows[0] != total_rows[ct]) {
         std::cerr << "Parquet error: Total rows among columns do not match" << std::endl;
       }
     }
-    std::cout << total_rows[0] << " rows scanned in " << total_time << " seconds."
+    std::cout << total_rows[0] << " rows scanned in " << total_time << " seconds ("
+              << total_bytes / total_time / (1024.0 * 1024.0 * 1024.0) << " GB/s)."
               << std::endl;
   } catch (const std::exception& e) {
     std::cerr << "Parquet error: " << e.what() << std::endl;